@@ -0,0 +1,179 @@
+import asyncio
+from typing import Callable
+from typing import Final
+from typing import Optional
+from typing import Sequence
+
+from bytelang.core.aio import AsyncProtocol
+from bytelang.impl.stream.aioserial import AsyncSerialStream
+from robot import Robot
+
+
+class AsyncRobot(Robot, AsyncProtocol):
+    """
+    Robot на asyncio (POSIX): приём по готовности порта без потока опроса, ответы - через await,
+    переподключение фоном с растущей паузой. Обработчики телеметрии те же, что у Robot.
+    Блокирующие ожидания Robot (wait_motion, wait_path, ...) в цикле событий не использовать
+    """
+
+    # Индексы приёмников Robot (коды ответов прошивки)
+    RX_MILLIS: Final = 0x00
+    RX_DISTANCES: Final = 0x02
+    RX_MANIPULATOR_PROGRESS: Final = 0x04
+    RX_POSE: Final = 0x05
+    RX_MOTION_EVENT: Final = 0x06
+    RX_PATH_PROGRESS: Final = 0x07
+    RX_IDENTITY: Final = 0x0D
+    RX_BOOT_TIMELINE: Final = 0x0E
+    RX_BEHAVIOUR_STATUS: Final = 0x0F
+    RX_POWER_STATS: Final = 0x10
+
+    def __init__(
+            self,
+            ports: Optional[str | Callable[[], Sequence[str]]] = None,
+            telemetry_path: Optional[str] = None,
+            backoff: tuple[float, float] = (0.1, 5.0),
+    ) -> None:
+        """
+        :param ports: Порт или функция поиска портов (по умолчанию - Robot.search_ports)
+        :param backoff: Начальная и наибольшая паузы переподключения, с
+        """
+        stream = AsyncSerialStream(ports or self.search_ports, 115200, backoff=backoff)
+        super().__init__(telemetry_path=telemetry_path, stream=stream)
+
+        self._sync_task: Optional[asyncio.Task] = None
+
+    async def start(self, timeout: Optional[float] = None) -> None:
+        """Подключиться и запустить фоновую синхронизацию часов"""
+        await AsyncProtocol.start(self, timeout)
+        self._sync_task = asyncio.get_running_loop().create_task(self._sync_clock_loop())
+
+    async def close(self) -> None:
+        if self._sync_task:
+            self._sync_task.cancel()
+
+        await AsyncProtocol.close(self)
+
+        if self.telemetry:
+            self.telemetry.close()
+
+    async def _sync_clock_loop(self) -> None:
+        while True:
+            try:
+                self.sync_clock()
+
+            except ConnectionError:
+                await self.stream.wait_connected()
+                continue
+
+            await asyncio.sleep(self.SYNC_PERIOD_S)
+
+    async def millis(self, timeout: float = 1.0) -> int:
+        """Бортовое время, мс"""
+        return await self.request(self.send_millis_request, None, self.RX_MILLIS, timeout)
+
+    async def identity(self, timeout: float = 1.0) -> int:
+        """Идентификатор платы"""
+        return await self.request(self.send_identity_request, None, self.RX_IDENTITY, timeout)
+
+    async def get_boot_timeline_async(self, timeout: float = 1.0) -> list[dict]:
+        """Хронология загрузки (см. Robot.get_boot_timeline)"""
+        await self.request(self.send_boot_timeline_request, None, self.RX_BOOT_TIMELINE, timeout)
+        return list(self.boot_timeline)
+
+    async def get_behaviour_status(self, timeout: float = 1.0) -> dict:
+        """Состояние поведения (см. Robot.behaviour_status)"""
+        await self.request(self.send_behaviour_status_request, None, self.RX_BEHAVIOUR_STATUS, timeout)
+        return dict(self.behaviour_status)
+
+    async def get_power_stats_async(self, timeout: float = 1.0) -> dict:
+        """Отчёт питания за окно с прошлого запроса (см. Robot.get_power_stats)"""
+        await self.request(self.send_power_stats_request, None, self.RX_POWER_STATS, timeout)
+        return dict(self.power_stats)
+
+    async def get_pose(self, timeout: float = 1.0) -> tuple[float, float, float]:
+        """Поза бортовой одометрии (x мм, y мм, курс рад)"""
+        await self.request(self.send_pose_request, None, self.RX_POSE, timeout)
+        return self.pose
+
+    async def get_distances(self, timeout: float = 1.0) -> tuple[int, int]:
+        """Расстояния с датчиков (левый, правый), мм"""
+        left, right, _ = await self.request(self.send_distances_request, None, self.RX_DISTANCES, timeout)
+        return left, right
+
+    async def drive_async(self, distance_mm: int, max_speed: int = 300, acceleration: int = 600,
+                          replace: bool = False, timeout: Optional[float] = None) -> int:
+        """
+        Проехать расстояние и дождаться итога
+        :return: MOTION_COMPLETED / TIMEOUT / CANCELLED / REJECTED
+        """
+        return await self._motion_async(self.drive, distance_mm, max_speed, acceleration, replace, timeout)
+
+    async def turn_async(self, angle_deg: int, max_speed: int = 180, acceleration: int = 360,
+                         replace: bool = False, timeout: Optional[float] = None) -> int:
+        """Повернуть на месте и дождаться итога"""
+        return await self._motion_async(self.turn, angle_deg, max_speed, acceleration, replace, timeout)
+
+    async def _motion_async(self, command, amount: int, max_speed: int, acceleration: int,
+                            replace: bool, timeout: Optional[float]) -> int:
+        motion_id = self._motion_next_id
+        future = self.receive(self.RX_MOTION_EVENT, lambda v: v[0] == motion_id and v[1] != self.MOTION_STARTED)
+
+        try:
+            command(amount, max_speed, acceleration, replace)
+            await self.stream.drain()
+            _, kind, _, _ = await asyncio.wait_for(future, timeout)
+
+            # Итог уже учтён обработчиком Robot: убрать его, чтобы не копился
+            with self._motion_condition:
+                self._motion_results.pop(motion_id, None)
+
+            return kind
+
+        finally:
+            future.cancel()
+
+    async def follow_path_async(self, points: Sequence[tuple[int, int]], timeout: Optional[float] = None) -> int:
+        """
+        Пройти путь и дождаться итога
+        :return: PATH_COMPLETED или PATH_CANCELLED
+        """
+        future = self.receive(self.RX_PATH_PROGRESS, lambda v: v[3] in (self.PATH_COMPLETED, self.PATH_CANCELLED))
+
+        try:
+            self.follow_path(points)
+            await self.stream.drain()
+            return (await asyncio.wait_for(future, timeout))[3]
+
+        finally:
+            future.cancel()
+
+    async def run_behaviour_async(self, program: "bytes | str", timeout: Optional[float] = None) -> dict:
+        """
+        Загрузить и запустить поведение, дождаться завершения (halt, отказ, отмена)
+        :return: Итоговое состояние (см. Robot.behaviour_status)
+        """
+        # Состояния halted, faulted, cancelled (BehaviourVm::State)
+        future = self.receive(self.RX_BEHAVIOUR_STATUS, lambda v: v[0] >= 3)
+
+        try:
+            self.upload_behaviour(program)
+            await self.stream.drain()
+            await asyncio.wait_for(future, timeout)
+            return dict(self.behaviour_status)
+
+        finally:
+            future.cancel()
+
+    async def move_manipulator_async(self, arm: float, claw: float, max_velocity: int = 90,
+                                     acceleration: int = 180, timeout: Optional[float] = None) -> None:
+        """Добавить точку траектории манипулятора и дождаться опустошения очереди"""
+        future = self.receive(self.RX_MANIPULATOR_PROGRESS, lambda v: v[2] == 0)
+
+        try:
+            self.move_manipulator(arm, claw, max_velocity, acceleration)
+            await self.stream.drain()
+            await asyncio.wait_for(future, timeout)
+
+        finally:
+            future.cancel()
@@ -0,0 +1,199 @@
+"""
+Ассемблер поведений для бортовой машины (zms/tools/BehaviourVm.hpp).
+
+Программа - текст, по инструкции на строке; ";" - комментарий, "name:" - метка.
+Регистры r0 .. r7 (i32), непосредственные значения - i16, переходы - на метки.
+
+    loop:
+        sense r0, left_distance
+        li r1, 150
+        jlt r0, r1, near      ; ближе 150 мм - к захвату
+        li r2, 400
+        drive r2, r2
+        yield
+        jmp loop
+    near:
+        stop
+        li r3, 20
+        claw r3
+        halt
+
+Запуск: python behaviour.py prog.zbs -o prog.zbc (проверка в симуляторе - окружение прошивки vm),
+загрузка на робота - Robot.upload_behaviour.
+"""
+
+import struct
+import sys
+from typing import Final
+from typing import Sequence
+
+REGISTER_COUNT: Final = 8
+PROGRAM_CAPACITY: Final = 512
+"""Ограничения машины (BehaviourVm::register_count, BehaviourVm::program_capacity)"""
+
+SOURCES: Final = (
+    "left_distance", "right_distance", "left_encoder", "right_encoder", "pose_x", "pose_y", "heading",
+)
+"""Датчики sense (порядок BehaviourVm::Source)"""
+
+STATES: Final = ("empty", "ready", "running", "halted", "faulted", "cancelled")
+"""Состояния машины (порядок BehaviourVm::State)"""
+
+FAULTS: Final = ("none", "empty", "overflow", "truncated", "bad_opcode", "bad_register", "bad_operand", "bad_jump")
+"""Ошибки программы (порядок BehaviourVm::Fault)"""
+
+# Операнды: r - регистр (u8), i - i16, n - сдвиг (u8 < 32), s - датчик (u8), a - метка (u16)
+OPCODES: Final = {
+    "halt": (0x00, ""),
+    "li": (0x01, "ri"),
+    "mov": (0x02, "rr"),
+    "add": (0x03, "rr"),
+    "sub": (0x04, "rr"),
+    "addi": (0x05, "ri"),
+    "mul": (0x06, "rr"),
+    "shr": (0x07, "rn"),
+    "jmp": (0x10, "a"),
+    "jlt": (0x11, "rra"),
+    "jge": (0x12, "rra"),
+    "jeq": (0x13, "rra"),
+    "jne": (0x14, "rra"),
+    "sense": (0x20, "rs"),
+    "clock": (0x21, "r"),
+    "drive": (0x30, "rr"),
+    "stop": (0x31, ""),
+    "arm": (0x32, "r"),
+    "claw": (0x33, "r"),
+    "wait": (0x40, "r"),
+    "yield": (0x41, ""),
+    "report": (0x42, "r"),
+}
+
+_SIZES: Final = {"r": 1, "i": 2, "n": 1, "s": 1, "a": 2}
+
+
+class AssemblerError(ValueError):
+
+    def __init__(self, line: int, message: str) -> None:
+        super().__init__(f"line {line}: {message}")
+        self.line = line
+
+
+def _parse_int(text: str, line: int) -> int:
+    try:
+        return int(text, 0)
+    except ValueError:
+        raise AssemblerError(line, f"bad number: {text}") from None
+
+
+def _encode_operand(kind: str, text: str, labels: dict[str, int], line: int) -> bytes:
+    if kind == "r":
+        if not (text.startswith("r") and text[1:].isdigit() and int(text[1:]) < REGISTER_COUNT):
+            raise AssemblerError(line, f"bad register: {text}")
+        return bytes((int(text[1:]),))
+
+    if kind == "i":
+        value = _parse_int(text, line)
+        if not -0x8000 <= value <= 0x7FFF:
+            raise AssemblerError(line, f"immediate out of i16: {value}")
+        return struct.pack("<h", value)
+
+    if kind == "n":
+        value = _parse_int(text, line)
+        if not 0 <= value < 32:
+            raise AssemblerError(line, f"bad shift: {value}")
+        return bytes((value,))
+
+    if kind == "s":
+        if text not in SOURCES:
+            raise AssemblerError(line, f"unknown source: {text} (one of {', '.join(SOURCES)})")
+        return bytes((SOURCES.index(text),))
+
+    if text not in labels:
+        raise AssemblerError(line, f"unknown label: {text}")
+    return struct.pack("<H", labels[text])
+
+
+def assemble(source: str) -> bytes:
+    """
+    Собрать программу
+    :param source: Текст программы
+    :return: Байткод для Robot.upload_behaviour
+    :raises AssemblerError: Ошибка в тексте (с номером строки)
+    """
+    statements: list[tuple[int, str, list[str]]] = []
+    labels: dict[str, int] = {}
+    address = 0
+
+    # Первый проход: адреса меток
+    for number, raw in enumerate(source.splitlines(), start=1):
+        text = raw.split(";", 1)[0].strip()
+
+        while ":" in text:
+            label, text = (part.strip() for part in text.split(":", 1))
+            if not label.isidentifier():
+                raise AssemblerError(number, f"bad label: {label}")
+            if label in labels:
+                raise AssemblerError(number, f"duplicate label: {label}")
+            labels[label] = address
+
+        if not text:
+            continue
+
+        mnemonic, _, rest = text.partition(" ")
+        mnemonic = mnemonic.lower()
+        operands = [o.strip() for o in rest.split(",")] if rest.strip() else []
+
+        if mnemonic not in OPCODES:
+            raise AssemblerError(number, f"unknown instruction: {mnemonic}")
+
+        _, kinds = OPCODES[mnemonic]
+        if len(operands) != len(kinds):
+            raise AssemblerError(number, f"{mnemonic} takes {len(kinds)} operand(s), got {len(operands)}")
+
+        statements.append((number, mnemonic, operands))
+        address += 1 + sum(_SIZES[k] for k in kinds)
+
+    # Второй проход: кодирование
+    code = bytearray()
+
+    for number, mnemonic, operands in statements:
+        opcode, kinds = OPCODES[mnemonic]
+        code.append(opcode)
+
+        for kind, operand in zip(kinds, operands):
+            code += _encode_operand(kind, operand, labels, number)
+
+    if not code:
+        raise AssemblerError(0, "empty program")
+
+    if len(code) > PROGRAM_CAPACITY:
+        raise AssemblerError(0, f"program is {len(code)} bytes, capacity {PROGRAM_CAPACITY}")
+
+    return bytes(code)
+
+
+def main(argv: Sequence[str]) -> int:
+    if len(argv) not in (2, 4) or (len(argv) == 4 and argv[2] != "-o"):
+        print(f"usage: {argv[0]} PROGRAM.zbs [-o PROGRAM.zbc]", file=sys.stderr)
+        return 2
+
+    with open(argv[1], encoding="utf-8") as f:
+        source = f.read()
+
+    try:
+        code = assemble(source)
+    except AssemblerError as e:
+        print(f"{argv[1]}: {e}", file=sys.stderr)
+        return 1
+
+    output = argv[3] if len(argv) == 4 else argv[1].rsplit(".", 1)[0] + ".zbc"
+
+    with open(output, "wb") as f:
+        f.write(code)
+
+    print(f"{output}: {len(code)} bytes")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
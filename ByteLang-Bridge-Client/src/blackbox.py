@@ -0,0 +1,108 @@
+import csv
+from typing import Final
+from typing import Optional
+from typing import Sequence
+
+from clock_sync import ClockSync
+
+FIELDS: Final = (
+    "timestamp_us",
+    "left_ticks",
+    "right_ticks",
+    "left_distance_mm",
+    "right_distance_mm",
+    "left_pwm",
+    "right_pwm",
+    "left_command",
+    "right_command",
+    "arm",
+    "claw",
+)
+"""Поля отсчёта бортового самописца (в порядке передачи)"""
+
+SAMPLE_SIZE: Final = 26
+"""Размер отсчёта на роботе, байт"""
+
+REASONS: Final = {
+    0x00: "none",
+    0x01: "command",
+    0x02: "fault",
+    0x03: "reflex",
+}
+
+
+class BlackboxDump:
+    """Выгрузка бортового самописца, собираемая из фрагментов"""
+
+    def __init__(
+            self,
+            sample_size: int,
+            count: int,
+            trigger_index: int,
+            reason: int,
+            frequency_hz: int,
+            dump_timestamp_us: int,
+            clock: Optional[ClockSync] = None
+    ) -> None:
+        if sample_size != SAMPLE_SIZE:
+            raise ValueError(f"Несовместимый формат отсчёта: {sample_size} байт (ожидалось {SAMPLE_SIZE})")
+
+        self.count: Final = count
+        self.trigger_index: Final = trigger_index
+        self.reason: Final = REASONS.get(reason, str(reason))
+        self.frequency_hz: Final = frequency_hz
+        self._dump_timestamp_us: Final = dump_timestamp_us
+        self._clock: Final = clock
+        self._samples: Final[list[Optional[tuple]]] = [None] * count
+
+    def add_chunk(self, offset: int, samples: Sequence[tuple]) -> None:
+        """Принять фрагмент отсчётов"""
+        for i, sample in enumerate(samples):
+            if offset + i < self.count:
+                self._samples[offset + i] = tuple(sample)
+
+    def complete(self) -> bool:
+        """Все отсчёты приняты"""
+        return all(s is not None for s in self._samples)
+
+    def robot_time_us(self, timestamp_us: int) -> int:
+        """Полное бортовое время отсчёта (отсчёт хранит младшие 32 бита, все отсчёты раньше выгрузки)"""
+        return self._dump_timestamp_us - ((self._dump_timestamp_us - timestamp_us) % 2 ** 32)
+
+    def rows(self) -> list[dict]:
+        """Отсчёты со временем относительно триггера (мкс) и в часах хоста (с), если часы синхронизированы"""
+        samples = [s for s in self._samples if s is not None]
+
+        if not samples:
+            return []
+
+        trigger_time = self.robot_time_us(samples[min(self.trigger_index, len(samples) - 1)][0])
+
+        rows = []
+        for s in samples:
+            robot_us = self.robot_time_us(s[0])
+            host_s = self._clock.to_host_s(robot_us) if self._clock is not None and self._clock.synchronized else None
+            rows.append({"t_us": robot_us - trigger_time, "host_time_s": host_s, **dict(zip(FIELDS, s))})
+
+        return rows
+
+    def to_csv(self, path: str) -> None:
+        """Сохранить в CSV"""
+        with open(path, "w", newline="") as f:
+            writer = csv.DictWriter(f, fieldnames=("t_us", "host_time_s") + FIELDS)
+            writer.writeheader()
+            writer.writerows(self.rows())
+
+    def to_parquet(self, path: str) -> None:
+        """Сохранить в Parquet (требуется pyarrow)"""
+        import pyarrow
+        import pyarrow.parquet
+
+        rows = self.rows()
+        table = pyarrow.table({name: [r[name] for r in rows] for name in ("t_us", "host_time_s") + FIELDS})
+        table = table.replace_schema_metadata({
+            "reason": self.reason,
+            "trigger_index": str(self.trigger_index),
+            "frequency_hz": str(self.frequency_hz),
+        })
+        pyarrow.parquet.write_table(table, path)
@@ -9,6 +9,10 @@ class InputStream(ABC):
     def read(self, size: int) -> bytes:
         """Считать данные из потока ввода"""
 
+    def read_available(self) -> bytes:
+        """Считать все накопленные данные (не меньше байта, если поток блокирующий)"""
+        return self.read(1)
+
 
 class OutputStream(ABC):
     """Абстрактный поток вывода (записи)"""
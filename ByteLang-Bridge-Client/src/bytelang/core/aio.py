@@ -0,0 +1,82 @@
+import asyncio
+from typing import Any
+from typing import Callable
+from typing import Optional
+
+from bytelang.core.protocol import Protocol
+from bytelang.impl.serializer.primitive import PrimitiveSerializer
+from bytelang.impl.stream.aioserial import AsyncSerialStream
+
+
+class AsyncProtocol(Protocol):
+    """
+    Протокол поверх AsyncSerialStream: входящие разбираются в цикле событий по готовности порта
+    (без потока опроса), ответы можно ожидать через await
+    """
+
+    def __init__(
+            self,
+            input_stream: AsyncSerialStream,
+            output_stream: AsyncSerialStream,
+            local_code: PrimitiveSerializer[int],
+            remote_code: PrimitiveSerializer[int]
+    ) -> None:
+        super().__init__(input_stream, output_stream, local_code, remote_code)
+        self.stream = input_stream
+        self.stream.on_data = self.poll_all
+
+    async def start(self, timeout: Optional[float] = None) -> None:
+        """Запустить подключение и дождаться порта"""
+        self.stream.start()
+        await self.stream.wait_connected(timeout)
+
+    async def close(self) -> None:
+        await self.stream.close()
+
+    def receive(self, index: int, predicate: Optional[Callable[[Any], bool]] = None) -> asyncio.Future:
+        """
+        Ожидание следующего значения приёмника
+        :param index: Индекс приёмника (порядок add_receiver)
+        :param predicate: Отбор значения (например, по идентификатору команды)
+        """
+        future = asyncio.get_running_loop().create_future()
+
+        def _on_value(value) -> bool:
+            if future.done():
+                return True
+
+            if predicate is not None and not predicate(value):
+                return False
+
+            future.set_result(value)
+            return True
+
+        self.once(index, _on_value)
+        return future
+
+    async def send(self, sender: Callable[[Any], None], value: Any = None) -> None:
+        """Отправить инструкцию и дождаться передачи драйверу порта"""
+        sender(value)
+        await self.stream.drain()
+
+    async def request(
+            self,
+            sender: Callable[[Any], None],
+            value: Any,
+            reply: int,
+            timeout: Optional[float] = 1.0,
+            predicate: Optional[Callable[[Any], bool]] = None,
+    ) -> Any:
+        """
+        Отправить запрос и дождаться ответа (ожидание ставится до отправки: быстрый ответ не теряется)
+        :param reply: Индекс приёмника ответа
+        :raises asyncio.TimeoutError: Ответ не пришёл
+        """
+        future = self.receive(reply, predicate)
+
+        try:
+            await self.send(sender, value)
+            return await asyncio.wait_for(future, timeout)
+
+        finally:
+            future.cancel()
@@ -0,0 +1,112 @@
+import struct
+from typing import Any
+from typing import Final
+from typing import Optional
+from typing import Sequence
+
+from bytelang.abc.serializer import Serializer
+from bytelang.abc.stream import InputStream
+from bytelang.impl.serializer.primitive import PrimitiveSerializer
+from bytelang.impl.serializer.struct_ import StructSerializer
+from bytelang.impl.serializer.void import VoidSerializer
+
+_NUMPY_TYPES: Final = {
+    "b": "i1", "B": "u1",
+    "h": "i2", "H": "u2",
+    "l": "i4", "L": "u4",
+    "q": "i8", "Q": "u8",
+    "f": "f4", "d": "f8",
+}
+"""Формат struct -> тип numpy"""
+
+
+class Incomplete(Exception):
+    """В буфере меньше байт, чем требует значение"""
+
+
+class BufferInputStream(InputStream):
+    """Поток чтения по срезу буфера: нехватка данных - Incomplete, а не короткое чтение"""
+
+    def __init__(self, buffer: memoryview, offset: int = 0) -> None:
+        self.buffer: Final = buffer
+        self.offset: int = offset
+
+    def read(self, size: int) -> bytes:
+        end = self.offset + size
+
+        if end > len(self.buffer):
+            raise Incomplete
+
+        data = bytes(self.buffer[self.offset:end])
+        self.offset = end
+        return data
+
+
+class Codec:
+    """
+    Скомпилированный сериализатор фиксированного размера: одна структура struct.Struct на всю сигнатуру.
+    Значение - как у исходного сериализатора: примитив - скаляр, структура - кортеж полей, void - None
+    """
+
+    def __init__(self, fields: str, scalar: bool) -> None:
+        self.struct: Final = struct.Struct(f"<{fields}")
+        self.fields: Final = fields
+        self._scalar: Final = scalar
+        self._dtype = None
+
+    @property
+    def size(self) -> int:
+        return self.struct.size
+
+    def unpack_from(self, buffer, offset: int = 0) -> Any:
+        if not self.fields:
+            return None
+
+        values = self.struct.unpack_from(buffer, offset)
+        return values[0] if self._scalar else values
+
+    def dtype(self):
+        """Структурный тип numpy (поля f0, f1, ...) для пакетного разбора"""
+        if self._dtype is None:
+            import numpy
+
+            self._dtype = numpy.dtype([(f"f{i}", f"<{_NUMPY_TYPES[c]}") for i, c in enumerate(self.fields)])
+
+        return self._dtype
+
+    def unpack_many(self, data: bytes | bytearray) -> Sequence[Sequence]:
+        """
+        Разобрать подряд идущие значения в колонки по полям
+        :return: numpy-массивы (без копирования, поверх data), без numpy - кортежи значений
+        """
+        try:
+            import numpy
+
+        except ImportError:
+            return tuple(zip(*self.struct.iter_unpack(data))) or tuple(() for _ in self.fields)
+
+        records = numpy.frombuffer(data, dtype=self.dtype())
+        return tuple(records[name] for name in records.dtype.names)
+
+    def __repr__(self) -> str:
+        return f"Codec<{self.fields or 'void'}>"
+
+
+def compile_serializer(serializer: Serializer) -> Optional[Codec]:
+    """
+    Скомпилировать сигнатуру в Codec
+    :return: None, если размер сигнатуры зависит от данных (векторы) или поля вложены
+    """
+    if isinstance(serializer, VoidSerializer):
+        return Codec("", False)
+
+    if isinstance(serializer, PrimitiveSerializer):
+        return Codec(serializer.format, True)
+
+    if isinstance(serializer, StructSerializer):
+        if not all(isinstance(field, PrimitiveSerializer) for field in serializer.fields):
+            return None
+
+        return Codec("".join(field.format for field in serializer.fields), False)
+
+    return None
@@ -2,12 +2,18 @@ from typing import Any
 from typing import Callable
 from typing import Final
 from typing import Iterable
+from typing import Optional
+from typing import Sequence
 from typing import TypeVar
 
 from bytelang.abc.serializer import Serializable
 from bytelang.abc.serializer import Serializer
 from bytelang.abc.stream import InputStream
 from bytelang.abc.stream import OutputStream
+from bytelang.core.codec import BufferInputStream
+from bytelang.core.codec import Codec
+from bytelang.core.codec import Incomplete
+from bytelang.core.codec import compile_serializer
 from bytelang.core.instruction import Instruction
 from bytelang.impl.serializer.primitive import PrimitiveSerializer
 
@@ -33,6 +39,15 @@ class Protocol:
         self._receive_handlers: Final = dict[bytes, tuple[Instruction, Callable[[Any], None]]]()
         self._send_handlers: Final = dict[bytes, Instruction]()
 
+        self._compiled: Final = dict[int | bytes, tuple[Instruction, Callable[[Any], None], Optional[Codec]]]()
+        """Таблица разбора poll_all: код (int для однобайтовых) -> (инструкция, обработчик, скомпилированная сигнатура)"""
+        self._batch_handlers: Final = dict[int | bytes, Callable[[Sequence], None]]()
+        """Пакетные обработчики: все значения инструкции за вызов poll_all колонками"""
+        self._rx: Final = bytearray()
+        """Принятые, но ещё не разобранные poll_all байты"""
+        self._once: Final = dict[int | bytes, list[Callable[[Any], bool]]]()
+        """Одноразовые слушатели значений приёмников (ожидание ответа)"""
+
     def get_senders(self) -> Iterable[Instruction]:
         """Получить все обработчики на отправку"""
         return self._send_handlers.values()
@@ -52,6 +67,45 @@ class Protocol:
         code = self._local_instruction_code.pack(index)
         instruction = Instruction(code, result, name)
         self._receive_handlers[code] = (instruction, handler)
+        self._compiled[self._key(code)] = (instruction, handler, compile_serializer(result))
+
+    def add_batch_receiver(
+            self, /,
+            result: Serializer,
+            handler: Callable[[Sequence], None],
+            name: str = None
+    ) -> None:
+        """
+        Зарегистрировать пакетный обработчик частой телеметрии (только сигнатуры фиксированного размера).
+        poll_all передаёт ему все значения за вызов колонками по полям: numpy-массивы, без numpy - кортежи.
+        poll обрабатывает сообщения по одному, передавая обработчику колонки из одного значения
+        """
+        codec = compile_serializer(result)
+
+        if codec is None or not codec.fields:
+            raise ValueError(f"{result}: пакетный приём только для сигнатур фиксированного размера")
+
+        def _single(value) -> None:
+            values = (value,) if len(codec.fields) == 1 else value
+            handler(tuple((v,) for v in values))
+
+        self.add_receiver(result, _single, name)
+        self._batch_handlers[self._key(self._local_instruction_code.pack(len(self._receive_handlers) - 1))] = handler
+
+    def once(self, index: int, callback: Callable[[Any], bool]) -> None:
+        """
+        Передавать callback значения приёмника index (после обработчика), пока он не вернёт True.
+        Значения пакетных приёмников передаются построчно
+        """
+        key = self._key(self._local_instruction_code.pack(index))
+        self._once.setdefault(key, []).append(callback)
+
+    def _notify(self, key: int | bytes, value: Any) -> None:
+        self._once[key] = [callback for callback in self._once[key] if not callback(value)]
+
+    @staticmethod
+    def _key(code: bytes) -> int | bytes:
+        return code[0] if len(code) == 1 else code
 
     def add_sender(self, /, signature: Serializer[_T], name: str = None) -> Callable[[_T], None]:
         """Зарегистрировать исходящую инструкцию"""
@@ -79,3 +133,86 @@ class Protocol:
         instruction, handler = self._receive_handlers[code]
         args_result = instruction.receive(self._input_stream)
         handler(args_result)
+
+        if self._once.get(self._key(code)):
+            self._notify(self._key(code), args_result)
+
+    def poll_all(self) -> int:
+        """
+        Обработать всё накопленное в потоке: одно чтение, разбор скомпилированными сигнатурами.
+        Значения пакетных обработчиков собираются и разбираются разом в конце
+        :return: Число обработанных сообщений
+        """
+        self._rx += self._input_stream.read_available()
+
+        code_size = self._remote_instruction_code.size
+        compiled = self._compiled
+        batch_handlers = self._batch_handlers
+        once = self._once
+        batches = dict[int | bytes, bytearray]()
+        handled = 0
+        offset = 0
+
+        with memoryview(self._rx) as buffer:
+            end = len(buffer)
+
+            while offset + code_size <= end:
+                code = buffer[offset] if code_size == 1 else bytes(buffer[offset:offset + code_size])
+                args = offset + code_size
+                entry = compiled.get(code)
+
+                if entry is None:
+                    # Как poll: неизвестный код отбрасывается
+                    offset = args
+                    continue
+
+                instruction, handler, codec = entry
+
+                if codec is None:
+                    stream = BufferInputStream(buffer, args)
+
+                    try:
+                        value = instruction.receive(stream)
+
+                    except Incomplete:
+                        break
+
+                    offset = stream.offset
+                    handler(value)
+
+                    if once.get(code):
+                        self._notify(code, value)
+
+                elif args + codec.size > end:
+                    break
+
+                elif code in batch_handlers:
+                    batch = batches.get(code)
+
+                    if batch is None:
+                        batch = batches[code] = bytearray()
+
+                    batch += buffer[args:args + codec.size]
+
+                    if once.get(code):
+                        self._notify(code, codec.unpack_from(buffer, args))
+
+                    offset = args + codec.size
+
+                else:
+                    value = codec.unpack_from(buffer, args)
+                    handler(value)
+
+                    if once.get(code):
+                        self._notify(code, value)
+
+                    offset = args + codec.size
+
+                handled += 1
+
+        del self._rx[:offset]
+
+        for code, values in batches.items():
+            batch_handlers[code](compiled[code][2].unpack_many(values))
+
+        return handled
@@ -92,6 +92,11 @@ class PrimitiveSerializer(Serializer[_T]):
         """Размер примитива в байтах"""
         return self._struct.size
 
+    @property
+    def format(self) -> str:
+        """Формат struct без порядка байт"""
+        return self._struct.format.strip("<>")
+
 
 u8 = PrimitiveSerializer[int | bool](_Format.U8)
 u16 = PrimitiveSerializer[int](_Format.U16)
@@ -0,0 +1,220 @@
+import asyncio
+import os
+import termios
+import tty
+from typing import Callable
+from typing import Final
+from typing import Optional
+from typing import Sequence
+
+from bytelang.abc.stream import InputStream
+from bytelang.abc.stream import OutputStream
+
+_BAUDS: Final = {
+    9600: termios.B9600,
+    57600: termios.B57600,
+    115200: termios.B115200,
+    230400: termios.B230400,
+}
+
+
+class AsyncSerialStream(InputStream, OutputStream):
+    """
+    Неблокирующий поток по последовательному порту для asyncio (POSIX: Linux, macOS).
+
+    Чтение - по готовности дескриптора (loop.add_reader): принятое копится в буфере, о нём сообщает
+    on_data. Запись не блокирует: остаток, не принятый драйвером, дописывается по готовности на запись.
+    При потере порта переподключение идёт фоном с растущей паузой; порты перебираются заново при каждой попытке
+    """
+
+    def __init__(
+            self,
+            ports: str | Callable[[], Sequence[str]],
+            baud: int = 115200,
+            on_data: Optional[Callable[[], None]] = None,
+            backoff: tuple[float, float] = (0.1, 5.0),
+    ) -> None:
+        """
+        :param ports: Порт или функция поиска портов-кандидатов
+        :param on_data: Вызывается в цикле событий после приёма данных
+        :param backoff: Начальная и наибольшая паузы между попытками подключения, с
+        """
+        self._ports: Final = (lambda: (ports,)) if isinstance(ports, str) else ports
+        self._baud: Final = _BAUDS[baud]
+        self.on_data: Optional[Callable[[], None]] = on_data
+        self._backoff: Final = backoff
+
+        self._fd: Optional[int] = None
+        self.port: Optional[str] = None
+
+        self._rx: Final = bytearray()
+        self._tx: Final = bytearray()
+
+        self._loop: Optional[asyncio.AbstractEventLoop] = None
+        self._task: Optional[asyncio.Task] = None
+        self._connected: Optional[asyncio.Event] = None
+        self._lost: Optional[asyncio.Event] = None
+        self._drained: Optional[asyncio.Event] = None
+
+        self.connections: int = 0
+        """Число успешных подключений"""
+
+    @property
+    def connected(self) -> bool:
+        return self._fd is not None
+
+    def start(self) -> None:
+        """Запустить фоновое подключение (в работающем цикле событий)"""
+        self._loop = asyncio.get_running_loop()
+        self._connected = asyncio.Event()
+        self._lost = asyncio.Event()
+        self._lost.set()
+        self._drained = asyncio.Event()
+        self._drained.set()
+        self._task = self._loop.create_task(self._maintain())
+
+    async def wait_connected(self, timeout: Optional[float] = None) -> None:
+        await asyncio.wait_for(self._connected.wait(), timeout)
+
+    async def drain(self) -> None:
+        """Дождаться передачи записанного драйверу порта"""
+        await self._drained.wait()
+
+    async def close(self) -> None:
+        if self._task:
+            self._task.cancel()
+
+            try:
+                await self._task
+
+            except asyncio.CancelledError:
+                pass
+
+        self._disconnect()
+
+    def read(self, size: int) -> bytes:
+        data = bytes(self._rx[:size])
+        del self._rx[:size]
+        return data
+
+    def read_available(self) -> bytes:
+        data = bytes(self._rx)
+        self._rx.clear()
+        return data
+
+    def write(self, data: bytes) -> None:
+        if self._fd is None:
+            raise ConnectionError("Порт не подключён")
+
+        if self._tx:
+            self._tx += data
+            return
+
+        try:
+            written = os.write(self._fd, data)
+
+        except BlockingIOError:
+            written = 0
+
+        except OSError:
+            self._disconnect()
+            raise ConnectionError("Порт отключён")
+
+        if written < len(data):
+            self._tx += data[written:]
+            self._drained.clear()
+            self._loop.add_writer(self._fd, self._on_writable)
+
+    def _open(self, port: str) -> int:
+        fd = os.open(port, os.O_RDWR | os.O_NOCTTY | os.O_NONBLOCK)
+
+        try:
+            tty.setraw(fd)
+            attributes = termios.tcgetattr(fd)
+            attributes[4] = attributes[5] = self._baud
+            termios.tcsetattr(fd, termios.TCSANOW, attributes)
+            termios.tcflush(fd, termios.TCIOFLUSH)
+
+        except termios.error:
+            os.close(fd)
+            raise
+
+        return fd
+
+    async def _maintain(self) -> None:
+        delay = self._backoff[0]
+
+        while True:
+            await self._lost.wait()
+
+            for port in self._ports():
+                try:
+                    self._fd = self._open(port)
+
+                except OSError:
+                    continue
+
+                self.port = port
+                self.connections += 1
+                self._lost.clear()
+                self._loop.add_reader(self._fd, self._on_readable)
+                self._connected.set()
+                delay = self._backoff[0]
+                break
+
+            else:
+                await asyncio.sleep(delay)
+                delay = min(delay * 2, self._backoff[1])
+
+    def _disconnect(self) -> None:
+        if self._fd is None:
+            return
+
+        self._loop.remove_reader(self._fd)
+        self._loop.remove_writer(self._fd)
+        os.close(self._fd)
+
+        self._fd = None
+        self._tx.clear()
+        self._drained.set()
+        self._connected.clear()
+        self._lost.set()
+
+    def _on_readable(self) -> None:
+        try:
+            data = os.read(self._fd, 4096)
+
+        except BlockingIOError:
+            return
+
+        except OSError:
+            data = b""
+
+        if not data:
+            self._disconnect()
+            return
+
+        self._rx += data
+
+        if self.on_data:
+            self.on_data()
+
+    def _on_writable(self) -> None:
+        try:
+            written = os.write(self._fd, self._tx)
+
+        except BlockingIOError:
+            return
+
+        except OSError:
+            self._disconnect()
+            return
+
+        del self._tx[:written]
+
+        if not self._tx:
+            self._loop.remove_writer(self._fd)
+            self._drained.set()
+
+    def __str__(self) -> str:
+        return f"{self.__class__.__name__}<{self.port}>"
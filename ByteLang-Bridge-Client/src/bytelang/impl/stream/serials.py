@@ -33,6 +33,18 @@ class SerialStream(InputStream, OutputStream):
             self._connected = False
             raise
 
+    def read_available(self) -> bytes:
+        if not self._connected:
+            raise serial.SerialException("Соединение закрыто")
+
+        try:
+            # Пустой буфер - ожидание первого байта с тайм-аутом порта
+            return self._serial_port.read(self._serial_port.in_waiting or 1)
+
+        except serial.SerialException:
+            self._connected = False
+            raise
+
     def write(self, data: bytes) -> None:
         if not self._connected:
             raise serial.SerialException("Соединение закрыто")
@@ -0,0 +1,176 @@
+"""
+Запись трафика моста в компактный файл захвата и его чтение.
+
+Формат (little-endian):
+    заголовок: b"ZMSCAP" | u8 версия | u8 резерв | u64 время хоста начала записи (мкс, monotonic)
+    запись:    u8 направление | varint задержка от предыдущей записи (мкс) | varint длина | байты
+
+Направление: 0 - хост -> робот, 1 - робот -> хост. varint - LEB128 без знака.
+Тот же формат читает прошивка, собранная для хоста (окружение replay).
+"""
+
+import struct
+import sys
+from dataclasses import dataclass
+from threading import Lock
+from typing import BinaryIO
+from typing import Final
+from typing import Iterator
+
+from bytelang.abc.stream import InputStream
+from bytelang.abc.stream import OutputStream
+from clock_sync import host_time_us
+
+MAGIC: Final = b"ZMSCAP"
+VERSION: Final = 1
+
+TO_ROBOT: Final = 0
+FROM_ROBOT: Final = 1
+
+_HEADER: Final = struct.Struct("<6sBBQ")
+
+
+def _write_varint(out: bytearray, value: int) -> None:
+    while True:
+        byte = value & 0x7F
+        value >>= 7
+
+        if value:
+            out.append(byte | 0x80)
+        else:
+            out.append(byte)
+            return
+
+
+def _read_varint(f: BinaryIO) -> int:
+    value = 0
+    shift = 0
+
+    while True:
+        b = f.read(1)
+        if not b:
+            raise EOFError
+
+        value |= (b[0] & 0x7F) << shift
+        shift += 7
+
+        if not b[0] & 0x80:
+            return value
+
+
+@dataclass(frozen=True)
+class Record:
+    """Запись захвата"""
+
+    direction: int
+    """TO_ROBOT или FROM_ROBOT"""
+    time_us: int
+    """Время от начала записи (мкс)"""
+    data: bytes
+
+
+class CaptureWriter:
+    """Запись захвата в файл (потокобезопасно: чтение и запись порта идут из разных потоков)"""
+
+    def __init__(self, path: str) -> None:
+        self._file: Final = open(path, "wb")
+        self._lock: Final = Lock()
+        self._start_us: Final = host_time_us()
+        self._last_us: int = self._start_us
+
+        self._file.write(_HEADER.pack(MAGIC, VERSION, 0, self._start_us))
+
+    def add(self, direction: int, data: bytes) -> None:
+        if not data:
+            return
+
+        with self._lock:
+            now = host_time_us()
+
+            record = bytearray((direction,))
+            _write_varint(record, now - self._last_us)
+            _write_varint(record, len(data))
+            record += data
+
+            self._file.write(record)
+            self._last_us = now
+
+    def flush(self) -> None:
+        with self._lock:
+            self._file.flush()
+
+    def close(self) -> None:
+        with self._lock:
+            self._file.close()
+
+
+class RecordingStream(InputStream, OutputStream):
+    """Поток-обёртка: пропускает трафик без изменений и пишет каждый байт в захват"""
+
+    def __init__(self, stream, writer: CaptureWriter) -> None:
+        self._stream: Final = stream
+        self.writer: Final = writer
+
+    def read(self, size: int) -> bytes:
+        data = self._stream.read(size)
+        self.writer.add(FROM_ROBOT, data)
+        return data
+
+    def read_available(self) -> bytes:
+        data = self._stream.read_available()
+        self.writer.add(FROM_ROBOT, data)
+        return data
+
+    def write(self, data: bytes) -> None:
+        self.writer.add(TO_ROBOT, data)
+        self._stream.write(data)
+
+    def __str__(self) -> str:
+        return f"{self.__class__.__name__}<{self._stream}>"
+
+
+def read_capture(path: str) -> Iterator[Record]:
+    """Прочитать записи захвата (обрезанный хвост - например, при аварийном завершении - игнорируется)"""
+    with open(path, "rb") as f:
+        magic, version, _, _ = _HEADER.unpack(f.read(_HEADER.size))
+
+        if magic != MAGIC or version != VERSION:
+            raise ValueError(f"{path}: не файл захвата (или версия {version} не поддерживается)")
+
+        time_us = 0
+
+        while True:
+            direction = f.read(1)
+            if not direction:
+                return
+
+            try:
+                time_us += _read_varint(f)
+                size = _read_varint(f)
+            except EOFError:
+                return
+
+            data = f.read(size)
+            if len(data) < size:
+                return
+
+            yield Record(direction[0], time_us, data)
+
+
+def _summary(path: str) -> None:
+    counts = {TO_ROBOT: [0, 0], FROM_ROBOT: [0, 0]}
+    duration_us = 0
+
+    for record in read_capture(path):
+        counts[record.direction][0] += 1
+        counts[record.direction][1] += len(record.data)
+        duration_us = record.time_us
+
+    print(f"{path}: {duration_us / 1e6:.3f} s")
+    print(f"  host -> robot: {counts[TO_ROBOT][0]} records, {counts[TO_ROBOT][1]} bytes")
+    print(f"  robot -> host: {counts[FROM_ROBOT][0]} records, {counts[FROM_ROBOT][1]} bytes")
+
+
+if __name__ == '__main__':
+    for _path in sys.argv[1:]:
+        _summary(_path)
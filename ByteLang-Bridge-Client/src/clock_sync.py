@@ -0,0 +1,93 @@
+from collections import deque
+from threading import Lock
+from time import monotonic_ns
+from typing import Final
+from typing import Optional
+
+
+def host_time_us() -> int:
+    """Часы хоста для синхронизации (монотонные, мкс)"""
+    return monotonic_ns() // 1000
+
+
+class ClockSync:
+    """
+    Оценка смещения и дрейфа бортовых часов относительно часов хоста по обменам в стиле NTP.
+
+    Каждый обмен даёт четыре метки: отправка хостом (t0), приём (t1) и отправка (t2) роботом, приём хостом (t3).
+    Смещение берётся из обменов с наименьшей задержкой в окне (на них меньше всего сказывается очередь порта),
+    дрейф - наклоном прямой МНК по этим обменам.
+    """
+
+    def __init__(self, window: int = 64, best_fraction: float = 0.25) -> None:
+        self._samples: Final = deque[tuple[int, float, int]](maxlen=window)
+        """(бортовое время, смещение робот - хост, задержка)"""
+        self._best_fraction: Final = best_fraction
+        self._lock: Final = Lock()
+
+        self._reference_us: int = 0
+        self._offset_us: float = 0.0
+        self._drift: float = 0.0
+
+        self.synchronized: bool = False
+        """Есть хотя бы один обмен"""
+        self.delay_us: Optional[int] = None
+        """Наименьшая задержка обмена в окне, мкс"""
+
+    def add(self, host_send_us: int, robot_receive_us: int, robot_send_us: int, host_receive_us: int) -> None:
+        """Учесть обмен синхронизации"""
+        delay = (host_receive_us - host_send_us) - (robot_send_us - robot_receive_us)
+        offset = ((robot_receive_us - host_send_us) + (robot_send_us - host_receive_us)) / 2
+
+        if delay < 0:
+            return
+
+        with self._lock:
+            self._samples.append((robot_receive_us, offset, delay))
+            self._estimate()
+
+    def to_host_us(self, robot_us: int) -> int:
+        """Перевести бортовое время в часы хоста (мкс)"""
+        with self._lock:
+            offset = self._offset_us + self._drift * (robot_us - self._reference_us)
+
+        return int(round(robot_us - offset))
+
+    def to_host_us_many(self, robot_us):
+        """Перевести массив бортовых меток (numpy-массив или последовательность) в часы хоста (мкс)"""
+        with self._lock:
+            offset_us, drift, reference_us = self._offset_us, self._drift, self._reference_us
+
+        if hasattr(robot_us, "dtype"):
+            t = robot_us.astype("f8")
+            return (t - (offset_us + drift * (t - reference_us))).round().astype("i8")
+
+        return [int(round(t - (offset_us + drift * (t - reference_us)))) for t in robot_us]
+
+    def to_host_s(self, robot_us: int) -> float:
+        """Перевести бортовое время в часы хоста (с, шкала time.monotonic)"""
+        return self.to_host_us(robot_us) / 1e6
+
+    @property
+    def drift_ppm(self) -> float:
+        """Дрейф бортовых часов относительно хоста, миллионных долей"""
+        return self._drift * 1e6
+
+    def _estimate(self) -> None:
+        best = sorted(self._samples, key=lambda s: s[2])
+        best = best[:max(1, int(len(best) * self._best_fraction))]
+
+        self.synchronized = True
+        self.delay_us = best[0][2]
+
+        reference = sum(s[0] for s in best) / len(best)
+        mean_offset = sum(s[1] for s in best) / len(best)
+
+        spread = sum((s[0] - reference) ** 2 for s in best)
+
+        # Дрейф оценивается, только когда лучшие обмены разнесены по времени хотя бы на секунду
+        if len(best) >= 2 and spread / len(best) >= 1e12:
+            self._drift = sum((s[0] - reference) * (s[1] - mean_offset) for s in best) / spread
+
+        self._reference_us = int(reference)
+        self._offset_us = mean_offset
@@ -0,0 +1,502 @@
+"""
+Шлюз нескольких роботов: один процесс владеет всеми портами моста и раздаёт телеметрию через общую память.
+
+Порты опрашиваются одним циклом на selectors (epoll в Linux) без блокирующих чтений. Новые порты
+подхватываются периодическим поиском; после подключения шлюз запрашивает идентификатор платы
+(get_identity) и, получив его, публикует кадры робота в кольцо общей памяти "zms_<id>".
+
+Кольцо (little-endian):
+    заголовок (64 байта): b"ZMSRING\\0" | u32 версия | u32 размер слота | u32 число слотов | u32 резерв
+                          | u64 идентификатор робота | u64 число опубликованных кадров | 24x
+    слот: u64 номер кадра + 1 (0 - пусто) | u64 время хоста приёма (мкс) | u8 код | u8 длина | 6x | данные
+
+Номер слота пишется последним: читатель сверяет его с ожидаемым и видит только дописанные кадры.
+Данные - аргументы инструкции в том виде, в каком их прислал робот: FORMATS[код] распаковывает их
+struct.unpack_from прямо из общей памяти. Кадр в памяти действителен, пока писатель не обогнёт кольцо.
+Журнал робота печатает шлюз; кадры длиннее слота (фрагменты самописца, замеры) в кольцо не попадают.
+
+Команды роботам шлюз не передаёт: порт, которым владеет шлюз, не может открыть Robot.
+"""
+
+import os
+import selectors
+import struct
+import sys
+from multiprocessing import shared_memory
+from time import monotonic
+from time import sleep
+from typing import Callable
+from typing import Final
+from typing import Iterator
+from typing import Optional
+
+from serial import Serial
+from serial import SerialException
+
+from bytelang.impl.stream.serials import SerialStream
+from clock_sync import host_time_us
+
+BAUD: Final = 115200
+
+GET_IDENTITY: Final = 0x13
+"""Код инструкции get_identity на роботе"""
+
+LOG: Final = 0x01
+IDENTITY: Final = 0x0D
+"""Коды ответов робота, которые обрабатывает сам шлюз"""
+
+FORMATS: Final = {
+    0x00: struct.Struct("<I"),  # millis
+    0x02: struct.Struct("<HHQ"),  # distances: left, right, timestamp_us
+    0x03: struct.Struct("<bbQ"),  # encoders: left, right, timestamp_us
+    0x04: struct.Struct("<BBBBQ"),  # manipulator_progress: arm, claw, queued, completed, timestamp_us
+    0x05: struct.Struct("<fffQ"),  # pose: x, y, heading, timestamp_us
+    0x06: struct.Struct("<BBBQ"),  # motion_event: id, kind, queued, timestamp_us
+    0x07: struct.Struct("<HBhBQ"),  # path_progress: passed, remaining, cross_track_error, state, timestamp_us
+    0x08: struct.Struct("<BHHQ"),  # reflex_event: level, left, right, timestamp_us
+    0x09: struct.Struct("<BHHBHQ"),  # blackbox_header: sample_size, count, trigger_index, reason, frequency, timestamp_us
+    0x0B: struct.Struct("<QQQ"),  # time_sync: host_send_us, robot_receive_us, robot_send_us
+    0x0D: struct.Struct("<Q"),  # identity: id
+    0x0F: struct.Struct("<BBHIiQ"),  # behaviour_status: state, fault, pc, executed, report, timestamp_us
+    0x10: struct.Struct("<BBHIIIIIHQ"),  # power_stats: mode, level, frequency_mhz, loop_mean_us, loop_max_us, wake_mean_us, wake_max_us, sleeps, sleep_permille, timestamp_us
+}
+"""Кадры фиксированной длины: код -> формат аргументов"""
+
+NAMES: Final = {
+    0x00: "millis", 0x01: "log", 0x02: "distances", 0x03: "encoders", 0x04: "manipulator_progress",
+    0x05: "pose", 0x06: "motion_event", 0x07: "path_progress", 0x08: "reflex_event",
+    0x09: "blackbox_header", 0x0A: "blackbox_chunk", 0x0B: "time_sync", 0x0C: "benchmark_result",
+    0x0D: "identity", 0x0E: "boot_timeline", 0x0F: "behaviour_status",
+    0x10: "power_stats", 0x11: "trace_header", 0x12: "trace_chunk",
+}
+
+_BLACKBOX_SAMPLE_SIZE: Final = 26
+_TRACE_EVENT_SIZE: Final = 8
+
+
+def _log_size(buffer: bytearray, offset: int) -> Optional[int]:
+    # u8 длина | байты
+    if offset >= len(buffer):
+        return None
+
+    return 1 + buffer[offset]
+
+
+def _blackbox_chunk_size(buffer: bytearray, offset: int) -> Optional[int]:
+    # u16 смещение | u8 число отсчётов | отсчёты
+    if offset + 3 > len(buffer):
+        return None
+
+    return 3 + buffer[offset + 2] * _BLACKBOX_SAMPLE_SIZE
+
+
+def _benchmark_result_size(buffer: bytearray, offset: int) -> Optional[int]:
+    # u8 индекс | u8 число | u8 длина имени | имя | u32 итерации | u64 такты | u16 частота
+    if offset + 3 > len(buffer):
+        return None
+
+    return 3 + buffer[offset + 2] + 14
+
+
+def _boot_timeline_size(buffer: bytearray, offset: int) -> Optional[int]:
+    # u16 маска неудавшихся этапов | u8 число этапов | этапы (u8 итог, u32 начало, u32 длительность)
+    if offset + 3 > len(buffer):
+        return None
+
+    return 3 + buffer[offset + 2] * 9
+
+
+def _trace_header_size(buffer: bytearray, offset: int) -> Optional[int]:
+    # u16 число | u32 потеряно | u16 частота | u8 число ядер | ядра (u32 такты, u64 мкс)
+    # | u8 число задач | задачи (u8 длина имени, имя)
+    if offset + 9 > len(buffer):
+        return None
+
+    size = 9 + buffer[offset + 8] * 12
+
+    if offset + size + 1 > len(buffer):
+        return None
+
+    tasks = buffer[offset + size]
+    size += 1
+
+    for _ in range(tasks):
+        if offset + size + 1 > len(buffer):
+            return None
+
+        size += 1 + buffer[offset + size]
+
+    return size
+
+
+def _trace_chunk_size(buffer: bytearray, offset: int) -> Optional[int]:
+    # u16 смещение | u8 число событий | события
+    if offset + 3 > len(buffer):
+        return None
+
+    return 3 + buffer[offset + 2] * _TRACE_EVENT_SIZE
+
+
+_VARIABLE: Final[dict[int, Callable[[bytearray, int], Optional[int]]]] = {
+    0x01: _log_size,
+    0x0A: _blackbox_chunk_size,
+    0x0C: _benchmark_result_size,
+    0x0E: _boot_timeline_size,
+    0x11: _trace_header_size,
+    0x12: _trace_chunk_size,
+}
+"""Кадры переменной длины: код -> длина аргументов по началу кадра (None - кадр ещё не пришёл)"""
+
+_SIZES: Final = tuple(FORMATS[code].size if code in FORMATS else None for code in range(256))
+
+
+def split_frames(buffer: bytearray) -> tuple[list[tuple[int, int, int]], int]:
+    """
+    Разобрать принятые байты на кадры
+    :return: Кадры (код, начало аргументов, длина аргументов) и число разобранных байт
+    """
+    result = []
+    offset = 0
+    end = len(buffer)
+
+    while offset < end:
+        code = buffer[offset]
+        size = _SIZES[code]
+
+        if size is None:
+            variable = _VARIABLE.get(code)
+
+            if variable is None:
+                # Неизвестный код - поток рассинхронизирован, ищем следующий кадр со следующего байта
+                offset += 1
+                continue
+
+            size = variable(buffer, offset + 1)
+
+            if size is None:
+                break
+
+        if offset + 1 + size > end:
+            break
+
+        result.append((code, offset + 1, size))
+        offset += 1 + size
+
+    return result, offset
+
+
+class RingWriter:
+    """Кольцо кадров одного робота в общей памяти (единственный писатель - шлюз)"""
+
+    MAGIC: Final = b"ZMSRING\0"
+    VERSION: Final = 1
+
+    HEADER: Final = struct.Struct("<8sIIIIQQ24x")
+    SLOT: Final = struct.Struct("<QQBB6x")
+
+    _SEQUENCE_OFFSET: Final = 8 + 4 * 4 + 8
+
+    def __init__(self, robot_id: int, slot_count: int = 4096, slot_size: int = 64) -> None:
+        size = self.HEADER.size + slot_count * slot_size
+
+        try:
+            self.memory: Final = shared_memory.SharedMemory(ring_name(robot_id), create=True, size=size)
+            sequence = 0
+
+        except FileExistsError:
+            # Кольцо от прошлого запуска шлюза: читатели остаются подключёнными, нумерация продолжается
+            self.memory: Final = shared_memory.SharedMemory(ring_name(robot_id))
+            _, version, old_slot_size, old_slot_count, _, _, sequence = self.HEADER.unpack_from(self.memory.buf, 0)
+
+            if (version, old_slot_size, old_slot_count) != (self.VERSION, slot_size, slot_count) or self.memory.size < size:
+                raise ValueError(f"{ring_name(robot_id)}: кольцо с другой раскладкой уже существует")
+
+        self.slot_size: Final = slot_size
+        self.slot_count: Final = slot_count
+        self.payload_size: Final = slot_size - self.SLOT.size
+        self.sequence: int = sequence
+
+        self._buf: Final = self.memory.buf
+        self.HEADER.pack_into(self._buf, 0, self.MAGIC, self.VERSION, slot_size, slot_count, 0, robot_id, sequence)
+
+    def publish(self, code: int, host_us: int, data: memoryview) -> bool:
+        """Опубликовать кадр. False - кадр длиннее слота"""
+        size = len(data)
+
+        if size > self.payload_size:
+            return False
+
+        sequence = self.sequence
+        slot = self.HEADER.size + (sequence % self.slot_count) * self.slot_size
+
+        # Слот помечается пустым на время записи, номер кадра - последним
+        self.SLOT.pack_into(self._buf, slot, 0, host_us, code, size)
+        self._buf[slot + self.SLOT.size:slot + self.SLOT.size + size] = data
+        struct.pack_into("<Q", self._buf, slot, sequence + 1)
+
+        self.sequence = sequence + 1
+        struct.pack_into("<Q", self._buf, self._SEQUENCE_OFFSET, self.sequence)
+        return True
+
+    def close(self, unlink: bool = True) -> None:
+        self._buf.release()
+        self.memory.close()
+
+        if unlink:
+            self.memory.unlink()
+
+
+class RingReader:
+    """Читатель кольца робота: кадры отдаются срезами общей памяти без копирования"""
+
+    def __init__(self, robot_id: int, from_start: bool = False) -> None:
+        """
+        :param from_start: Начать с самого старого кадра в кольце (иначе - только новые)
+        """
+        self.memory: Final = shared_memory.SharedMemory(ring_name(robot_id))
+
+        magic, version, self.slot_size, self.slot_count, _, self.robot_id, sequence = RingWriter.HEADER.unpack_from(self.memory.buf, 0)
+
+        if magic != RingWriter.MAGIC or version != RingWriter.VERSION:
+            raise ValueError(f"{ring_name(robot_id)}: не кольцо шлюза (или версия {version} не поддерживается)")
+
+        self.sequence: int = max(0, sequence - self.slot_count) if from_start else sequence
+        self.lost: int = 0
+        """Кадров пропущено из-за отставания"""
+
+        self._buf: Final = self.memory.buf
+
+    def published(self) -> int:
+        """Число опубликованных шлюзом кадров"""
+        return struct.unpack_from("<Q", self._buf, RingWriter._SEQUENCE_OFFSET)[0]
+
+    def poll(self) -> Iterator[tuple[int, int, memoryview]]:
+        """
+        Новые кадры: (код, время хоста приёма мкс, аргументы).
+        Аргументы - срез общей памяти: действителен, пока читатель не отстал на всё кольцо
+        """
+        header = RingWriter.HEADER.size
+        slot_header = RingWriter.SLOT
+
+        while True:
+            published = self.published()
+
+            if self.sequence >= published:
+                return
+
+            # Отставание больше кольца: старые кадры уже перезаписаны
+            if published - self.sequence > self.slot_count:
+                self.lost += published - self.sequence - self.slot_count
+                self.sequence = published - self.slot_count
+
+            slot = header + (self.sequence % self.slot_count) * self.slot_size
+            stamp, host_us, code, size = slot_header.unpack_from(self._buf, slot)
+
+            if stamp != self.sequence + 1:
+                # Писатель уже перезаписывает этот слот
+                self.lost += 1
+                self.sequence += 1
+                continue
+
+            self.sequence += 1
+            yield code, host_us, self._buf[slot + slot_header.size:slot + slot_header.size + size]
+
+    def close(self) -> None:
+        self._buf.release()
+        self.memory.close()
+
+
+def ring_name(robot_id: int) -> str:
+    """Имя кольца общей памяти робота"""
+    return f"zms_{robot_id:012x}"
+
+
+class Link:
+    """Порт моста, которым владеет шлюз"""
+
+    IDENTITY_PERIOD_S: Final = 0.5
+    """Период запроса идентификатора до ответа (плата перезапускается при открытии порта)"""
+
+    def __init__(self, port: str) -> None:
+        self.port: Final = port
+        self.serial: Final = Serial(port=port, baudrate=BAUD, timeout=0, write_timeout=0)
+        self.fd: Final = self.serial.fileno()
+        self.buffer: Final = bytearray()
+
+        self.robot_id: Optional[int] = None
+        self.ring: Optional[RingWriter] = None
+
+        self.frames: int = 0
+        self.bytes: int = 0
+        self._last_identity_request: float = 0.0
+
+    def request_identity(self, now: float) -> None:
+        if self.robot_id is None and now - self._last_identity_request >= self.IDENTITY_PERIOD_S:
+            self._last_identity_request = now
+            self.serial.write(bytes((GET_IDENTITY,)))
+
+    def close(self) -> None:
+        self.serial.close()
+
+        if self.ring:
+            self.ring.close()
+
+    def __str__(self) -> str:
+        name = f"{self.robot_id:012x}" if self.robot_id is not None else "?"
+        return f"{self.port}[{name}]"
+
+
+class Gateway:
+    """Шлюз: поиск портов, разбор кадров, публикация в кольца"""
+
+    DISCOVERY_PERIOD_S: Final = 2.0
+
+    def __init__(self, slot_count: int = 4096) -> None:
+        self.slot_count: Final = slot_count
+        self.links: Final = dict[str, Link]()
+        self.selector: Final = selectors.DefaultSelector()
+        self._last_discovery: float = -self.DISCOVERY_PERIOD_S
+
+    @staticmethod
+    def log(message: str) -> None:
+        print(f"Gateway: {message}")
+
+    def discover(self) -> None:
+        """Подключить новые порты"""
+        for port in SerialStream.search_ports():
+            if port in self.links or not ("USB" in port or "ACM" in port or "COM" in port):
+                continue
+
+            try:
+                link = Link(port)
+
+            except (SerialException, OSError) as e:
+                self.log(f"{port}: {e}")
+                continue
+
+            self.links[port] = link
+            self.selector.register(link.fd, selectors.EVENT_READ, link)
+            self.log(f"{port}: подключён")
+
+    def drop(self, link: Link, reason: str) -> None:
+        self.selector.unregister(link.fd)
+        link.close()
+        del self.links[link.port]
+        self.log(f"{link}: отключён ({reason})")
+
+    def receive(self, link: Link) -> None:
+        """Прочитать доступные байты порта и опубликовать разобранные кадры"""
+        try:
+            data = os.read(link.fd, 4096)
+
+        except OSError as e:
+            self.drop(link, str(e))
+            return
+
+        if not data:
+            self.drop(link, "конец потока")
+            return
+
+        host_us = host_time_us()
+        link.bytes += len(data)
+        link.buffer += data
+
+        frames, consumed = split_frames(link.buffer)
+        link.frames += len(frames)
+
+        with memoryview(link.buffer) as view:
+            for code, offset, size in frames:
+                args = view[offset:offset + size]
+
+                if code == IDENTITY:
+                    self.identify(link, FORMATS[IDENTITY].unpack_from(args)[0])
+
+                elif code == LOG:
+                    self.log(f"{link}: {bytes(args[1:]).decode(errors='replace').strip()}")
+
+                elif link.ring:
+                    link.ring.publish(code, host_us, args)
+
+                args.release()
+
+        # Буфер укорачивается после разбора: пока есть срезы, размер bytearray не меняется
+        del link.buffer[:consumed]
+
+    def identify(self, link: Link, robot_id: int) -> None:
+        if link.robot_id == robot_id:
+            return
+
+        for other in self.links.values():
+            if other is not link and other.robot_id == robot_id:
+                self.log(f"{link.port}: робот {robot_id:012x} уже подключён через {other.port}")
+                return
+
+        if link.ring:
+            link.ring.close()
+
+        link.robot_id = robot_id
+        link.ring = RingWriter(robot_id, self.slot_count)
+        self.log(f"{link}: кольцо {ring_name(robot_id)}")
+
+    def poll(self, timeout: float = 0.1) -> None:
+        now = monotonic()
+
+        if now - self._last_discovery >= self.DISCOVERY_PERIOD_S:
+            self._last_discovery = now
+            self.discover()
+
+        for link in tuple(self.links.values()):
+            try:
+                link.request_identity(now)
+
+            except SerialException as e:
+                self.drop(link, str(e))
+
+        for key, _ in self.selector.select(timeout):
+            self.receive(key.data)
+
+    def run(self, stats_period_s: float = 5.0) -> None:
+        last_stats = monotonic()
+
+        try:
+            while True:
+                self.poll()
+
+                if monotonic() - last_stats >= stats_period_s:
+                    last_stats = monotonic()
+
+                    for link in self.links.values():
+                        self.log(f"{link}: {link.frames} frames, {link.bytes} bytes")
+
+        except KeyboardInterrupt:
+            self.log("Завершение работы")
+
+        finally:
+            for link in tuple(self.links.values()):
+                self.drop(link, "остановка шлюза")
+
+
+def _watch(robot_id: int) -> None:
+    reader = RingReader(robot_id)
+
+    try:
+        while True:
+            for code, host_us, args in reader.poll():
+                fmt = FORMATS.get(code)
+                values = fmt.unpack_from(args) if fmt else bytes(args).hex()
+                print(f"{host_us} {NAMES.get(code, code)}: {values}")
+
+            sleep(0.01)
+
+    except KeyboardInterrupt:
+        print(f"lost: {reader.lost}")
+
+    finally:
+        reader.close()
+
+
+if __name__ == '__main__':
+    if len(sys.argv) == 3 and sys.argv[1] == "--watch":
+        _watch(int(sys.argv[2], 16))
+    else:
+        Gateway().run()
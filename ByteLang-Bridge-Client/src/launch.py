@@ -12,11 +12,10 @@ def _launch():
     time.sleep(1)
 
     for i in range(10):
-        robot.control_manipulator(0.0, 1.0)
-        time.sleep(1)
+        robot.move_manipulator(0.0, 1.0)
+        robot.move_manipulator(1.0, 0.0)
 
-        robot.control_manipulator(1.0, 0.0)
-        time.sleep(1)
+    robot.wait_manipulator()
 
     robot.control_manipulator(None, None)
 
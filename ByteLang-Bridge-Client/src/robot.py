@@ -1,28 +1,62 @@
+from threading import Condition
+from threading import Event
 from threading import Thread
+from time import monotonic
 from time import sleep
 from typing import Final
+from typing import TYPE_CHECKING
 from typing import Optional
+from typing import Sequence
 
 from serial import SerialException
 
+from blackbox import BlackboxDump
+from capture import CaptureWriter
+from capture import RecordingStream
+from clock_sync import ClockSync
+from clock_sync import host_time_us
+from telemetry import TelemetryRecorder
+from timeline import TraceDump
 from bytelang.core.protocol import Protocol
 from bytelang.impl.serializer.bytevector import ByteVectorSerializer
+from bytelang.impl.serializer.primitive import f32
 from bytelang.impl.serializer.primitive import i16
+from bytelang.impl.serializer.primitive import i32
 from bytelang.impl.serializer.primitive import i8
 from bytelang.impl.serializer.primitive import u16
 from bytelang.impl.serializer.primitive import u32
+from bytelang.impl.serializer.primitive import u64
 from bytelang.impl.serializer.primitive import u8
 from bytelang.impl.serializer.struct_ import StructSerializer
+from bytelang.impl.serializer.vector import VectorSerializer
 from bytelang.impl.serializer.void import VoidSerializer
 from bytelang.impl.stream.serials import SerialStream
 
+if TYPE_CHECKING:
+    from bytelang.impl.stream.aioserial import AsyncSerialStream
+
 
 class Robot(Protocol):
 
-    def __init__(self) -> None:
-        self._serial: Final = SerialStream(self._get_serial_port(), 115200)
+    def __init__(
+            self,
+            capture_path: Optional[str] = None,
+            telemetry_path: Optional[str] = None,
+            stream: Optional["SerialStream | AsyncSerialStream"] = None,
+    ) -> None:
+        """
+        :param capture_path: Записать весь трафик моста в файл захвата (см. capture.py, воспроизведение - окружение replay)
+        :param telemetry_path: Записывать телеметрию в колоночный файл (см. telemetry.py) вместо печати в лог
+        :param stream: Поток порта (по умолчанию - первый найденный порт, блокирующий SerialStream)
+        """
+        self._serial: Final = stream or SerialStream(self._get_serial_port(), 115200)
+
+        self.capture: Final = CaptureWriter(capture_path) if capture_path else None
+        stream = RecordingStream(self._serial, self.capture) if self.capture else self._serial
 
-        super().__init__(self._serial, self._serial, u8, u8)
+        super().__init__(stream, stream, u8, u8)
+
+        self.telemetry: Final = TelemetryRecorder(telemetry_path) if telemetry_path else None
 
         # senders
 
@@ -30,19 +64,137 @@ class Robot(Protocol):
         self._set_manipulator = self.add_sender(StructSerializer((u8, u8)), "set_manipulator")
         self.send_distances_request = self.add_sender(VoidSerializer(), "send_distances")
         self._set_motors = self.add_sender(StructSerializer((i16, i16)), "set_motors")
+        self._move_manipulator = self.add_sender(StructSerializer((u8, u8, u16, u16)), "move_manipulator")
+        self.stop_manipulator = self.add_sender(VoidSerializer(), "stop_manipulator")
+        self.send_pose_request = self.add_sender(VoidSerializer(), "get_pose")
+        self.reset_pose = self.add_sender(VoidSerializer(), "reset_pose")
+        self._set_pose = self.add_sender(StructSerializer((f32, f32, f32)), "set_pose")
+        self._drive = self.add_sender(StructSerializer((u8, i16, u16, u16, u8)), "drive")
+        self._turn = self.add_sender(StructSerializer((u8, i16, u16, u16, u8)), "turn")
+        self.cancel_motion = self.add_sender(VoidSerializer(), "cancel_motion")
+        self._follow_path = self.add_sender(
+            StructSerializer((u8, VectorSerializer(StructSerializer((i16, i16)), u8))),
+            "follow_path"
+        )
+        self.cancel_path = self.add_sender(VoidSerializer(), "cancel_path")
+        self._dump_blackbox = self.add_sender(VoidSerializer(), "dump_blackbox")
+        self.trigger_blackbox = self.add_sender(VoidSerializer(), "trigger_blackbox")
+        self.rearm_blackbox = self.add_sender(VoidSerializer(), "rearm_blackbox")
+        self._sync_time = self.add_sender(u64, "sync_time")
+        self._run_benchmarks = self.add_sender(u8, "run_benchmarks")
+        self.send_identity_request = self.add_sender(VoidSerializer(), "get_identity")
+        self.send_boot_timeline_request = self.add_sender(VoidSerializer(), "get_boot_timeline")
+        self._load_behaviour = self.add_sender(StructSerializer((u8, ByteVectorSerializer(u8))), "load_behaviour")
+        self._run_behaviour = self.add_sender(VoidSerializer(), "run_behaviour")
+        self.stop_behaviour = self.add_sender(VoidSerializer(), "stop_behaviour")
+        self.send_behaviour_status_request = self.add_sender(VoidSerializer(), "get_behaviour_status")
+        self.send_power_stats_request = self.add_sender(VoidSerializer(), "get_power_stats")
+        self._set_power_mode = self.add_sender(u8, "set_power_mode")
+        self.start_trace = self.add_sender(VoidSerializer(), "start_trace")
+        self._dump_trace = self.add_sender(VoidSerializer(), "dump_trace")
 
         # receivers
 
         self.add_receiver(u32, self._on_millis)
-        self.add_receiver(ByteVectorSerializer(u16), self._on_log)
-        self.add_receiver(StructSerializer((u16, u16)), self._on_distances)
-        self.add_receiver(StructSerializer((i8, i8)), self._on_encoders)
+        self.add_receiver(ByteVectorSerializer(u8), self._on_log)
+        self.add_batch_receiver(StructSerializer((u16, u16, u64)), self._on_distances)
+        self.add_batch_receiver(StructSerializer((i8, i8, u64)), self._on_encoders)
+        self.add_receiver(StructSerializer((u8, u8, u8, u8, u64)), self._on_manipulator_progress)
+        self.add_receiver(StructSerializer((f32, f32, f32, u64)), self._on_pose)
+        self.add_receiver(StructSerializer((u8, u8, u8, u64)), self._on_motion_event)
+        self.add_receiver(StructSerializer((u16, u8, i16, u8, u64)), self._on_path_progress)
+        self.add_receiver(StructSerializer((u8, u16, u16, u64)), self._on_reflex_event)
+        self.add_receiver(StructSerializer((u8, u16, u16, u8, u16, u64)), self._on_blackbox_header)
+        self.add_receiver(
+            StructSerializer((u16, VectorSerializer(
+                StructSerializer((u32, i32, i32, u16, u16, i16, i16, i16, i16, u8, u8)), u8
+            ))),
+            self._on_blackbox_chunk
+        )
+        self.add_receiver(StructSerializer((u64, u64, u64)), self._on_time_sync)
+        self.add_receiver(StructSerializer((u8, u8, ByteVectorSerializer(u8), u32, u64, u16)), self._on_benchmark_result)
+        self.add_receiver(u64, self._on_identity)
+        self.add_receiver(StructSerializer((u16, VectorSerializer(StructSerializer((u8, u32, u32)), u8))), self._on_boot_timeline)
+        self.add_receiver(StructSerializer((u8, u8, u16, u32, i32, u64)), self._on_behaviour_status)
+        self.add_receiver(StructSerializer((u8, u8, u16, u32, u32, u32, u32, u32, u16, u64)), self._on_power_stats)
+        self.add_receiver(
+            StructSerializer((
+                u16, u32, u16,
+                VectorSerializer(StructSerializer((u32, u64)), u8),
+                VectorSerializer(ByteVectorSerializer(u8), u8),
+            )),
+            self._on_trace_header
+        )
+        self.add_receiver(
+            StructSerializer((u16, VectorSerializer(StructSerializer((u32, u8, u8, u8, u8)), u8))),
+            self._on_trace_chunk
+        )
 
         #
 
         self._task_completed: bool = True
         self._task_result: int = 0
 
+        self.pose: tuple[float, float, float] = (0.0, 0.0, 0.0)
+        """Последняя принятая поза бортовой одометрии (x мм, y мм, курс рад)"""
+        self.pose_timestamp_us: int = 0
+        """Бортовое время позы (мкс)"""
+        self.pose_time: float = 0.0
+        """Время позы в часах хоста (с, шкала time.monotonic)"""
+
+        self.clock: Final = ClockSync()
+        """Оценка бортовых часов: переводит метки телеметрии в часы хоста"""
+        self._last_sync: float = 0.0
+
+        self._motion_next_id: int = 0
+        self._motion_results: Final = dict[int, int]()
+        self._motion_condition: Final = Condition()
+        self.motion_times: Final = dict[int, float]()
+        """Время завершения команд движения в часах хоста, с"""
+
+        self.path_state: int = self.PATH_IDLE
+        """Состояние бортового следования по пути"""
+        self.path_cross_track_error_mm: int = 0
+        """Последняя поперечная ошибка, мм"""
+        self.path_time: float = 0.0
+        """Время последнего прогресса пути в часах хоста, с"""
+        self._path_done: Final = Event()
+        self._path_done.set()
+
+        self._manipulator_queued: int = 0
+        self.manipulator_time: float = 0.0
+        """Время последнего прогресса манипулятора в часах хоста, с"""
+        self._manipulator_idle: Final = Event()
+        self._manipulator_idle.set()
+
+        self._blackbox: Optional[BlackboxDump] = None
+        self._blackbox_done: Final = Event()
+
+        self._trace: Optional[TraceDump] = None
+        self._trace_done: Final = Event()
+
+        self._benchmarks: Final = list[dict]()
+        self._benchmarks_single: bool = False
+        self._benchmarks_done: Final = Event()
+
+        self.robot_id: Optional[int] = None
+        """Идентификатор платы (ответ на send_identity_request)"""
+
+        self.boot_timeline: list[dict] = []
+        """Хронология загрузки робота (приходит после старта и в ответ на send_boot_timeline_request)"""
+        self.boot_degraded: bool = False
+        """Робот загрузился в деградированном режиме (часть этапов не удалась)"""
+        self._boot_timeline_received: Final = Event()
+
+        self.behaviour_status: dict = {}
+        """Последнее состояние поведения (state, fault, pc, executed, report, timestamp_us)"""
+        self._behaviour_done: Final = Event()
+        self._behaviour_done.set()
+
+        self.power_stats: dict = {}
+        """Последний отчёт питания (ответ на send_power_stats_request)"""
+        self._power_stats_received: Final = Event()
+
         self.log("Senders: \n" + "\n".join(map(str, self.get_senders())))
         self.log("Receivers: \n" + "\n".join(map(str, self.get_receivers())))
 
@@ -59,15 +211,210 @@ class Robot(Protocol):
             a = 1000
             return min(a, max(-a, int(__v * a)))
 
-        self._set_motors((_norm(left), _norm(right)))
+        left, right = _norm(left), _norm(right)
+        self._set_motors((left, right))
+
+        if self.telemetry:
+            self.telemetry.append("motors", host_time_us(), left, right)
+
+    SYNC_PERIOD_S: Final = 1.0
+    """Период обменов синхронизации часов, с"""
+
+    def sync_clock(self) -> None:
+        """Отправить запрос синхронизации часов (ответ учитывается в self.clock)"""
+        self._last_sync = monotonic()
+        self._sync_time(host_time_us())
+
+    def _on_time_sync(self, v) -> None:
+        host_receive_us = host_time_us()
+        host_send_us, robot_receive_us, robot_send_us = v
+        self.clock.add(host_send_us, robot_receive_us, robot_send_us, host_receive_us)
+
+    BENCHMARK_ALL: Final = 0xFF
+
+    def run_benchmarks(self, index: int = BENCHMARK_ALL, timeout: Optional[float] = 60.0) -> list[dict]:
+        """
+        Запустить бортовые замеры (прошивка esp32dev-bench). Робот останавливается на время замеров
+        :param index: Индекс замера или BENCHMARK_ALL
+        :return: Результаты (name, iterations, cycles_per_op, ns_per_op); неполный список по тайм-ауту
+        """
+        self._benchmarks.clear()
+        self._benchmarks_single = index != self.BENCHMARK_ALL
+        self._benchmarks_done.clear()
+        self._run_benchmarks(index)
+
+        self._benchmarks_done.wait(timeout)
+        return list(self._benchmarks)
+
+    def _on_benchmark_result(self, v) -> None:
+        index, count, name, iterations, cycles, frequency_mhz = v
+        cycles_per_op = cycles / iterations if iterations else 0.0
+
+        self._benchmarks.append({
+            "name": name.decode(errors="replace"),
+            "iterations": iterations,
+            "cycles_per_op": cycles_per_op,
+            "ns_per_op": cycles_per_op * 1000.0 / frequency_mhz if frequency_mhz else 0.0,
+        })
+
+        if self._benchmarks_single or index + 1 >= count:
+            self._benchmarks_done.set()
+
+    def _on_identity(self, robot_id: int) -> None:
+        self.robot_id = robot_id
+        self.log(f"id: {robot_id:012x}")
+
+    BOOT_STAGES: Final = (
+        "serial", "storage", "espnow", "manipulator", "motors", "distance_sensors", "encoders", "espnow_peer", "services",
+    )
+    """Этапы загрузки прошивки (порядок BootStage)"""
+
+    def get_boot_timeline(self, timeout: Optional[float] = 1.0) -> list[dict]:
+        """
+        Запросить хронологию загрузки
+        :return: Этапы (name, ok, start_us, duration_us); пустой список по тайм-ауту
+        """
+        self._boot_timeline_received.clear()
+        self.send_boot_timeline_request(None)
+
+        if not self._boot_timeline_received.wait(timeout):
+            return []
+
+        return list(self.boot_timeline)
+
+    def _on_boot_timeline(self, v) -> None:
+        failed, stages = v
+
+        self.boot_degraded = failed != 0
+        self.boot_timeline = [
+            {
+                "name": self.BOOT_STAGES[i] if i < len(self.BOOT_STAGES) else f"stage{i}",
+                "ok": bool(ok),
+                "start_us": start_us,
+                "duration_us": duration_us,
+            }
+            for i, (ok, start_us, duration_us) in enumerate(stages)
+        ]
+        self._boot_timeline_received.set()
+
+        # Этапы, которых нет в сборке (ESP-NOW на хосте), приходят нулевыми
+        timeline = ", ".join(f"{s['name']} {s['duration_us']}us{'' if s['ok'] else ' FAILED'}" for s in self.boot_timeline if s["ok"] or s["start_us"] or s["duration_us"])
+        self.log(f"boot{' (degraded)' if self.boot_degraded else ''}: {timeline}")
+
+    def upload_behaviour(self, program: "bytes | str", run: bool = True) -> None:
+        """
+        Загрузить поведение (см. behaviour.py); исполняемое поведение прерывается
+        :param program: Байткод или текст программы (собирается здесь)
+        :param run: Сразу запустить (итог проверки - в behaviour_status)
+        """
+        from behaviour import assemble
+
+        code = assemble(program) if isinstance(program, str) else bytes(program)
+        chunk = 255
+
+        for offset in range(0, len(code), chunk):
+            self._load_behaviour((0 if offset == 0 else 1, code[offset:offset + chunk]))
+
+        if run:
+            self.run_behaviour()
+
+    def run_behaviour(self) -> None:
+        """Проверить и запустить загруженное поведение (прерывает примитивы движения и путь)"""
+        self._behaviour_done.clear()
+        self._run_behaviour(None)
+
+    def wait_behaviour(self, timeout: Optional[float] = None) -> bool:
+        """
+        Дождаться завершения поведения (halt, отказ, отмена)
+        :return: False по тайм-ауту
+        """
+        return self._behaviour_done.wait(timeout)
+
+    def _on_behaviour_status(self, v) -> None:
+        from behaviour import FAULTS
+        from behaviour import STATES
+
+        state, fault, pc, executed, report, timestamp_us = v
+
+        self.behaviour_status = {
+            "state": STATES[state] if state < len(STATES) else state,
+            "fault": FAULTS[fault] if fault < len(FAULTS) else fault,
+            "pc": pc,
+            "executed": executed,
+            "report": report,
+            "timestamp_us": timestamp_us,
+        }
+
+        # Статус загрузки (ready) может прийти уже после запуска: ждём только завершения
+        if self.behaviour_status["state"] in ("halted", "faulted", "cancelled"):
+            self._behaviour_done.set()
+
+        if fault:
+            self.log(f"behaviour fault: {self.behaviour_status['fault']} at pc={pc}")
+
+    POWER_MODES: Final = ("performance", "balanced", "saving")
+    """Режимы питания (порядок PowerSettings::Mode)"""
+
+    POWER_LEVELS: Final = ("active", "idle", "sleep")
+    """Уровни питания (порядок PowerPolicy::Level)"""
 
-    def _on_encoders(self, v) -> None:
-        self.log(v)
-        return
+    def set_power_mode(self, mode: str) -> None:
+        """
+        Режим питания до перезагрузки робота
+        :param mode: performance - наибольшая частота всегда; balanced - в простое наименьшая частота;
+        saving - в простое ещё и лёгкий сон (первые байты команды, разбудившей робота, теряются)
+        """
+        self._set_power_mode(self.POWER_MODES.index(mode))
+
+    def get_power_stats(self, timeout: Optional[float] = 1.0) -> dict:
+        """
+        Запросить отчёт питания за окно с прошлого запроса
+        :return: mode, level, frequency_mhz, задержки цикла и пробуждения (мкс), sleeps, sleep_fraction; пустой по тайм-ауту
+        """
+        self._power_stats_received.clear()
+        self.send_power_stats_request(None)
+
+        if not self._power_stats_received.wait(timeout):
+            return {}
+
+        return dict(self.power_stats)
+
+    def _on_power_stats(self, v) -> None:
+        mode, level, frequency_mhz, loop_mean_us, loop_max_us, wake_mean_us, wake_max_us, sleeps, sleep_permille, timestamp_us = v
 
-    def _on_distances(self, v) -> None:
-        self.log(v)
-        return
+        self.power_stats = {
+            "mode": self.POWER_MODES[mode] if mode < len(self.POWER_MODES) else mode,
+            "level": self.POWER_LEVELS[level] if level < len(self.POWER_LEVELS) else level,
+            "frequency_mhz": frequency_mhz,
+            "loop_mean_us": loop_mean_us,
+            "loop_max_us": loop_max_us,
+            "wake_mean_us": wake_mean_us,
+            "wake_max_us": wake_max_us,
+            "sleeps": sleeps,
+            "sleep_fraction": sleep_permille / 1000.0,
+            "timestamp_us": timestamp_us,
+        }
+        self._power_stats_received.set()
+
+    def _on_encoders(self, columns) -> None:
+        left, right, timestamp_us = columns
+
+        if self.telemetry:
+            self.telemetry.append_many("encoders", self.clock.to_host_us_many(timestamp_us), timestamp_us, left, right)
+            return
+
+        for l, r, t in zip(left, right, timestamp_us):
+            self.log(f"encoders @{self.clock.to_host_s(int(t)):.6f}: {l} {r}")
+
+    def _on_distances(self, columns) -> None:
+        left, right, timestamp_us = columns
+
+        if self.telemetry:
+            self.telemetry.append_many("distances", self.clock.to_host_us_many(timestamp_us), timestamp_us, left, right)
+            return
+
+        for l, r, t in zip(left, right, timestamp_us):
+            self.log(f"distances @{self.clock.to_host_s(int(t)):.6f}: {l} {r}")
 
     def control_manipulator(self, /, arm: Optional[float] = None, claw: Optional[float] = None) -> None:
         """
@@ -89,6 +436,239 @@ class Robot(Protocol):
             _normalize(claw, 0, 180),
         ))
 
+    def move_manipulator(
+            self, /,
+            arm: float,
+            claw: float,
+            max_velocity: int = 90,
+            acceleration: int = 180
+    ) -> None:
+        """
+        Добавить точку траектории манипулятора (исполняется на роботе)
+        :param arm: Звено [0..1]
+        :param claw: Захват [0..1]
+        :param max_velocity: Максимальная скорость, град/с
+        :param acceleration: Ускорение, град/с^2
+        """
+
+        def _normalize(__v: float, __min: int, __max: int) -> int:
+            __v = min(1.0, max(0.0, __v))
+            return int(__v * (__max - __min)) + __min
+
+        self._manipulator_queued += 1
+        self._manipulator_idle.clear()
+
+        self._move_manipulator((
+            _normalize(arm, 180, 90),
+            _normalize(claw, 0, 180),
+            max_velocity,
+            acceleration,
+        ))
+
+    def wait_manipulator(self, timeout: Optional[float] = None) -> bool:
+        """
+        Дождаться завершения всех точек траектории манипулятора
+        :return: False при истечении тайм-аута
+        """
+        return self._manipulator_idle.wait(timeout)
+
+    def _on_manipulator_progress(self, v) -> None:
+        arm, claw, queued, completed, timestamp_us = v
+        self._manipulator_queued = queued
+        self.manipulator_time = self.clock.to_host_s(timestamp_us)
+
+        if queued == 0:
+            self._manipulator_idle.set()
+
+    MOTION_STARTED: Final = 0x00
+    MOTION_COMPLETED: Final = 0x01
+    MOTION_TIMEOUT: Final = 0x02
+    MOTION_CANCELLED: Final = 0x03
+    MOTION_REJECTED: Final = 0x04
+
+    def drive(self, distance_mm: int, max_speed: int = 300, acceleration: int = 600, replace: bool = False) -> int:
+        """
+        Проехать расстояние (исполняется на роботе)
+        :param distance_mm: Расстояние, мм (отрицательное - назад)
+        :param max_speed: мм/с
+        :param acceleration: мм/с^2
+        :param replace: Прервать текущие команды вместо постановки в очередь
+        :return: Идентификатор команды для wait_motion
+        """
+        return self._send_motion(self._drive, distance_mm, max_speed, acceleration, replace)
+
+    def turn(self, angle_deg: int, max_speed: int = 180, acceleration: int = 360, replace: bool = False) -> int:
+        """
+        Повернуть на месте (исполняется на роботе)
+        :param angle_deg: Угол, град (положительный - против часовой)
+        :param max_speed: град/с
+        :param acceleration: град/с^2
+        :param replace: Прервать текущие команды вместо постановки в очередь
+        :return: Идентификатор команды для wait_motion
+        """
+        return self._send_motion(self._turn, angle_deg, max_speed, acceleration, replace)
+
+    def wait_motion(self, motion_id: int, timeout: Optional[float] = None) -> Optional[int]:
+        """
+        Дождаться завершения команды движения
+        :return: Итог (MOTION_COMPLETED / TIMEOUT / CANCELLED / REJECTED) или None по тайм-ауту
+        """
+        with self._motion_condition:
+            self._motion_condition.wait_for(lambda: motion_id in self._motion_results, timeout)
+            return self._motion_results.pop(motion_id, None)
+
+    def _send_motion(self, sender, amount: int, max_speed: int, acceleration: int, replace: bool) -> int:
+        motion_id = self._motion_next_id
+        self._motion_next_id = (self._motion_next_id + 1) % 256
+
+        with self._motion_condition:
+            self._motion_results.pop(motion_id, None)
+
+        sender((motion_id, amount, max_speed, acceleration, int(replace)))
+        return motion_id
+
+    def _on_motion_event(self, v) -> None:
+        motion_id, kind, queued, timestamp_us = v
+
+        if kind == self.MOTION_STARTED:
+            return
+
+        with self._motion_condition:
+            self.motion_times[motion_id] = self.clock.to_host_s(timestamp_us)
+            self._motion_results[motion_id] = kind
+            self._motion_condition.notify_all()
+
+    PATH_IDLE: Final = 0x00
+    PATH_FOLLOWING: Final = 0x01
+    PATH_COMPLETED: Final = 0x02
+    PATH_CANCELLED: Final = 0x03
+
+    _PATH_CHUNK: Final = 32
+    """Точек в одной инструкции (ограничено буфером приёма на роботе)"""
+
+    def follow_path(self, points: Sequence[tuple[int, int]], append: bool = False) -> None:
+        """
+        Загрузить путь для бортового следования
+        :param points: Точки (x, y) в мм в системе координат одометрии
+        :param append: Дописать к текущему пути вместо начала нового
+        """
+        self._path_done.clear()
+
+        for i in range(0, len(points), self._PATH_CHUNK):
+            chunk = [(int(x), int(y)) for x, y in points[i:i + self._PATH_CHUNK]]
+            self._follow_path((int(append or i > 0), chunk))
+
+    def wait_path(self, timeout: Optional[float] = None) -> bool:
+        """Дождаться завершения (или отмены) следования по пути"""
+        return self._path_done.wait(timeout)
+
+    def _on_path_progress(self, v) -> None:
+        passed, remaining, cross_track_error, state, timestamp_us = v
+        self.path_state = state
+        self.path_cross_track_error_mm = cross_track_error
+        self.path_time = self.clock.to_host_s(timestamp_us)
+
+        if state in (self.PATH_COMPLETED, self.PATH_CANCELLED):
+            self._path_done.set()
+
+    REFLEX_PASS: Final = 0x00
+    REFLEX_CLAMP: Final = 0x01
+    REFLEX_STOP: Final = 0x02
+
+    def _on_reflex_event(self, v) -> None:
+        level, left_mm, right_mm, timestamp_us = v
+        name = {self.REFLEX_PASS: "released", self.REFLEX_CLAMP: "clamp", self.REFLEX_STOP: "stop"}.get(level, level)
+        self.log(f"reflex {name} @{self.clock.to_host_s(timestamp_us):.6f}: L={left_mm}mm R={right_mm}mm")
+
+    def dump_blackbox(self, timeout: Optional[float] = 10.0) -> Optional[BlackboxDump]:
+        """
+        Выгрузить бортовой самописец (запись на роботе замораживается, если ещё идёт)
+        :return: Выгрузка или None по тайм-ауту
+        """
+        self._blackbox = None
+        self._blackbox_done.clear()
+        self._dump_blackbox(None)
+
+        if not self._blackbox_done.wait(timeout):
+            return None
+
+        return self._blackbox
+
+    def _on_blackbox_header(self, v) -> None:
+        sample_size, count, trigger_index, reason, frequency_hz, timestamp_us = v
+        self._blackbox = BlackboxDump(sample_size, count, trigger_index, reason, frequency_hz, timestamp_us, self.clock)
+        self.log(f"blackbox: {count} samples, trigger #{trigger_index} ({self._blackbox.reason})")
+
+        if count == 0:
+            self._blackbox_done.set()
+
+    def _on_blackbox_chunk(self, v) -> None:
+        offset, samples = v
+
+        if self._blackbox is None:
+            return
+
+        self._blackbox.add_chunk(offset, samples)
+
+        if self._blackbox.complete():
+            self._blackbox_done.set()
+
+    def dump_trace(self, timeout: Optional[float] = 10.0) -> Optional[TraceDump]:
+        """
+        Выгрузить трассу (запись на роботе замораживается; начать заново - start_trace)
+        :return: Выгрузка (TraceDump.save - JSON для Perfetto) или None по тайм-ауту
+        """
+        self._trace = None
+        self._trace_done.clear()
+        self._dump_trace(None)
+
+        if not self._trace_done.wait(timeout):
+            return None
+
+        return self._trace
+
+    def _on_trace_header(self, v) -> None:
+        count, lost, frequency_mhz, references, tasks = v
+        instructions = [i.name for i in self.get_senders()]
+
+        self._trace = TraceDump(
+            count, lost, frequency_mhz, references,
+            [bytes(t).decode(errors="replace") for t in tasks], instructions
+        )
+        self.log(f"trace: {count} events, {lost} lost, tasks: {', '.join(self._trace.tasks)}")
+
+        if count == 0:
+            self._trace_done.set()
+
+    def _on_trace_chunk(self, v) -> None:
+        offset, events = v
+
+        if self._trace is None:
+            return
+
+        self._trace.add_chunk(offset, events)
+
+        if self._trace.complete():
+            self._trace_done.set()
+
+    def set_pose(self, x: float, y: float, heading: float) -> None:
+        """
+        Установить позу бортовой одометрии
+        :param x: мм
+        :param y: мм
+        :param heading: Курс, рад
+        """
+        self._set_pose((x, y, heading))
+
+    def _on_pose(self, v) -> None:
+        x, y, heading, timestamp_us = v
+        self.pose = (x, y, heading)
+        self.pose_timestamp_us = timestamp_us
+        self.pose_time = self.clock.to_host_s(timestamp_us)
+
+        if self.telemetry:
+            self.telemetry.append("pose", self.clock.to_host_us(timestamp_us), timestamp_us, x, y, heading)
+
     @staticmethod
     def log(message: str) -> None:
         """Записать лог"""
@@ -105,7 +685,19 @@ class Robot(Protocol):
         while True:
             try:
                 while True:
-                    self.poll()
+                    # Всё накопленное за цикл разбирается разом: частая телеметрия - пакетами
+                    self.poll_all()
+
+                    if monotonic() - self._last_sync >= self.SYNC_PERIOD_S:
+                        self.sync_clock()
+
+                        # Захват сбрасывается на диск с тем же периодом: поток опроса - демон
+                        if self.capture:
+                            self.capture.flush()
+
+                        if self.telemetry:
+                            self.telemetry.flush()
+
                     sleep(0.001)
 
             except SerialException as e:
@@ -115,15 +707,27 @@ class Robot(Protocol):
 
             except KeyboardInterrupt:
                 self.log("Завершение работы")
+
+                if self.capture:
+                    self.capture.close()
+
+                if self.telemetry:
+                    self.telemetry.close()
+
                 break
 
+    @staticmethod
+    def search_ports() -> Sequence[str]:
+        """Порты, похожие на плату робота"""
+        return tuple(
+            p
+            for p in SerialStream.search_ports()
+            if "USB" in p or "COM" in p and "COM1" not in p
+        )
+
     def _get_serial_port(self) -> str:
         while True:
-            ports = tuple(
-                p
-                for p in SerialStream.search_ports()
-                if "USB" in p or "COM" in p and "COM1" not in p
-            )
+            ports = self.search_ports()
 
             if ports:
                 self.log(f"Обнаружен порты {ports}")
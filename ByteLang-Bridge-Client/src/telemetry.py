@@ -0,0 +1,277 @@
+"""
+Запись телеметрии в колоночный файл, отображённый в память.
+
+Файл состоит из таблиц (по одной на поток телеметрии). Место под все строки выделяется при создании
+(разреженный файл: диск занимают только записанные страницы), поэтому запись - присваивание в готовые
+колонки без выделения памяти на отсчёт. Файл можно читать, пока идёт запись: число строк таблицы
+обновляется после записи значений, читатель видит только завершённые строки.
+
+Формат (little-endian):
+    заголовок (страница 4096 байт):
+        b"ZMSTLM\\0\\0" | u16 версия | u16 число таблиц | u32 резерв | u64 время хоста создания (мкс)
+        таблица: 16s имя | u64 ёмкость (строк) | u64 число строк | u16 число колонок | 6x
+                 колонка (до 8): 16s имя | 4s формат numpy ("<u8", "<i2", ...) | 4x | u64 смещение колонки
+    колонки: непрерывные массивы (ёмкость x размер значения), выровнены по странице
+
+Чтение без копирования: open_telemetry() - numpy.ndarray поверх mmap, если есть numpy, иначе memoryview.
+"""
+
+import mmap
+import os
+import struct
+import sys
+from threading import Lock
+from typing import Final
+from typing import Optional
+from typing import Sequence
+
+from clock_sync import host_time_us
+
+MAGIC: Final = b"ZMSTLM\0\0"
+VERSION: Final = 1
+
+PAGE: Final = 4096
+
+MAX_COLUMNS: Final = 8
+
+_HEADER: Final = struct.Struct("<8sHHIQ")
+_TABLE: Final = struct.Struct("<16sQQH6x")
+_COLUMN: Final = struct.Struct("<16s4s4xQ")
+
+_TABLE_SIZE: Final = _TABLE.size + MAX_COLUMNS * _COLUMN.size
+
+_COUNT_OFFSET: Final = 16 + 8
+"""Смещение числа строк внутри записи таблицы"""
+
+_MEMORYVIEW_FORMATS: Final = {
+    "<u1": "B", "<i1": "b",
+    "<u2": "H", "<i2": "h",
+    "<u4": "I", "<i4": "i",
+    "<u8": "Q", "<i8": "q",
+    "<f4": "f", "<f8": "d",
+}
+"""Формат numpy -> формат memoryview"""
+
+TABLES: Final = {
+    "encoders": (("host_us", "<u8"), ("robot_us", "<u8"), ("left", "<i1"), ("right", "<i1")),
+    "distances": (("host_us", "<u8"), ("robot_us", "<u8"), ("left_mm", "<u2"), ("right_mm", "<u2")),
+    "motors": (("host_us", "<u8"), ("left", "<i2"), ("right", "<i2")),
+    "pose": (("host_us", "<u8"), ("robot_us", "<u8"), ("x_mm", "<f4"), ("y_mm", "<f4"), ("heading", "<f4")),
+}
+"""Таблицы телеметрии робота: имя -> колонки (имя, формат)"""
+
+
+def _align(value: int) -> int:
+    return (value + PAGE - 1) // PAGE * PAGE
+
+
+def _itemsize(fmt: str) -> int:
+    return struct.calcsize(_MEMORYVIEW_FORMATS[fmt])
+
+
+class _Table:
+    """Таблица записи: колонки - memoryview поверх mmap, запись строки без выделения памяти"""
+
+    def __init__(self, mm: mmap.mmap, header_offset: int, capacity: int, columns: Sequence[memoryview], formats: Sequence[str]) -> None:
+        self.capacity: Final = capacity
+        self.count: int = 0
+        self.dropped: int = 0
+        """Строк, не поместившихся в ёмкость"""
+
+        self._columns: Final = columns
+        self._formats: Final = formats
+        self._count: Final = memoryview(mm)[header_offset + _COUNT_OFFSET:header_offset + _COUNT_OFFSET + 8].cast("Q")
+
+    def append(self, *values) -> bool:
+        """Дописать строку (значения в порядке колонок). False - таблица заполнена"""
+        i = self.count
+
+        if i == self.capacity:
+            self.dropped += 1
+            return False
+
+        for column, value in zip(self._columns, values):
+            column[i] = value
+
+        # Число строк - после значений: читатель не увидит недописанную строку
+        self.count = i + 1
+        self._count[0] = self.count
+        return True
+
+    def append_many(self, *columns) -> int:
+        """
+        Дописать строки колонками (numpy-массивы или последовательности одной длины)
+        :return: Число записанных строк (остальные не поместились в ёмкость)
+        """
+        i = self.count
+        total = len(columns[0])
+        n = min(total, self.capacity - i)
+        self.dropped += total - n
+
+        for column, fmt, values in zip(self._columns, self._formats, columns):
+            if hasattr(values, "dtype"):
+                # numpy: одна копия среза в колонку, приведение типа - на стороне numpy
+                column[i:i + n] = memoryview(values[:n].astype(fmt)).cast("B").cast(column.format)
+            else:
+                for j in range(n):
+                    column[i + j] = values[j]
+
+        self.count = i + n
+        self._count[0] = self.count
+        return n
+
+    def release(self) -> None:
+        for column in self._columns:
+            column.release()
+
+        self._count.release()
+
+
+class TelemetryRecorder:
+    """Запись телеметрии робота в колоночный файл, отображённый в память"""
+
+    def __init__(self, path: str, capacity: int = 1 << 22, tables: dict = TABLES) -> None:
+        """
+        :param path: Файл (перезаписывается)
+        :param capacity: Ёмкость каждой таблицы, строк (по умолчанию ~11 ч на 100 Гц)
+        :param tables: Таблицы: имя -> колонки (имя, формат numpy)
+        """
+        header_size = _align(_HEADER.size + len(tables) * _TABLE_SIZE)
+        offset = header_size
+        layout = []
+
+        for name, columns in tables.items():
+            if len(columns) > MAX_COLUMNS:
+                raise ValueError(f"{name}: больше {MAX_COLUMNS} колонок")
+
+            placed = []
+            for column, fmt in columns:
+                placed.append((column, fmt, offset))
+                offset = _align(offset + capacity * _itemsize(fmt))
+
+            layout.append((name, placed))
+
+        self._file: Final = open(path, "w+b")
+        self._file.truncate(offset)
+        self._mm: Final = mmap.mmap(self._file.fileno(), offset)
+        self._lock: Final = Lock()
+
+        _HEADER.pack_into(self._mm, 0, MAGIC, VERSION, len(layout), 0, host_time_us())
+
+        self.tables: Final = dict[str, _Table]()
+
+        for t, (name, placed) in enumerate(layout):
+            table_offset = _HEADER.size + t * _TABLE_SIZE
+            _TABLE.pack_into(self._mm, table_offset, name.encode(), capacity, 0, len(placed))
+
+            views = []
+            for c, (column, fmt, column_offset) in enumerate(placed):
+                _COLUMN.pack_into(self._mm, table_offset + _TABLE.size + c * _COLUMN.size, column.encode(), fmt.encode(), column_offset)
+                size = capacity * _itemsize(fmt)
+                views.append(memoryview(self._mm)[column_offset:column_offset + size].cast(_MEMORYVIEW_FORMATS[fmt]))
+
+            self.tables[name] = _Table(self._mm, table_offset, capacity, views, [fmt for _, fmt, _ in placed])
+
+    def append(self, table: str, *values) -> bool:
+        """Дописать строку в таблицу. False - таблица заполнена"""
+        with self._lock:
+            return self.tables[table].append(*values)
+
+    def append_many(self, table: str, *columns) -> int:
+        """Дописать строки колонками. Возвращает число записанных строк"""
+        with self._lock:
+            return self.tables[table].append_many(*columns)
+
+    def flush(self) -> None:
+        """Сбросить записанные страницы на диск (для читателей в других процессах не требуется)"""
+        with self._lock:
+            self._mm.flush()
+
+    def close(self) -> None:
+        with self._lock:
+            for table in self.tables.values():
+                table.release()
+
+            self._mm.flush()
+            self._mm.close()
+            self._file.close()
+
+
+class TelemetryFile:
+    """Чтение файла телеметрии без копирования (в том числе во время записи)"""
+
+    def __init__(self, path: str) -> None:
+        self._file: Final = open(path, "rb")
+        self._mm: Final = mmap.mmap(self._file.fileno(), 0, access=mmap.ACCESS_READ)
+
+        magic, version, table_count, _, self.start_host_us = _HEADER.unpack_from(self._mm, 0)
+
+        if magic != MAGIC or version != VERSION:
+            raise ValueError(f"{path}: не файл телеметрии (или версия {version} не поддерживается)")
+
+        self._tables: Final = dict[str, tuple[int, list[tuple[str, str, int]]]]()
+
+        for t in range(table_count):
+            table_offset = _HEADER.size + t * _TABLE_SIZE
+            name, _, _, column_count = _TABLE.unpack_from(self._mm, table_offset)
+
+            columns = []
+            for c in range(column_count):
+                column, fmt, column_offset = _COLUMN.unpack_from(self._mm, table_offset + _TABLE.size + c * _COLUMN.size)
+                columns.append((column.rstrip(b"\0").decode(), fmt.rstrip(b"\0").decode(), column_offset))
+
+            self._tables[name.rstrip(b"\0").decode()] = (table_offset, columns)
+
+    def names(self) -> list[str]:
+        return list(self._tables)
+
+    def count(self, table: str) -> int:
+        """Число завершённых строк таблицы на момент вызова"""
+        table_offset, _ = self._tables[table]
+        return struct.unpack_from("<Q", self._mm, table_offset + _COUNT_OFFSET)[0]
+
+    def table(self, table: str, count: Optional[int] = None) -> dict:
+        """
+        Колонки таблицы: имя -> numpy.ndarray (или memoryview без numpy) поверх отображения файла
+        :param count: Число строк (по умолчанию - завершённые на момент вызова)
+        """
+        _, columns = self._tables[table]
+        count = self.count(table) if count is None else count
+
+        try:
+            import numpy
+        except ImportError:
+            numpy = None
+
+        result = {}
+
+        for column, fmt, column_offset in columns:
+            if numpy is not None:
+                result[column] = numpy.frombuffer(self._mm, dtype=fmt, count=count, offset=column_offset)
+            else:
+                size = count * _itemsize(fmt)
+                result[column] = memoryview(self._mm)[column_offset:column_offset + size].cast(_MEMORYVIEW_FORMATS[fmt])
+
+        return result
+
+
+def open_telemetry(path: str) -> TelemetryFile:
+    """Открыть файл телеметрии для чтения"""
+    return TelemetryFile(path)
+
+
+def _summary(path: str) -> None:
+    f = TelemetryFile(path)
+    print(f"{path}: {os.path.getsize(path)} bytes (sparse)")
+
+    for name in f.names():
+        count = f.count(name)
+        columns = f.table(name, count)
+        times = columns["host_us"]
+        span = (times[count - 1] - times[0]) / 1e6 if count > 1 else 0.0
+        print(f"  {name}: {count} rows, {span:.3f} s, columns {', '.join(columns)}")
+
+
+if __name__ == '__main__':
+    for _path in sys.argv[1:]:
+        _summary(_path)
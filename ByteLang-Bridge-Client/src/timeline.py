@@ -0,0 +1,190 @@
+"""
+Трасса по времени с робота (zms/tools/Trace.hpp) в формате Chrome Trace Event (JSON):
+открывается в ui.perfetto.dev и chrome://tracing.
+
+Прошивка собирается с ZMS_TRACE (окружение esp32dev-trace). Запись - Robot.start_trace(),
+выгрузка - Robot.dump_trace(), сохранение - TraceDump.save("trace.json").
+
+Метка события - счётчик тактов своего ядра (32 бита). Время восстанавливается от показаний
+(такты, мкс) каждого ядра, снятых при заморозке, назад по цепочке событий ядра: промежуток между
+соседними событиями ядра должен быть меньше 2^31 тактов (~9 с на 240 МГц).
+Дорожки: процесс - ядро, поток - задача; прерывания - отдельный поток ядра.
+"""
+
+import json
+from typing import Final
+from typing import Optional
+from typing import Sequence
+
+POINTS: Final = (
+    "services",
+    "service",
+    "bridge",
+    "espnow_receive",
+    "encoder_isr",
+    "motor_write",
+    "servo_write",
+)
+"""Точки трассировки (порядок TracePoint)"""
+
+SERVICES: Final = ("text_ui", "bytelang_bridge", "dual_joystick_remote_controller", "blackbox")
+"""Сервисы (порядок Service::poll)"""
+
+EVENT_SIZE: Final = 8
+"""Размер события на роботе, байт"""
+
+TASK_ISR: Final = 0xFF
+TASK_OTHER: Final = 0xFE
+"""Особые индексы задачи (Trace::task_isr, Trace::task_other)"""
+
+_BEGIN: Final = 0
+_END: Final = 1
+
+
+class TraceDump:
+    """Выгрузка трассы, собираемая из фрагментов"""
+
+    def __init__(
+            self,
+            count: int,
+            lost: int,
+            frequency_mhz: int,
+            references: Sequence[tuple[int, int]],
+            tasks: Sequence[str],
+            instructions: Sequence[Optional[str]] = (),
+    ) -> None:
+        """
+        :param references: Показания ядер при заморозке: (такты, мкс)
+        :param tasks: Имена задач в порядке реестра
+        :param instructions: Имена инструкций робота по коду (для событий моста)
+        """
+        if frequency_mhz == 0:
+            raise ValueError("Нулевая частота счётчика тактов")
+
+        self.count: Final = count
+        self.lost: Final = lost
+        self.frequency_mhz: Final = frequency_mhz
+        self.references: Final = tuple(tuple(r) for r in references)
+        self.tasks: Final = tuple(tasks)
+        self.instructions: Final = tuple(instructions)
+        self._events: Final[list[Optional[tuple]]] = [None] * count
+
+    def add_chunk(self, offset: int, events: Sequence[tuple]) -> None:
+        """Принять фрагмент событий"""
+        for i, event in enumerate(events):
+            if offset + i < self.count:
+                self._events[offset + i] = tuple(event)
+
+    def complete(self) -> bool:
+        """Все события приняты"""
+        return all(e is not None for e in self._events)
+
+    def task_name(self, task: int, core: int) -> str:
+        if task == TASK_ISR:
+            return f"isr core {core}"
+
+        if task < len(self.tasks):
+            return self.tasks[task]
+
+        return "other"
+
+    def event_name(self, point: int, arg: int) -> str:
+        name = POINTS[point] if point < len(POINTS) else f"point {point}"
+
+        if name == "service":
+            return SERVICES[arg] if arg < len(SERVICES) else f"service {arg}"
+
+        if name == "bridge":
+            instruction = self.instructions[arg] if arg < len(self.instructions) else None
+            return f"bridge {instruction or f'0x{arg:02X}'}"
+
+        return name
+
+    def events(self) -> list[dict]:
+        """События в порядке времени: t_us (бортовое время), core, task, name, point, arg, phase"""
+        received = [e for e in self._events if e is not None]
+        result = []
+
+        for core, (ref_cycles, ref_us) in enumerate(self.references):
+            own = [e for e in received if e[3] >> 1 == core]
+
+            if not own:
+                continue
+
+            # Такты относительно показаний при заморозке: последнее событие ядра - раньше заморозки,
+            # предыдущие - назад по разностям соседних (со знаком: запись в кольцо не строго по времени)
+            t = -((ref_cycles - own[-1][0]) % 2 ** 32)
+            times = [0] * len(own)
+
+            for i in range(len(own) - 1, -1, -1):
+                if i < len(own) - 1:
+                    delta = (own[i + 1][0] - own[i][0]) % 2 ** 32
+
+                    if delta >= 2 ** 31:
+                        delta -= 2 ** 32
+
+                    t -= delta
+
+                times[i] = t
+
+            for (cycles, point, arg, flags, task), t in zip(own, times):
+                result.append({
+                    "t_us": ref_us + t / self.frequency_mhz,
+                    "core": core,
+                    "task": self.task_name(task, core),
+                    "tid": task,
+                    "name": self.event_name(point, arg),
+                    "point": POINTS[point] if point < len(POINTS) else str(point),
+                    "arg": arg,
+                    "phase": "end" if flags & 1 else "begin",
+                })
+
+        result.sort(key=lambda e: e["t_us"])
+        return result
+
+    def to_chrome(self) -> dict:
+        """Трасса в формате Chrome Trace Event (JSON-объект)"""
+        trace_events = []
+        threads = dict[tuple[int, int], str]()
+        open_scopes = dict[tuple[int, int], int]()
+
+        for e in self.events():
+            key = (e["core"], e["tid"])
+            threads[key] = e["task"]
+
+            if e["phase"] == "begin":
+                open_scopes[key] = open_scopes.get(key, 0) + 1
+            elif open_scopes.get(key, 0) > 0:
+                open_scopes[key] -= 1
+            else:
+                # Начало перезаписано кольцом
+                continue
+
+            trace_events.append({
+                "name": e["name"],
+                "cat": e["point"],
+                "ph": "B" if e["phase"] == "begin" else "E",
+                "ts": e["t_us"],
+                "pid": e["core"],
+                "tid": e["tid"],
+                "args": {"arg": e["arg"]},
+            })
+
+        metadata = []
+
+        for core in range(len(self.references)):
+            metadata.append({"name": "process_name", "ph": "M", "pid": core, "args": {"name": f"core {core}"}})
+
+        for (core, tid), task in sorted(threads.items()):
+            metadata.append({"name": "thread_name", "ph": "M", "pid": core, "tid": tid, "args": {"name": task}})
+
+        return {
+            "traceEvents": metadata + trace_events,
+            "displayTimeUnit": "ns",
+            "otherData": {"lost_events": self.lost, "frequency_mhz": self.frequency_mhz},
+        }
+
+    def save(self, path: str) -> None:
+        """Сохранить в JSON (Perfetto, chrome://tracing)"""
+        with open(path, "w") as f:
+            json.dump(self.to_chrome(), f)
@@ -0,0 +1,144 @@
+"""Неблокирующий поток по последовательному порту (AsyncSerialStream) на псевдотерминале вместо порта"""
+
+import asyncio
+import os
+import sys
+import unittest
+from pathlib import Path
+
+sys.path.insert(0, str(Path(__file__).resolve().parent.parent / "src"))
+
+from bytelang.impl.stream.aioserial import AsyncSerialStream
+
+
+class Pty:
+    """Пара псевдотерминала: поток открывает подчинённую сторону по имени, тест работает с ведущей"""
+
+    def __init__(self) -> None:
+        self.master, slave = os.openpty()
+        self.path = os.ttyname(slave)
+
+        # Подчинённую сторону держит открытой поток; копия теста закрывается, чтобы обрыв был виден
+        os.close(slave)
+        os.set_blocking(self.master, False)
+
+    async def read_exactly(self, size: int, timeout: float = 2.0) -> bytes:
+        data = bytearray()
+
+        async def collect() -> None:
+            while len(data) < size:
+                try:
+                    data.extend(os.read(self.master, size - len(data)))
+
+                except BlockingIOError:
+                    await asyncio.sleep(0.001)
+
+        await asyncio.wait_for(collect(), timeout)
+        return bytes(data)
+
+    def close(self) -> None:
+        if self.master >= 0:
+            os.close(self.master)
+            self.master = -1
+
+
+async def wait_until(condition, timeout: float = 2.0) -> None:
+    async def poll() -> None:
+        while not condition():
+            await asyncio.sleep(0.001)
+
+    await asyncio.wait_for(poll(), timeout)
+
+
+@unittest.skipUnless(hasattr(os, "openpty"), "нужен POSIX-псевдотерминал")
+class AsyncSerialStreamTest(unittest.IsolatedAsyncioTestCase):
+
+    async def asyncSetUp(self) -> None:
+        self.pty = Pty()
+        self.received = 0
+
+        def on_data() -> None:
+            self.received += 1
+
+        self.stream = AsyncSerialStream(self.pty.path, on_data=on_data, backoff=(0.01, 0.05))
+        self.stream.start()
+        await self.stream.wait_connected(2.0)
+
+    async def asyncTearDown(self) -> None:
+        await self.stream.close()
+        self.pty.close()
+
+    async def test_connects(self):
+        self.assertTrue(self.stream.connected)
+        self.assertEqual(self.pty.path, self.stream.port)
+        self.assertEqual(1, self.stream.connections)
+
+    async def test_write_reaches_port(self):
+        self.stream.write(b"\x01\x02hello")
+        await self.stream.drain()
+
+        self.assertEqual(b"\x01\x02hello", await self.pty.read_exactly(7))
+
+    async def test_raw_mode_passes_all_bytes(self):
+        # Сырой режим: ни перевода строк, ни управляющих символов терминала
+        data = bytes(range(256))
+        self.stream.write(data)
+
+        self.assertEqual(data, await self.pty.read_exactly(len(data)))
+
+    async def test_receive_buffers_and_notifies(self):
+        os.write(self.pty.master, b"abcdef")
+        await wait_until(lambda: self.received > 0)
+
+        self.assertEqual(b"abc", self.stream.read(3))
+        self.assertEqual(b"def", self.stream.read_available())
+        self.assertEqual(b"", self.stream.read_available())
+
+    async def test_large_write_does_not_block(self):
+        # Больше буфера псевдотерминала: остаток дописывается по готовности на запись
+        data = bytes(i % 251 for i in range(256 * 1024))
+        self.stream.write(data)
+        self.stream.write(b"tail")
+
+        echoed = await self.pty.read_exactly(len(data) + 4, timeout=5.0)
+        await asyncio.wait_for(self.stream.drain(), 2.0)
+
+        self.assertEqual(data + b"tail", echoed)
+
+    async def test_hangup_disconnects_and_reconnects(self):
+        self.pty.close()
+        await wait_until(lambda: not self.stream.connected)
+
+        with self.assertRaises(ConnectionError):
+            self.stream.write(b"x")
+
+        # Имя нового псевдотерминала выдаёт ядро: порт ищется функцией-перебором кандидатов,
+        # недоступные кандидаты пропускаются
+        await self.stream.close()
+
+        second = Pty()
+        candidates = ["/dev/nonexistent-serial", second.path]
+
+        self.stream = AsyncSerialStream(lambda: candidates, backoff=(0.01, 0.05))
+        self.stream.start()
+        await self.stream.wait_connected(2.0)
+
+        self.assertEqual(second.path, self.stream.port)
+
+        second.close()
+        await wait_until(lambda: not self.stream.connected)
+
+        third = Pty()
+        candidates[1] = third.path
+        await self.stream.wait_connected(2.0)
+
+        self.assertEqual(third.path, self.stream.port)
+        self.assertEqual(2, self.stream.connections)
+
+        self.stream.write(b"again")
+        self.assertEqual(b"again", await third.read_exactly(5))
+        third.close()
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,168 @@
+"""Оценка смещения и дрейфа бортовых часов (clock_sync.ClockSync) на модели часов и канала"""
+
+import random
+import sys
+import unittest
+from pathlib import Path
+from typing import Final
+
+sys.path.insert(0, str(Path(__file__).resolve().parent.parent / "src"))
+
+from clock_sync import ClockSync
+
+
+class SimulatedLink:
+    """
+    Бортовые часы со смещением и дрейфом и канал со случайной задержкой очереди.
+
+    Задержка в каждую сторону - постоянная часть плюс очередь (в 70% обменов, экспоненциальная);
+    постоянная часть одинакова в обе стороны, поэтому обмены без очереди дают смещение точно
+    """
+
+    def __init__(self, offset_us: float, drift_ppm: float, seed: int = 1) -> None:
+        self.offset_us: Final = offset_us
+        self.drift: Final = drift_ppm * 1e-6
+        self._random: Final = random.Random(seed)
+
+        self.base_delay_us: float = 400.0
+        self.processing_us: float = 150.0
+
+        self.forward_queue_us: float = 3000.0
+        """Средняя очередь хост -> робот, мкс"""
+        self.backward_queue_us: float = 3000.0
+        """Средняя очередь робот -> хост, мкс"""
+
+    def robot_us(self, host_us: float) -> int:
+        """Показание бортовых часов в момент host_us по часам хоста"""
+        return int(self.offset_us + host_us * (1.0 + self.drift))
+
+    def _one_way_us(self, mean_queue_us: float) -> float:
+        if mean_queue_us == 0 or self._random.random() >= 0.7:
+            return self.base_delay_us
+
+        return self.base_delay_us + self._random.expovariate(1.0 / mean_queue_us)
+
+    def exchange(self, host_send_us: float) -> tuple[int, int, int, int]:
+        """Метки обмена синхронизации (t0, t1, t2, t3)"""
+        robot_receive = host_send_us + self._one_way_us(self.forward_queue_us)
+        robot_send = robot_receive + self.processing_us
+        host_receive = robot_send + self._one_way_us(self.backward_queue_us)
+
+        return int(host_send_us), self.robot_us(robot_receive), self.robot_us(robot_send), int(host_receive)
+
+
+def synchronize(link: SimulatedLink, sync: ClockSync, count: int, period_us: float, start_us: float = 1e6) -> float:
+    """Провести count обменов с периодом period_us; возвращает время хоста после последнего"""
+    host_us = start_us
+
+    for _ in range(count):
+        sync.add(*link.exchange(host_us))
+        host_us += period_us
+
+    return host_us
+
+
+class ClockSyncTest(unittest.TestCase):
+
+    def test_not_synchronized_initially(self):
+        sync = ClockSync()
+
+        self.assertFalse(sync.synchronized)
+        self.assertIsNone(sync.delay_us)
+        self.assertEqual(0.0, sync.drift_ppm)
+
+    def test_single_exchange_gives_offset(self):
+        sync = ClockSync()
+
+        # Симметричная задержка 1 мс, робот впереди на 5 с
+        sync.add(1_000_000, 6_001_000, 6_001_100, 1_002_100)
+
+        self.assertTrue(sync.synchronized)
+        self.assertEqual(2_000, sync.delay_us)
+        self.assertEqual(1_001_000, sync.to_host_us(6_001_000))
+
+    def test_negative_delay_rejected(self):
+        sync = ClockSync()
+
+        # Робот держал запрос дольше, чем длился обмен по часам хоста: метки несовместны
+        sync.add(1_000_000, 5_000_000, 5_010_000, 1_001_000)
+
+        self.assertFalse(sync.synchronized)
+
+    def test_offset_without_drift(self):
+        for seed in range(8):
+            with self.subTest(seed=seed):
+                link = SimulatedLink(offset_us=-123_456_789, drift_ppm=0, seed=seed)
+                sync = ClockSync()
+
+                # Окно короче секунды: дрейф не оценивается, проверяется только смещение
+                end_us = synchronize(link, sync, count=64, period_us=10_000)
+
+                self.assertEqual(0.0, sync.drift_ppm)
+                self.assertEqual(2 * link.base_delay_us, sync.delay_us)
+
+                # Среди лучших обменов есть и с небольшой очередью: ошибка - доли средней очереди
+                for host_us in (1e6, end_us / 2, end_us):
+                    self.assertAlmostEqual(host_us, sync.to_host_us(link.robot_us(host_us)), delta=300)
+
+    def test_one_way_queueing_does_not_bias_offset(self):
+        # Очередь только к роботу: среднее по всем обменам сместилось бы на треть средней очереди
+        for seed in range(8):
+            with self.subTest(seed=seed):
+                link = SimulatedLink(offset_us=2_000_000, drift_ppm=0, seed=seed)
+                link.forward_queue_us = 20_000
+                link.backward_queue_us = 0
+                sync = ClockSync()
+
+                exchanges = [link.exchange(1e6 + i * 10_000) for i in range(64)]
+                for exchange in exchanges:
+                    sync.add(*exchange)
+
+                naive_offset = sum(((t1 - t0) + (t2 - t3)) / 2 for t0, t1, t2, t3 in exchanges) / len(exchanges)
+                self.assertGreater(naive_offset - link.offset_us, 4_000)
+
+                self.assertAlmostEqual(5e6, sync.to_host_us(link.robot_us(5e6)), delta=200)
+
+    def test_drift_estimated(self):
+        for drift_ppm in (-80.0, 35.0, 120.0):
+            for seed in range(4):
+                with self.subTest(drift_ppm=drift_ppm, seed=seed):
+                    link = SimulatedLink(offset_us=10_000_000, drift_ppm=drift_ppm, seed=seed)
+                    sync = ClockSync()
+
+                    # Окно 64 с: лучшие обмены разнесены больше чем на секунду
+                    end_us = synchronize(link, sync, count=64, period_us=1_000_000)
+
+                    self.assertAlmostEqual(drift_ppm, sync.drift_ppm, delta=5.0)
+
+                    # Перевод верен и через 10 с после последнего обмена
+                    for host_us in (end_us - 30e6, end_us, end_us + 10e6):
+                        self.assertAlmostEqual(host_us, sync.to_host_us(link.robot_us(host_us)), delta=300)
+
+    def test_drift_not_estimated_over_short_window(self):
+        link = SimulatedLink(offset_us=0, drift_ppm=100, seed=5)
+        sync = ClockSync()
+
+        # 64 обмена за 0.64 с: дрейф по такому окну шумнее самого дрейфа
+        synchronize(link, sync, count=64, period_us=10_000)
+
+        self.assertEqual(0.0, sync.drift_ppm)
+
+    def test_many_matches_single(self):
+        link = SimulatedLink(offset_us=3_000_000, drift_ppm=-40, seed=9)
+        sync = ClockSync()
+        synchronize(link, sync, count=64, period_us=1_000_000)
+
+        robot_us = [link.robot_us(h) for h in range(0, 70_000_000, 7_000_000)]
+
+        self.assertEqual([sync.to_host_us(t) for t in robot_us], sync.to_host_us_many(robot_us))
+
+    def test_host_seconds(self):
+        sync = ClockSync()
+        sync.add(1_000_000, 1_000_500, 1_000_500, 1_001_000)
+
+        self.assertAlmostEqual(2.5, sync.to_host_s(2_500_000), places=6)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,123 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <kf/Logger.hpp>
+#include <map>
+#include <sstream>
+#include <string>
+
+#include "zms/Periphery.hpp"
+#include "zms/Service.hpp"
+#include "zms/bench/Benchmarks.hpp"
+#include "zms/hal/Hal.hpp"
+#include "zms/tools/Benchmark.hpp"
+
+/// Замеры горячих путей на хосте (окружение bench): драйверы и сервисы на фейковой плате.
+///
+/// bench [--filter TEXT] [--min-time-ms N] [--csv] [--baseline FILE.csv]
+///
+/// --csv печатает результат в CSV (name,iterations,ns_per_op,cycles_per_op), его же принимает
+/// --baseline: рядом с каждым замером печатается изменение относительно базового прогона.
+/// Те же замеры на плате: сборка esp32dev-bench, инструкция моста run_benchmarks
+
+static auto &periphery = zms::Periphery::instance();
+
+static auto &service = zms::Service::instance();
+
+/// @brief Аргументы командной строки
+struct Options {
+    std::string filter{};
+    kf::u32 min_time_ms{200};
+    bool csv{false};
+    std::string baseline{};
+};
+
+/// @brief Прочитать базовый прогон: имя -> нс/оп
+static std::map<std::string, double> loadBaseline(const std::string &path) {
+    std::map<std::string, double> baseline;
+    std::ifstream in{path};
+    std::string line;
+
+    while (std::getline(in, line)) {
+        std::istringstream row{line};
+        std::string name, iterations, ns;
+
+        if (not std::getline(row, name, ',')) { continue; }
+        if (not std::getline(row, iterations, ',')) { continue; }
+        if (not std::getline(row, ns, ',')) { continue; }
+
+        char *end = nullptr;
+        const auto value = std::strtod(ns.c_str(), &end);
+        if (end != ns.c_str()) { baseline[name] = value; }
+    }
+
+    return baseline;
+}
+
+int main(int argc, char **argv) {
+    Options options{};
+
+    for (int i = 1; i < argc; i += 1) {
+        const std::string arg{argv[i]};
+        const bool has_value = i + 1 < argc;
+
+        if (arg == "--filter" and has_value) {
+            options.filter = argv[++i];
+        } else if (arg == "--min-time-ms" and has_value) {
+            options.min_time_ms = static_cast<kf::u32>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--csv") {
+            options.csv = true;
+        } else if (arg == "--baseline" and has_value) {
+            options.baseline = argv[++i];
+        } else {
+            std::fprintf(stderr, "usage: %s [--filter TEXT] [--min-time-ms N] [--csv] [--baseline FILE.csv]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    // Журнал драйверов не смешивается с таблицей
+    kf_Logger_setWriter([](const kf::slice<const char> &str) {
+        std::fwrite(str.ptr, 1, str.size, stderr);
+        std::fputc('\n', stderr);
+    });
+
+    if (not periphery.init()) {
+        kf_Logger_fatal("Robot init failed!");
+        return 1;
+    }
+
+    service.init();
+
+    const auto baseline = options.baseline.empty() ? std::map<std::string, double>{} : loadBaseline(options.baseline);
+
+    if (options.csv) {
+        std::printf("name,iterations,ns_per_op,cycles_per_op\n");
+    } else {
+        std::printf("%-40s %12s %12s %12s%s\n", "Benchmark", "Time(ns)", "Cycles", "Iterations", baseline.empty() ? "" : "   Change");
+        std::printf("%s\n", std::string(80 + (baseline.empty() ? 0 : 10), '-').c_str());
+    }
+
+    for (kf::u8 i = 0; i < zms::Benchmark::count(); i += 1) {
+        const auto &c = zms::Benchmark::at(i);
+
+        if (not options.filter.empty() and std::strstr(c.name, options.filter.c_str()) == nullptr) { continue; }
+
+        const auto result = zms::Benchmark::run(c, options.min_time_ms * 1000u);
+
+        if (options.csv) {
+            std::printf("%s,%u,%.3f,%.3f\n", c.name, result.iterations, result.nanosecondsPerOp(), result.cyclesPerOp());
+            continue;
+        }
+
+        std::printf("%-40s %12.2f %12.2f %12u", c.name, result.nanosecondsPerOp(), result.cyclesPerOp(), result.iterations);
+
+        if (auto it = baseline.find(c.name); it != baseline.end() and it->second > 0) {
+            std::printf(" %+8.1f%%", (result.nanosecondsPerOp() / it->second - 1.0) * 100.0);
+        }
+
+        std::printf("\n");
+    }
+
+    return 0;
+}
@@ -3,6 +3,12 @@
 
 #include "zms/Periphery.hpp"
 #include "zms/Service.hpp"
+#include "zms/hal/Hal.hpp"
+
+#if defined(ZMS_BENCHMARK)
+// Бортовые замеры: запуск инструкцией моста run_benchmarks
+#include "zms/bench/Benchmarks.hpp"
+#endif
 
 
 static auto &periphery = zms::Periphery::instance();
@@ -10,13 +16,12 @@ static auto &periphery = zms::Periphery::instance();
 static auto &service = zms::Service::instance();
 
 void setup() {
-    Serial.setDebugOutput(false);
-    Serial.setRxBufferSize(1024);
-    Serial.setTxBufferSize(1024);
-    Serial.setTimeout(10);
-    Serial.begin(115200);
+    auto &boot = periphery.boot;
 
-    delay(1000);
+    // Без фиксированных задержек: после сброса посреди заезда робот должен ожить как можно раньше
+    boot.begin(zms::BootStage::Serial);
+    zms::hal::serialBegin(115200);
+    boot.end(zms::BootStage::Serial, true);
 
     kf_Logger_setWriter([](const kf::slice<const char> &str) {
         service.bytelang_bridge.send_log(str);
@@ -27,16 +32,27 @@ void setup() {
     const bool periphery_ok = periphery.init();
 
     if (not periphery_ok) {
+#if defined(ZMS_BOOT_STRICT)
         kf_Logger_fatal("Robot init failed!");
-        delay(5000);
-        ESP.restart();
+        zms::hal::restart();
+#else
+        // Деградированный режим: работает то, что поднялось, отчёт - send_boot_timeline
+        kf_Logger_error("degraded boot: failed stages 0x%04x", boot.failedMask());
+#endif
     }
 
-    service.init();
+    boot.begin(zms::BootStage::Services);
+    boot.end(zms::BootStage::Services, service.init());
+
+    (void) service.bytelang_bridge.send_boot_timeline();
 
-    kf_Logger_debug("init isOk");
+    kf_Logger_info("boot %u us", boot.totalMicros());
 }
 
 void loop() {
+    periphery.poll();
     service.poll();
+
+    // В простое понижает частоту и уступает время или засыпает (настройки power)
+    service.power_manager.idle();
 }
@@ -0,0 +1,43 @@
+#include <cstdio>
+#include <kf/Logger.hpp>
+
+#include "zms/Periphery.hpp"
+#include "zms/Service.hpp"
+#include "zms/hal/Hal.hpp"
+
+/// Точка входа окружения native: та же инициализация, что и на плате,
+/// основной цикл крутится на виртуальном времени фейковой платы
+
+static auto &periphery = zms::Periphery::instance();
+
+static auto &service = zms::Service::instance();
+
+int main() {
+    kf_Logger_setWriter([](const kf::slice<const char> &str) {
+        std::fwrite(str.ptr, 1, str.size, stdout);
+        std::fputc('\n', stdout);
+    });
+
+    kf_Logger_info("START (native)");
+
+    if (not periphery.init()) {
+        kf_Logger_fatal("Robot init failed!");
+        return 1;
+    }
+
+    service.init();
+
+    // 1 с основного цикла с шагом 1 мс
+    for (int i = 0; i < 1000; i += 1) {
+        periphery.poll();
+        service.poll();
+        zms::hal::native::advance(1000);
+    }
+
+    const auto pose = service.odometry.get();
+    std::printf("t=%llu us pose=(%.1f, %.1f, %.3f)\n",
+                static_cast<unsigned long long>(zms::hal::nowMicros()),
+                pose.pose.x, pose.pose.y, pose.pose.heading);
+
+    return 0;
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <kf/aliases.hpp>
+
+
+namespace zms::replay {
+
+/// @brief Захват трафика моста, записанный клиентом (ByteLang-Bridge-Client/src/capture.py).
+///
+/// Формат (little-endian):
+///     заголовок: "ZMSCAP" | u8 версия | u8 резерв | u64 время хоста начала записи (мкс)
+///     запись:    u8 направление | varint задержка от предыдущей записи (мкс) | varint длина | байты
+struct Capture {
+
+    /// @brief Направление записи
+    enum class Direction : kf::u8 {
+        /// @brief Хост -> робот
+        ToRobot = 0x00,
+
+        /// @brief Робот -> хост
+        FromRobot = 0x01,
+    };
+
+    struct Record {
+        Direction direction;
+
+        /// @brief Время от начала записи (мкс)
+        kf::u64 time_us;
+
+        std::vector<kf::u8> data;
+    };
+
+    static constexpr char magic[] = "ZMSCAP";
+    static constexpr kf::u8 version = 1;
+
+    std::vector<Record> records{};
+
+    /// @brief Загрузить захват. Обрезанный хвост (запись прервана) отбрасывается
+    /// @returns false, если файл не открылся или это не захват
+    bool load(const std::string &path) {
+        std::ifstream file{path, std::ios::binary};
+        if (not file) { return false; }
+
+        char header_magic[6];
+        kf::u8 header_version = 0, reserved = 0;
+        kf::u64 start_us = 0;
+
+        file.read(header_magic, sizeof(header_magic));
+        file.read(reinterpret_cast<char *>(&header_version), 1);
+        file.read(reinterpret_cast<char *>(&reserved), 1);
+        file.read(reinterpret_cast<char *>(&start_us), sizeof(start_us));
+
+        if (not file or std::memcmp(header_magic, magic, sizeof(header_magic)) != 0 or header_version != version) {
+            return false;
+        }
+
+        kf::u64 time_us = 0;
+
+        while (true) {
+            const auto direction = file.get();
+            if (direction == std::char_traits<char>::eof()) { break; }
+
+            kf::u64 delay_us = 0, size = 0;
+            if (not readVarint(file, delay_us) or not readVarint(file, size)) { break; }
+
+            Record record{static_cast<Direction>(direction), time_us + delay_us, std::vector<kf::u8>(size)};
+            file.read(reinterpret_cast<char *>(record.data.data()), static_cast<std::streamsize>(size));
+            if (static_cast<kf::u64>(file.gcount()) != size) { break; }
+
+            time_us = record.time_us;
+            records.push_back(std::move(record));
+        }
+
+        return true;
+    }
+
+    /// @brief Длительность записи (мкс)
+    [[nodiscard]] kf::u64 duration() const { return records.empty() ? 0 : records.back().time_us; }
+
+    /// @brief Байт в направлении
+    [[nodiscard]] kf::u64 bytes(Direction direction) const {
+        kf::u64 total = 0;
+        for (const auto &record: records) {
+            if (record.direction == direction) { total += record.data.size(); }
+        }
+        return total;
+    }
+
+private:
+    /// @brief LEB128 без знака
+    static bool readVarint(std::ifstream &file, kf::u64 &value) {
+        value = 0;
+
+        for (kf::u8 shift = 0; shift < 64; shift += 7) {
+            const auto byte = file.get();
+            if (byte == std::char_traits<char>::eof()) { return false; }
+
+            value |= kf::u64(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) { return true; }
+        }
+
+        return false;
+    }
+};
+
+}// namespace zms::replay
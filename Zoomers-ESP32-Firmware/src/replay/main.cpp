@@ -0,0 +1,260 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <kf/Logger.hpp>
+#include <string>
+#include <vector>
+
+#include "replay/Capture.hpp"
+#include "zms/Periphery.hpp"
+#include "zms/Service.hpp"
+#include "zms/hal/Hal.hpp"
+
+/// Воспроизведение захвата трафика моста на прошивке, собранной для хоста.
+///
+/// replay CAPTURE [--speed original|max] [--step-us N] [--tail-ms N] [--trace FILE] [--expect FILE]
+///
+/// original - входящие байты подаются в записанные моменты виртуального времени (как в поле);
+/// max - следующая пачка подаётся, как только приёмник разобрал предыдущую (замер пропускной способности).
+/// Выходы прошивки (записи моторов и манипулятора, ответы моста) пишутся в трассу; --expect сравнивает
+/// трассу с эталонной построчно. Время виртуальное: прогон детерминирован, эталон сравним только
+/// с трассой того же режима и шага
+
+using zms::replay::Capture;
+
+static auto &periphery = zms::Periphery::instance();
+
+static auto &service = zms::Service::instance();
+
+/// @brief Аргументы командной строки
+struct Options {
+    std::string capture{};
+    bool max_speed{false};
+    kf::u32 step_us{1000};
+    kf::u32 tail_ms{1000};
+    std::string trace{};
+    std::string expect{};
+};
+
+/// @brief Пачка входящих байт: записи одной отправки хоста (поля инструкции пишутся по отдельности)
+struct Burst {
+    kf::u64 time_us;
+    std::vector<kf::u8> data;
+};
+
+/// @brief Записи ближе этого интервала сливаются в одну пачку (мкс)
+static constexpr kf::u64 burst_gap_us = 2000;
+
+static std::vector<Burst> collectBursts(const Capture &capture) {
+    std::vector<Burst> bursts;
+    kf::u64 last_us = 0;
+
+    for (const auto &record: capture.records) {
+        if (record.direction != Capture::Direction::ToRobot) { continue; }
+
+        if (bursts.empty() or record.time_us - last_us >= burst_gap_us) {
+            bursts.push_back({record.time_us, {}});
+        }
+
+        bursts.back().data.insert(bursts.back().data.end(), record.data.begin(), record.data.end());
+        last_us = record.time_us;
+    }
+
+    return bursts;
+}
+
+/// @brief Наблюдатель выходов прошивки: пишет строку трассы на каждое изменение
+struct Tracer {
+    std::vector<std::string> lines{};
+
+    zms::Motor::SignedPwm left_pwm{0}, right_pwm{0};
+    kf::Degrees arm{0}, claw{0};
+    kf::u64 reply_bytes{0};
+
+    void observe(kf::u64 time_us) {
+        const auto left = periphery.left_motor.lastPwm();
+        const auto right = periphery.right_motor.lastPwm();
+
+        if (left != left_pwm or right != right_pwm) {
+            left_pwm = left;
+            right_pwm = right;
+            add(time_us, "motor " + std::to_string(left) + " " + std::to_string(right));
+        }
+
+        const auto a = periphery.manipulator.armAngle();
+        const auto c = periphery.manipulator.clawAngle();
+
+        if (a != arm or c != claw) {
+            arm = a;
+            claw = c;
+            add(time_us, "manipulator " + std::to_string(a) + " " + std::to_string(c));
+        }
+
+        auto &tx = zms::hal::native::board().serial.tx;
+
+        if (not tx.empty()) {
+            static constexpr char digits[] = "0123456789abcdef";
+
+            std::string hex{"reply "};
+            for (const auto byte: tx) {
+                hex += digits[byte >> 4];
+                hex += digits[byte & 0x0F];
+            }
+
+            reply_bytes += tx.size();
+            tx.clear();
+            add(time_us, hex);
+        }
+    }
+
+    void add(kf::u64 time_us, const std::string &text) {
+        lines.push_back(std::to_string(time_us) + " " + text);
+    }
+};
+
+/// @brief Сравнить трассу с эталоном
+/// @returns Число различающихся строк (-1 - эталон не открылся)
+static long compareTrace(const std::vector<std::string> &lines, const std::string &path) {
+    std::ifstream file{path};
+    if (not file) { return -1; }
+
+    std::vector<std::string> expected;
+    std::string line;
+    while (std::getline(file, line)) { expected.push_back(line); }
+
+    long mismatches = 0;
+    const auto count = std::max(lines.size(), expected.size());
+
+    for (std::size_t i = 0; i < count; i += 1) {
+        const auto *got = (i < lines.size()) ? &lines[i] : nullptr;
+        const auto *want = (i < expected.size()) ? &expected[i] : nullptr;
+
+        if (got and want and *got == *want) { continue; }
+
+        if (mismatches == 0) {
+            std::fprintf(stderr, "first difference at line %zu:\n  expected: %s\n  actual:   %s\n",
+                         i + 1, want ? want->c_str() : "<end>", got ? got->c_str() : "<end>");
+        }
+
+        mismatches += 1;
+    }
+
+    return mismatches;
+}
+
+int main(int argc, char **argv) {
+    Options options{};
+
+    for (int i = 1; i < argc; i += 1) {
+        const std::string arg = argv[i];
+        const auto next = [&]() -> std::string { return (i + 1 < argc) ? argv[++i] : ""; };
+
+        if (arg == "--speed") {
+            options.max_speed = next() == "max";
+        } else if (arg == "--step-us") {
+            options.step_us = static_cast<kf::u32>(std::strtoul(next().c_str(), nullptr, 10));
+        } else if (arg == "--tail-ms") {
+            options.tail_ms = static_cast<kf::u32>(std::strtoul(next().c_str(), nullptr, 10));
+        } else if (arg == "--trace") {
+            options.trace = next();
+        } else if (arg == "--expect") {
+            options.expect = next();
+        } else if (options.capture.empty() and arg.rfind("--", 0) != 0) {
+            options.capture = arg;
+        } else {
+            std::fprintf(stderr, "unknown option: %s\n", arg.c_str());
+            return 2;
+        }
+    }
+
+    if (options.capture.empty() or options.step_us == 0) {
+        std::fprintf(stderr, "usage: %s CAPTURE [--speed original|max] [--step-us N] [--tail-ms N] [--trace FILE] [--expect FILE]\n", argv[0]);
+        return 2;
+    }
+
+    Capture capture{};
+    if (not capture.load(options.capture)) {
+        std::fprintf(stderr, "%s: not a capture file\n", options.capture.c_str());
+        return 2;
+    }
+
+    const auto bursts = collectBursts(capture);
+
+    // Журнал уходит в мост, как на плате: строки журнала - часть ответов
+    kf_Logger_setWriter([](const kf::slice<const char> &str) {
+        service.bytelang_bridge.send_log(str);
+    });
+
+    if (not periphery.init()) {
+        std::fprintf(stderr, "periphery init failed\n");
+        return 1;
+    }
+
+    service.init();
+
+    auto &board = zms::hal::native::board();
+    Tracer tracer{};
+
+    const auto start_us = zms::hal::nowMicros();
+    const auto wall_start = std::chrono::steady_clock::now();
+    kf::u64 loops = 0;
+
+    const auto loop = [&]() {
+        periphery.poll();
+        service.poll();
+        zms::hal::native::advance(options.step_us);
+        tracer.observe(zms::hal::nowMicros() - start_us);
+        loops += 1;
+    };
+
+    for (const auto &burst: bursts) {
+        if (options.max_speed) {
+            while (not board.serial.rx.empty()) { loop(); }
+        } else {
+            while (zms::hal::nowMicros() - start_us < burst.time_us) { loop(); }
+        }
+
+        board.serial.rx.insert(board.serial.rx.end(), burst.data.begin(), burst.data.end());
+    }
+
+    // Дать отработать последним командам
+    const auto tail_end_us = zms::hal::nowMicros() + kf::u64(options.tail_ms) * 1000u;
+    while (not board.serial.rx.empty() or zms::hal::nowMicros() < tail_end_us) { loop(); }
+
+    const auto wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start).count();
+    const auto virtual_s = double(zms::hal::nowMicros() - start_us) * 1e-6;
+    const auto bytes_in = capture.bytes(Capture::Direction::ToRobot);
+
+    std::printf("records=%zu bursts=%zu bytes_in=%llu replies=%llu captured_replies=%llu loops=%llu\n",
+                capture.records.size(), bursts.size(),
+                static_cast<unsigned long long>(bytes_in),
+                static_cast<unsigned long long>(tracer.reply_bytes),
+                static_cast<unsigned long long>(capture.bytes(Capture::Direction::FromRobot)),
+                static_cast<unsigned long long>(loops));
+
+    std::printf("capture_s=%.3f virtual_s=%.3f wall_s=%.4f x_realtime=%.1f in_bytes_per_s=%.0f\n",
+                double(capture.duration()) * 1e-6, virtual_s, wall_s,
+                (wall_s > 0) ? virtual_s / wall_s : 0.0,
+                (wall_s > 0) ? double(bytes_in) / wall_s : 0.0);
+
+    if (not options.trace.empty()) {
+        std::ofstream out{options.trace};
+        for (const auto &line: tracer.lines) { out << line << '\n'; }
+    }
+
+    if (not options.expect.empty()) {
+        const auto mismatches = compareTrace(tracer.lines, options.expect);
+
+        if (mismatches < 0) {
+            std::fprintf(stderr, "%s: cannot open\n", options.expect.c_str());
+            return 2;
+        }
+
+        std::printf("trace: %zu lines, %ld differ from %s\n", tracer.lines.size(), mismatches, options.expect.c_str());
+        return (mismatches == 0) ? 0 : 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cmath>
+
+#include <kf/aliases.hpp>
+
+
+namespace zms::sim {
+
+/// @brief Модель колеса с мотором постоянного тока.
+/// Скважность ниже порога трогания не создаёт движения (физическая мёртвая зона),
+/// выше - задаёт установившуюся скорость; скорость колеса следует за ней с постоянной времени
+struct WheelModel {
+
+    struct Parameters {
+        /// @brief Скорость колеса без нагрузки при полной скважности (мм/с)
+        kf::f32 no_load_speed_mm_s;
+
+        /// @brief Постоянная времени разгона (с)
+        kf::f32 time_constant_s;
+
+        /// @brief Доля скважности, ниже которой мотор не трогается
+        kf::f32 stiction_duty;
+    };
+
+    Parameters parameters;
+
+    /// @brief Скорость колеса (мм/с)
+    kf::f32 speed_mm_s{0};
+
+    /// @brief Пройденный путь (мм)
+    kf::f64 travel_mm{0};
+
+    /// @brief Шаг модели
+    /// @param duty Скважность со знаком направления [-1; 1]
+    void step(kf::f32 duty, kf::f32 dt_s) {
+        const auto magnitude = std::fabs(duty);
+
+        kf::f32 target = 0.0f;
+        if (magnitude > parameters.stiction_duty) {
+            const auto effective = (magnitude - parameters.stiction_duty) / (1.0f - parameters.stiction_duty);
+            target = std::copysign(effective * parameters.no_load_speed_mm_s, duty);
+        }
+
+        // Точное решение апериодического звена на шаге
+        const auto alpha = 1.0f - std::exp(-dt_s / parameters.time_constant_s);
+        const auto previous = speed_mm_s;
+        speed_mm_s += (target - speed_mm_s) * alpha;
+
+        travel_mm += 0.5 * (previous + speed_mm_s) * dt_s;
+    }
+};
+
+/// @brief Кинематика дифференциального шасси (истинная поза)
+struct DriveModel {
+
+    /// @brief Колея (мм)
+    kf::f32 track_width_mm;
+
+    WheelModel left, right;
+
+    kf::f64 x{0}, y{0}, heading{0};
+
+    void step(kf::f32 left_duty, kf::f32 right_duty, kf::f32 dt_s) {
+        const auto left_before = left.travel_mm;
+        const auto right_before = right.travel_mm;
+
+        left.step(left_duty, dt_s);
+        right.step(right_duty, dt_s);
+
+        const auto dl = left.travel_mm - left_before;
+        const auto dr = right.travel_mm - right_before;
+
+        const auto ds = 0.5 * (dl + dr);
+        const auto dtheta = (dr - dl) / track_width_mm;
+
+        // Интегрирование по средней точке дуги
+        const auto mid = heading + 0.5 * dtheta;
+        x += ds * std::cos(mid);
+        y += ds * std::sin(mid);
+        heading += dtheta;
+    }
+};
+
+/// @brief Модель сервопривода: угол движется к заданному с ограниченной скоростью
+struct ServoModel {
+
+    /// @brief Максимальная скорость поворота (град/с)
+    kf::f32 slew_deg_s;
+
+    kf::f32 angle{0};
+
+    bool powered{false};
+
+    void step(kf::f32 target, bool has_signal, kf::f32 dt_s) {
+        powered = has_signal;
+        if (not has_signal) { return; }
+
+        const auto max_step = slew_deg_s * dt_s;
+        const auto error = target - angle;
+        angle += (std::fabs(error) <= max_step) ? error : std::copysign(max_step, error);
+    }
+};
+
+}// namespace zms::sim
@@ -0,0 +1,258 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include "sim/DriveModel.hpp"
+#include "sim/World.hpp"
+#include "zms/Periphery.hpp"
+#include "zms/hal/Hal.hpp"
+
+
+namespace zms::sim {
+
+/// @brief Симулятор робота поверх фейковой платы (zms/hal/Native.hpp).
+/// На каждом шаге читает выходы прошивки (LEDC, пины, RMT), интегрирует физику
+/// и возвращает входы: фронты энкодеров через прерывания, значения АЦП датчиков.
+/// Время виртуальное: скорость ограничена только процессором
+struct Simulator {
+
+    /// @brief Физические параметры (не настройки прошивки)
+    struct Parameters {
+        /// @brief Модель колеса (одинакова для обоих)
+        WheelModel::Parameters wheel;
+
+        /// @brief Истинная колея (мм)
+        kf::f32 track_width_mm;
+
+        /// @brief Истинное разрешение энкодеров (отсчётов на мм)
+        kf::f32 ticks_per_mm;
+
+        /// @brief Вынос датчиков расстояния вперёд от оси колёс (мм)
+        kf::f32 sensor_forward_mm;
+
+        /// @brief Вынос датчиков в стороны от продольной оси (мм)
+        kf::f32 sensor_side_mm;
+
+        /// @brief Дальность датчика (мм)
+        kf::f32 sensor_range_mm;
+
+        /// @brief СКО шума датчика (мм)
+        kf::f32 sensor_noise_mm;
+
+        /// @brief Скорость поворота сервоприводов (град/с)
+        kf::f32 servo_slew_deg_s;
+
+        /// @brief Шаг физики (мкс)
+        kf::u32 step_us;
+
+        /// @brief Зерно генератора шума
+        kf::u32 seed;
+    };
+
+    /// @brief Параметры по умолчанию: соответствуют настройкам прошивки по умолчанию
+    static Parameters defaultParameters() {
+        const auto &settings = Periphery::defaultSettings();
+
+        return {
+            .wheel = {
+                .no_load_speed_mm_s = 600.0f,
+                .time_constant_s = 0.08f,
+                .stiction_duty = kf::f32(settings.motor_pwm.dead_zone) / kf::f32(settings.motor_pwm.maxPwm()),
+            },
+            .track_width_mm = settings.odometry.track_width_mm,
+            .ticks_per_mm = settings.encoder_conversion.ticks_in_one_mm,
+            .sensor_forward_mm = 80.0f,
+            .sensor_side_mm = 40.0f,
+            .sensor_range_mm = 800.0f,
+            .sensor_noise_mm = 0.0f,
+            .servo_slew_deg_s = 300.0f,
+            .step_us = 1000,
+            .seed = 1,
+        };
+    }
+
+    const World &world;
+
+    const Parameters parameters;
+
+    DriveModel drive;
+
+    ServoModel arm, claw;
+
+private:
+    /// @brief Подключение платы (физическое, по настройкам по умолчанию)
+    const Periphery::Settings &wiring{Periphery::defaultSettings()};
+
+    /// @brief Выдано отсчётов энкодеров
+    kf::i64 left_ticks{0}, right_ticks{0};
+
+    std::mt19937 random;
+
+public:
+    explicit Simulator(const World &world, const Parameters &parameters) :
+        world{world},
+        parameters{parameters},
+        drive{parameters.track_width_mm, {parameters.wheel}, {parameters.wheel}},
+        arm{parameters.servo_slew_deg_s},
+        claw{parameters.servo_slew_deg_s},
+        random{parameters.seed} {
+        updateSensors();
+    }
+
+    /// @brief Установить истинную позу (мм, мм, рад)
+    void place(kf::f32 x, kf::f32 y, kf::f32 heading) {
+        drive.x = x;
+        drive.y = y;
+        drive.heading = heading;
+        updateSensors();
+    }
+
+    /// @brief Шаг физики; виртуальное время платы продвигается на step_us (срабатывают таймеры сервисов)
+    void step() {
+        const auto dt_s = kf::f32(parameters.step_us) * 1e-6f;
+
+        auto &periphery = Periphery::instance();
+        drive.step(
+            motorDuty(wiring.left_motor, periphery.left_motor.driverSettings().impl),
+            motorDuty(wiring.right_motor, periphery.right_motor.driverSettings().impl),
+            dt_s);
+
+        emitTicks(drive.left.travel_mm, left_ticks, wiring.left_encoder);
+        emitTicks(drive.right.travel_mm, right_ticks, wiring.right_encoder);
+
+        updateSensors();
+        updateServos(dt_s);
+
+        hal::native::advance(parameters.step_us);
+    }
+
+    /// @brief Истинное расстояние от датчика до препятствия (мм)
+    [[nodiscard]] kf::f32 sensorDistance(bool left) const {
+        const auto side = left ? parameters.sensor_side_mm : -parameters.sensor_side_mm;
+        const auto c = std::cos(drive.heading);
+        const auto s = std::sin(drive.heading);
+
+        const auto x = drive.x + parameters.sensor_forward_mm * c - side * s;
+        const auto y = drive.y + parameters.sensor_forward_mm * s + side * c;
+
+        return world.raycast(kf::f32(x), kf::f32(y), kf::f32(drive.heading), parameters.sensor_range_mm);
+    }
+
+private:
+    /// @brief Скважность мотора со знаком "вперёд" по состоянию выходов платы.
+    /// Схема моста следует реализации, выбранной в прошивке (пины - по умолчанию): бэкенды сравнимы в одном сценарии
+    [[nodiscard]] static kf::f32 motorDuty(const Motor::DriverSettings &motor, Motor::DriverImpl impl) {
+        const auto &board = hal::native::board();
+
+        // Мотор подключён так, что при настройках по умолчанию положительная команда - вперёд
+        const bool forward_level = motor.direction == Motor::Direction::CW;
+
+        switch (impl) {
+            case Motor::DriverImpl::IArduino: {
+                const auto &channel = board.ledc[motor.ledc_channel];
+                if (board.pin_ledc[motor.pin_b] != motor.ledc_channel or channel.resolution_bits == 0) { return 0.0f; }
+
+                const auto duty = kf::f32(channel.duty) / kf::f32((1u << channel.resolution_bits) - 1u);
+                return (board.pin_level[motor.pin_a] == forward_level) ? duty : -duty;
+            }
+
+            case Motor::DriverImpl::L298nModule: {
+                const auto max = kf::f32((1u << board.analog_out_resolution_bits) - 1u);
+                const auto a = kf::f32(board.analog_out[motor.pin_a]) / max;
+                const auto b = kf::f32(board.analog_out[motor.pin_b]) / max;
+                return forward_level ? (b - a) : (a - b);
+            }
+
+            case Motor::DriverImpl::Mcpwm: {
+                const auto &op = board.mcpwm[motor.ledc_channel].active;
+                const auto a = meanLevel(op.a, op.duty, op.max);
+                const auto b = meanLevel(op.b, op.duty, op.max);
+                return forward_level ? (b - a) : (a - b);
+            }
+        }
+
+        return 0.0f;
+    }
+
+    /// @brief Средний уровень выхода MCPWM за период (0 .. 1)
+    [[nodiscard]] static kf::f32 meanLevel(hal::McpwmLevel level, kf::u32 duty, kf::u32 max) {
+        const auto d = max == 0 ? 0.0f : kf::f32(duty) / kf::f32(max);
+
+        switch (level) {
+            case hal::McpwmLevel::Low: return 0.0f;
+            case hal::McpwmLevel::High: return 1.0f;
+            case hal::McpwmLevel::Pwm: return d;
+            case hal::McpwmLevel::PwmInverted: return 1.0f - d;
+        }
+
+        return 0.0f;
+    }
+
+    /// @brief Выдать фронты энкодера до текущего положения колеса
+    void emitTicks(kf::f64 travel_mm, kf::i64 &emitted, const Encoder::PinsSettings &pins) const {
+        const auto target = static_cast<kf::i64>(std::floor(travel_mm * parameters.ticks_per_mm));
+
+        while (emitted != target) {
+            const bool forward = target > emitted;
+
+            // Вторичная фаза задаёт направление, полный период основной фазы - ровно один фронт каждого вида
+            hal::native::setPin(pins.phase_b, forward);
+            hal::native::setPin(pins.phase_a, true);
+            hal::native::setPin(pins.phase_a, false);
+
+            emitted += forward ? 1 : -1;
+        }
+    }
+
+    /// @brief Значения АЦП по расстоянию: обратная модель Sharp::distanceFromSum
+    void updateSensors() {
+        setSensor(wiring.left_distance_sensor, sensorDistance(true));
+        setSensor(wiring.right_distance_sensor, sensorDistance(false));
+    }
+
+    void setSensor(const Sharp::Settings &sensor, kf::f32 distance_mm) {
+        if (parameters.sensor_noise_mm > 0.0f) {
+            distance_mm += std::normal_distribution<kf::f32>{0.0f, parameters.sensor_noise_mm}(random);
+        }
+
+        const auto max_value = kf::f32(sensor.maxValue());
+        const auto raw = 65535.0f / std::max(distance_mm, 1.0f);
+        hal::native::setAdc(sensor.pin, static_cast<kf::u16>(std::clamp(raw, 1.0f, max_value)));
+    }
+
+    void updateServos(kf::f32 dt_s) {
+        const auto &manipulator = Periphery::instance().storage.settings.manipulator;
+        const auto &board = hal::native::board();
+
+        const auto period_us = 1e6f / kf::f32(manipulator.servo_pwm.ledc_frequency_hz);
+
+        const auto pulse = [&](const PwmPositionServo::DriverSettings &axis, kf::u8 rmt_channel) -> kf::f32 {
+            if (manipulator.backend == Manipulator2DOF::Backend::Rmt) {
+                const auto &channel = board.rmt[rmt_channel];
+                return channel.running ? kf::f32(channel.high_ticks) : 0.0f;
+            }
+
+            const auto &channel = board.ledc[axis.ledc_channel];
+            if (channel.resolution_bits == 0) { return 0.0f; }
+            return kf::f32(channel.duty) / kf::f32((1u << channel.resolution_bits) - 1u) * period_us;
+        };
+
+        const auto angle = [&](kf::f32 pulse_us) {
+            const auto &p = manipulator.servo_generic_pulse_settings;
+            return kf::f32(p.min_position.angle) +
+                   (pulse_us - kf::f32(p.min_position.pulse)) *
+                       kf::f32(p.max_position.angle - p.min_position.angle) /
+                       kf::f32(p.max_position.pulse - p.min_position.pulse);
+        };
+
+        const auto arm_pulse = pulse(manipulator.arm_axis, manipulator.rmt.arm_channel);
+        const auto claw_pulse = pulse(manipulator.claw_axis, manipulator.rmt.claw_channel);
+
+        arm.step(angle(arm_pulse), arm_pulse > 0.0f, dt_s);
+        claw.step(angle(claw_pulse), claw_pulse > 0.0f, dt_s);
+    }
+};
+
+}// namespace zms::sim
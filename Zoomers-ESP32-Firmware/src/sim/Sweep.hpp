@@ -0,0 +1,76 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+
+namespace zms::sim {
+
+/// @brief Параллельный прогон независимых заданий.
+/// Периферия прошивки - синглтон процесса, поэтому каждое задание исполняется в своём
+/// дочернем процессе (fork); одновременно работает не больше workers процессов, по одному на ядро
+struct Sweep {
+
+    /// @brief Задание: возвращает строку результата
+    using Job = std::function<std::string()>;
+
+    /// @returns Результаты в порядке заданий (пустая строка - процесс завершился с ошибкой)
+    static std::vector<std::string> run(const std::vector<Job> &jobs, unsigned workers) {
+        struct Running {
+            pid_t pid;
+            int fd;
+            std::size_t index;
+        };
+
+        std::vector<std::string> results(jobs.size());
+        std::vector<Running> running;
+        std::size_t next = 0;
+
+        if (workers == 0) { workers = 1; }
+
+        while (next < jobs.size() or not running.empty()) {
+            while (next < jobs.size() and running.size() < workers) {
+                int pipe_fds[2];
+                if (pipe(pipe_fds) != 0) { return results; }
+
+                const auto pid = fork();
+
+                if (pid == 0) {
+                    close(pipe_fds[0]);
+                    const auto result = jobs[next]();
+                    (void) !write(pipe_fds[1], result.data(), result.size());
+                    close(pipe_fds[1]);
+                    _exit(0);
+                }
+
+                close(pipe_fds[1]);
+                running.push_back({pid, pipe_fds[0], next});
+                next += 1;
+            }
+
+            // Дождаться первого запущенного и забрать его вывод
+            const auto done = running.front();
+            running.erase(running.begin());
+
+            std::string output;
+            char buffer[512];
+            ssize_t n;
+            while ((n = read(done.fd, buffer, sizeof(buffer))) > 0) { output.append(buffer, std::size_t(n)); }
+
+            close(done.fd);
+
+            int status = 0;
+            waitpid(done.pid, &status, 0);
+
+            results[done.index] = (WIFEXITED(status) and WEXITSTATUS(status) == 0) ? output : std::string{};
+        }
+
+        return results;
+    }
+};
+
+}// namespace zms::sim
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <kf/aliases.hpp>
+
+
+namespace zms::sim {
+
+/// @brief Двумерная карта из отрезков-стен (мм)
+struct World {
+
+    struct Wall {
+        kf::f32 x0, y0, x1, y1;
+    };
+
+    std::vector<Wall> walls{};
+
+    /// @brief Квадратная арена с центром в начале координат
+    static World arena(kf::f32 size_mm) {
+        const auto h = size_mm * 0.5f;
+        return World{{
+            {-h, -h, +h, -h},
+            {+h, -h, +h, +h},
+            {+h, +h, -h, +h},
+            {-h, +h, -h, -h},
+        }};
+    }
+
+    /// @brief Загрузить карту: по строке "x0 y0 x1 y1" на стену, '#' - комментарий
+    /// @returns false, если файл не открылся
+    bool load(const std::string &path) {
+        std::ifstream file{path};
+        if (not file) { return false; }
+
+        std::string line;
+        while (std::getline(file, line)) {
+            if (line.empty() or line[0] == '#') { continue; }
+
+            Wall wall{};
+            std::istringstream in{line};
+            if (in >> wall.x0 >> wall.y0 >> wall.x1 >> wall.y1) { walls.push_back(wall); }
+        }
+
+        return true;
+    }
+
+    /// @brief Расстояние по лучу до ближайшей стены
+    /// @returns max_range_mm, если пересечения нет
+    [[nodiscard]] kf::f32 raycast(kf::f32 x, kf::f32 y, kf::f32 heading, kf::f32 max_range_mm) const {
+        const auto dx = std::cos(heading);
+        const auto dy = std::sin(heading);
+
+        auto nearest = max_range_mm;
+
+        for (const auto &wall: walls) {
+            const auto ex = wall.x1 - wall.x0;
+            const auto ey = wall.y1 - wall.y0;
+
+            const auto denominator = dx * ey - dy * ex;
+            if (std::fabs(denominator) < 1e-9f) { continue; }
+
+            const auto wx = wall.x0 - x;
+            const auto wy = wall.y0 - y;
+
+            // Параметр вдоль луча и вдоль стены
+            const auto t = (wx * ey - wy * ex) / denominator;
+            const auto u = (wx * dy - wy * dx) / denominator;
+
+            if (t >= 0.0f and u >= 0.0f and u <= 1.0f and t < nearest) { nearest = t; }
+        }
+
+        return nearest;
+    }
+};
+
+}// namespace zms::sim
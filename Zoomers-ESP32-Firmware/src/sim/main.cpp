@@ -0,0 +1,300 @@
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "sim/Simulator.hpp"
+#include "sim/Sweep.hpp"
+#include "sim/World.hpp"
+#include "zms/Periphery.hpp"
+#include "zms/services/ManipulatorTrajectoryExecutor.hpp"
+#include "zms/services/MotionExecutor.hpp"
+#include "zms/services/ObstacleReflex.hpp"
+#include "zms/services/Odometry.hpp"
+#include "zms/services/PathFollower.hpp"
+
+/// Симулятор робота: прошивка (драйверы и сервисы) на фейковой плате + физика шасси.
+///
+/// sim [--scenario drive|turn|square|wall|manipulator] [--value N] [--duration S] [--map FILE]
+///     [--jobs N] [--set name=value]... [--sweep name=v1,v2,...]...
+///
+/// Несколько --sweep перемножаются; каждая комбинация - отдельный процесс, до --jobs одновременно.
+/// Имена параметров: поля Periphery::Settings (motion.position_gain, motor_pwm.dead_zone, ...)
+/// и физики с префиксом sim. (sim.wheel.stiction_duty, sim.track_width_mm, ...)
+
+using zms::Periphery;
+using zms::sim::Simulator;
+
+/// Поле настроек прошивки, доступное для --set / --sweep
+#define zms_sim_setting(path) {#path, [](Periphery::Settings &s, double v) { s.path = static_cast<decltype(s.path)>(v); }}
+
+/// Поле-перечисление настроек прошивки (значение - код)
+#define zms_sim_enum_setting(path) {#path, [](Periphery::Settings &s, double v) { s.path = static_cast<decltype(s.path)>(static_cast<int>(v)); }}
+
+/// Физический параметр симулятора, доступный для --set / --sweep
+#define zms_sim_parameter(path) {"sim." #path, [](Simulator::Parameters &p, double v) { p.path = static_cast<decltype(p.path)>(v); }}
+
+static const std::map<std::string, void (*)(Periphery::Settings &, double)> settings_fields{
+    zms_sim_setting(motor_pwm.dead_zone),
+    zms_sim_setting(motor_pwm.ledc_frequency_hz),
+    zms_sim_enum_setting(motor_pwm.stop_mode),
+    zms_sim_enum_setting(left_motor.impl),
+    zms_sim_enum_setting(right_motor.impl),
+    zms_sim_setting(encoder_conversion.ticks_in_one_mm),
+    zms_sim_setting(obstacle_reflex.stop_distance_mm),
+    zms_sim_setting(obstacle_reflex.slow_distance_mm),
+    zms_sim_setting(odometry.track_width_mm),
+    zms_sim_setting(motion.position_gain),
+    zms_sim_setting(motion.velocity_feedforward),
+    zms_sim_setting(motion.tolerance_mm),
+    zms_sim_setting(motion.settle_timeout_ms),
+    zms_sim_setting(path_follower.lookahead_mm),
+    zms_sim_setting(path_follower.cruise_speed_mm_s),
+    zms_sim_setting(path_follower.deceleration_mm_s2),
+    zms_sim_setting(path_follower.goal_tolerance_mm),
+};
+
+static const std::map<std::string, void (*)(Simulator::Parameters &, double)> parameter_fields{
+    zms_sim_parameter(wheel.no_load_speed_mm_s),
+    zms_sim_parameter(wheel.time_constant_s),
+    zms_sim_parameter(wheel.stiction_duty),
+    zms_sim_parameter(track_width_mm),
+    zms_sim_parameter(ticks_per_mm),
+    zms_sim_parameter(sensor_noise_mm),
+    zms_sim_parameter(servo_slew_deg_s),
+    zms_sim_parameter(step_us),
+    zms_sim_parameter(seed),
+};
+
+#undef zms_sim_setting
+#undef zms_sim_enum_setting
+#undef zms_sim_parameter
+
+/// Набор переопределений одного прогона
+using Overrides = std::vector<std::pair<std::string, double>>;
+
+struct Options {
+    std::string scenario{"drive"};
+    double value{NAN};
+    double duration_s{10.0};
+    std::string map{};
+    unsigned jobs{std::max(1u, std::thread::hardware_concurrency())};
+    Overrides fixed{};
+    std::vector<std::pair<std::string, std::vector<double>>> sweeps{};
+};
+
+static std::string describe(const Overrides &overrides) {
+    std::ostringstream out;
+    for (const auto &[name, value]: overrides) { out << name << '=' << value << ' '; }
+    return out.str();
+}
+
+/// Прогон одного сценария (в дочернем процессе)
+static std::string runScenario(const Options &options, const Overrides &overrides) {
+    auto &periphery = Periphery::instance();
+
+    auto parameters = Simulator::defaultParameters();
+    for (const auto &[name, value]: overrides) {
+        if (auto it = parameter_fields.find(name); it != parameter_fields.end()) { it->second(parameters, value); }
+    }
+
+    if (not periphery.init()) { return "status=init_failed"; }
+
+    // Настройки меняются "на лету", как из интерфейса: драйверы подхватывают их в poll()
+    for (const auto &[name, value]: overrides) {
+        if (auto it = settings_fields.find(name); it != settings_fields.end()) { it->second(periphery.storage.settings, value); }
+    }
+
+    if (not periphery.storage.settings.isValid()) { return "status=invalid_settings"; }
+    periphery.poll();
+
+    zms::sim::World world = zms::sim::World::arena(2000.0f);
+    if (not options.map.empty()) {
+        world = {};
+        if (not world.load(options.map)) { return "status=map_not_found"; }
+    }
+
+    Simulator sim{world, parameters};
+    sim.place(-600.0f, 0.0f, 0.0f);
+
+    zms::Odometry odometry{};
+    zms::ObstacleReflex reflex{};
+    zms::MotionExecutor motion{reflex};
+    zms::PathFollower path{odometry, reflex};
+    zms::ManipulatorTrajectoryExecutor manipulator{};
+
+    if (not(odometry.init() and reflex.init() and motion.init() and path.init() and manipulator.init())) {
+        return "status=service_init_failed";
+    }
+
+    const auto start_x = sim.drive.x;
+    const auto start_y = sim.drive.y;
+    const auto start_heading = sim.drive.heading;
+    const auto start_us = zms::hal::nowMicros();
+
+    const auto &scenario = options.scenario;
+    const auto value = [&](double fallback) { return std::isnan(options.value) ? fallback : options.value; };
+
+    if (scenario == "drive" or scenario == "wall") {
+        const auto distance = value((scenario == "wall") ? 3000.0 : 500.0);
+        motion.push({1, zms::MotionPrimitive::Kind::Drive, static_cast<kf::i16>(distance), 300, 600}, zms::MotionExecutor::Mode::Replace);
+    } else if (scenario == "turn") {
+        motion.push({1, zms::MotionPrimitive::Kind::Turn, static_cast<kf::i16>(value(90.0)), 180, 360}, zms::MotionExecutor::Mode::Replace);
+    } else if (scenario == "square") {
+        const auto side = kf::f32(value(600.0));
+        path.begin();
+        for (const auto &point: {zms::PurePursuit::Point{side, 0}, {side, side}, {0, side}, {0, 0}}) { (void) path.append(point); }
+    } else if (scenario == "manipulator") {
+        (void) manipulator.push({kf::u8(value(150.0)), 30, 90, 180});
+    } else {
+        return "status=unknown_scenario";
+    }
+
+    const auto wall_start = std::chrono::steady_clock::now();
+    const auto deadline_us = start_us + kf::u64(options.duration_s * 1e6);
+
+    std::string status = "timeout";
+    kf::f32 min_gap_mm = parameters.sensor_range_mm;
+    kf::i32 max_cross_track_mm = 0;
+
+    while (zms::hal::nowMicros() < deadline_us) {
+        sim.step();
+        periphery.poll();
+
+        min_gap_mm = std::min({min_gap_mm, sim.sensorDistance(true), sim.sensorDistance(false)});
+
+        zms::MotionExecutor::Event event{};
+        while (motion.popEvent(event)) {
+            if (event.kind == zms::MotionExecutor::EventKind::Completed) { status = "completed"; }
+            if (event.kind == zms::MotionExecutor::EventKind::Timeout) { status = "settle_timeout"; }
+            if (event.kind == zms::MotionExecutor::EventKind::Rejected) { status = "rejected"; }
+        }
+
+        if (path.stateChanged() or path.busy()) {
+            const auto progress = path.takeProgress();
+            max_cross_track_mm = std::max<kf::i32>(max_cross_track_mm, std::abs(progress.cross_track_error_mm));
+            if (progress.state == zms::PathFollower::State::Completed) { status = "completed"; }
+        }
+
+        // Рефлекс остановил робота перед препятствием: движение завершено не регулятором
+        if (reflex.currentLevel() != zms::ForwardLimiter::Level::Pass and std::fabs(sim.drive.left.speed_mm_s) < 1.0f and std::fabs(sim.drive.right.speed_mm_s) < 1.0f) {
+            status = "reflex_stop";
+        }
+
+        // Допуск - шаг скважности LEDC на 50 Гц (~20 мкс, ~2 градуса)
+        if (scenario == "manipulator" and not manipulator.busy() and std::fabs(sim.arm.angle - kf::f32(value(150.0))) < 2.0f) {
+            status = "completed";
+        }
+
+        if (status != "timeout") { break; }
+    }
+
+    const auto wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start).count();
+    const auto virtual_s = kf::f64(zms::hal::nowMicros() - start_us) * 1e-6;
+
+    const auto pose = odometry.get().pose;
+    const auto dx = sim.drive.x - start_x;
+    const auto dy = sim.drive.y - start_y;
+
+    std::ostringstream out;
+    out.precision(4);
+    out << "status=" << status
+        << " t_s=" << virtual_s
+        << " travel_mm=" << std::hypot(dx, dy)
+        << " heading_deg=" << (sim.drive.heading - start_heading) * 180.0 / M_PI
+        << " odom_err_mm=" << std::hypot(pose.x - dx, pose.y - dy)
+        << " min_gap_mm=" << min_gap_mm
+        << " max_cte_mm=" << max_cross_track_mm
+        << " arm_deg=" << sim.arm.angle
+        << " x_realtime=" << ((wall_s > 0) ? virtual_s / wall_s : 0.0);
+    return out.str();
+}
+
+static std::vector<double> parseList(const std::string &text) {
+    std::vector<double> values;
+    std::istringstream in{text};
+    std::string item;
+    while (std::getline(in, item, ',')) { values.push_back(std::strtod(item.c_str(), nullptr)); }
+    return values;
+}
+
+static bool known(const std::string &name) {
+    return settings_fields.count(name) != 0 or parameter_fields.count(name) != 0;
+}
+
+int main(int argc, char **argv) {
+    Options options{};
+
+    for (int i = 1; i < argc; i += 1) {
+        const std::string arg = argv[i];
+        const auto next = [&]() -> std::string { return (i + 1 < argc) ? argv[++i] : ""; };
+
+        if (arg == "--scenario") {
+            options.scenario = next();
+        } else if (arg == "--value") {
+            options.value = std::strtod(next().c_str(), nullptr);
+        } else if (arg == "--duration") {
+            options.duration_s = std::strtod(next().c_str(), nullptr);
+        } else if (arg == "--map") {
+            options.map = next();
+        } else if (arg == "--jobs") {
+            options.jobs = unsigned(std::strtoul(next().c_str(), nullptr, 10));
+        } else if (arg == "--set" or arg == "--sweep") {
+            const auto assignment = next();
+            const auto eq = assignment.find('=');
+            const auto name = assignment.substr(0, eq);
+
+            if (eq == std::string::npos or not known(name)) {
+                std::fprintf(stderr, "unknown parameter: %s\n", assignment.c_str());
+                return 2;
+            }
+
+            const auto values = parseList(assignment.substr(eq + 1));
+            if (arg == "--set") {
+                options.fixed.emplace_back(name, values.front());
+            } else {
+                options.sweeps.emplace_back(name, values);
+            }
+        } else {
+            std::fprintf(stderr, "unknown option: %s\n", arg.c_str());
+            return 2;
+        }
+    }
+
+    // Декартово произведение всех --sweep
+    std::vector<Overrides> combinations{options.fixed};
+    for (const auto &[name, values]: options.sweeps) {
+        std::vector<Overrides> expanded;
+        for (const auto &base: combinations) {
+            for (const auto v: values) {
+                auto o = base;
+                o.emplace_back(name, v);
+                expanded.push_back(o);
+            }
+        }
+        combinations = expanded;
+    }
+
+    std::vector<zms::sim::Sweep::Job> jobs;
+    for (const auto &overrides: combinations) {
+        jobs.emplace_back([&options, overrides]() { return runScenario(options, overrides); });
+    }
+
+    const auto started = std::chrono::steady_clock::now();
+    const auto results = zms::sim::Sweep::run(jobs, options.jobs);
+    const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+    for (std::size_t i = 0; i < results.size(); i += 1) {
+        std::printf("%s| %s\n", describe(combinations[i]).c_str(), results[i].empty() ? "status=crashed" : results[i].c_str());
+    }
+
+    std::fprintf(stderr, "%zu runs on %u workers in %.2f s\n", results.size(), options.jobs, elapsed);
+    return 0;
+}
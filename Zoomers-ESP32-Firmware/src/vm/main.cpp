@@ -0,0 +1,233 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "sim/Simulator.hpp"
+#include "sim/World.hpp"
+#include "zms/Periphery.hpp"
+#include "zms/services/BehaviourExecutor.hpp"
+#include "zms/services/ManipulatorTrajectoryExecutor.hpp"
+#include "zms/services/ObstacleReflex.hpp"
+#include "zms/services/Odometry.hpp"
+
+/// Прогон поведения (байткод BehaviourVm) на прошивке для хоста в симуляторе.
+///
+/// vm PROGRAM [--duration S] [--start X] [--map FILE] [--trace FILE] [--expect FILE]
+///
+/// PROGRAM - байткод от ассемблера клиента (python behaviour.py prog.zbs -o prog.zbc).
+/// Робот стоит в X мм от центра арены 2 м (по умолчанию -600) лицом к стене +X.
+/// Трасса - смена состояния поведения, report, команды моторов и манипулятора (мс виртуального времени);
+/// --expect сравнивает трассу с эталоном построчно, код возврата 1 при расхождении
+
+using zms::BehaviourVm;
+using zms::Periphery;
+using zms::sim::Simulator;
+
+/// @brief Аргументы командной строки
+struct Options {
+    std::string program{};
+    double duration_s{10.0};
+    kf::f32 start_x{-600.0f};
+    std::string map{};
+    std::string trace{};
+    std::string expect{};
+};
+
+static const char *stateName(BehaviourVm::State state) {
+    switch (state) {
+        case BehaviourVm::State::Empty: return "empty";
+        case BehaviourVm::State::Ready: return "ready";
+        case BehaviourVm::State::Running: return "running";
+        case BehaviourVm::State::Halted: return "halted";
+        case BehaviourVm::State::Faulted: return "faulted";
+        case BehaviourVm::State::Cancelled: return "cancelled";
+    }
+
+    return "?";
+}
+
+/// @brief Сравнить трассу с эталоном
+/// @returns Число различающихся строк (-1 - эталон не открылся)
+static long compareTrace(const std::vector<std::string> &lines, const std::string &path) {
+    std::ifstream file{path};
+    if (not file) { return -1; }
+
+    std::vector<std::string> expected;
+    std::string line;
+    while (std::getline(file, line)) { expected.push_back(line); }
+
+    long mismatches = 0;
+    const auto count = std::max(lines.size(), expected.size());
+
+    for (std::size_t i = 0; i < count; i += 1) {
+        const auto *got = (i < lines.size()) ? &lines[i] : nullptr;
+        const auto *want = (i < expected.size()) ? &expected[i] : nullptr;
+
+        if (got and want and *got == *want) { continue; }
+
+        if (mismatches == 0) {
+            std::fprintf(stderr, "first difference at line %zu:\n  expected: %s\n  actual:   %s\n",
+                         i + 1, want ? want->c_str() : "<end>", got ? got->c_str() : "<end>");
+        }
+
+        mismatches += 1;
+    }
+
+    return mismatches;
+}
+
+int main(int argc, char **argv) {
+    Options options{};
+
+    for (int i = 1; i < argc; i += 1) {
+        const std::string arg = argv[i];
+        const auto next = [&]() -> std::string { return (i + 1 < argc) ? argv[++i] : ""; };
+
+        if (arg == "--duration") {
+            options.duration_s = std::strtod(next().c_str(), nullptr);
+        } else if (arg == "--start") {
+            options.start_x = std::strtof(next().c_str(), nullptr);
+        } else if (arg == "--map") {
+            options.map = next();
+        } else if (arg == "--trace") {
+            options.trace = next();
+        } else if (arg == "--expect") {
+            options.expect = next();
+        } else if (options.program.empty() and arg.rfind("--", 0) != 0) {
+            options.program = arg;
+        } else {
+            std::fprintf(stderr, "unknown option: %s\n", arg.c_str());
+            return 2;
+        }
+    }
+
+    if (options.program.empty()) {
+        std::fprintf(stderr, "usage: %s PROGRAM [--duration S] [--start X] [--map FILE] [--trace FILE] [--expect FILE]\n", argv[0]);
+        return 2;
+    }
+
+    std::ifstream file{options.program, std::ios::binary};
+    if (not file) {
+        std::fprintf(stderr, "%s: cannot open\n", options.program.c_str());
+        return 2;
+    }
+
+    const std::vector<kf::u8> code{std::istreambuf_iterator<char>{file}, {}};
+
+    auto &periphery = Periphery::instance();
+    if (not periphery.init()) {
+        std::fprintf(stderr, "periphery init failed\n");
+        return 1;
+    }
+
+    zms::sim::World world = zms::sim::World::arena(2000.0f);
+    if (not options.map.empty()) {
+        world = {};
+        if (not world.load(options.map)) {
+            std::fprintf(stderr, "%s: map not found\n", options.map.c_str());
+            return 2;
+        }
+    }
+
+    Simulator sim{world, Simulator::defaultParameters()};
+    sim.place(options.start_x, 0.0f, 0.0f);
+
+    zms::Odometry odometry{};
+    zms::ObstacleReflex reflex{};
+    zms::ManipulatorTrajectoryExecutor manipulator{};
+    zms::BehaviourExecutor behaviour{reflex, odometry, manipulator};
+
+    if (not(odometry.init() and reflex.init() and manipulator.init() and behaviour.init())) {
+        std::fprintf(stderr, "service init failed\n");
+        return 1;
+    }
+
+    // Фрагментами, как по мосту (load_behaviour)
+    for (std::size_t offset = 0; offset < code.size(); offset += 255) {
+        const auto count = static_cast<kf::u16>(std::min<std::size_t>(255, code.size() - offset));
+
+        if (not behaviour.load(offset != 0, code.data() + offset, count)) {
+            std::printf("status=rejected fault=%d\n", static_cast<int>(BehaviourVm::Fault::Overflow));
+            return 1;
+        }
+    }
+
+    const auto fault = behaviour.run();
+    if (fault != BehaviourVm::Fault::None) {
+        std::printf("status=rejected fault=%d\n", static_cast<int>(fault));
+        return 1;
+    }
+
+    std::vector<std::string> lines;
+    const auto start_us = zms::hal::nowMicros();
+    const auto add = [&](const std::string &text) {
+        lines.push_back(std::to_string((zms::hal::nowMicros() - start_us) / 1000) + " " + text);
+    };
+
+    zms::ForwardLimiter::Command motors{0, 0};
+    kf::Degrees arm = periphery.manipulator.armAngle();
+    kf::Degrees claw = periphery.manipulator.clawAngle();
+    kf::f32 min_gap_mm = sim.parameters.sensor_range_mm;
+    zms::BehaviourExecutor::Status status = behaviour.takeStatus();
+
+    const auto start_x = sim.drive.x;
+    const auto start_y = sim.drive.y;
+    const auto deadline_us = start_us + kf::u64(options.duration_s * 1e6);
+
+    while (zms::hal::nowMicros() < deadline_us) {
+        sim.step();
+        periphery.poll();
+
+        min_gap_mm = std::min({min_gap_mm, sim.sensorDistance(true), sim.sensorDistance(false)});
+
+        const auto requested = reflex.requestedCommand();
+        if (requested.left != motors.left or requested.right != motors.right) {
+            motors = requested;
+            add("motors " + std::to_string(std::lround(motors.left * 1000)) + " " + std::to_string(std::lround(motors.right * 1000)));
+        }
+
+        if (periphery.manipulator.armAngle() != arm or periphery.manipulator.clawAngle() != claw) {
+            arm = periphery.manipulator.armAngle();
+            claw = periphery.manipulator.clawAngle();
+            add("manipulator " + std::to_string(arm) + " " + std::to_string(claw));
+        }
+
+        if (behaviour.stateChanged()) {
+            status = behaviour.takeStatus();
+            add(std::string{"behaviour "} + stateName(status.state) + " pc=" + std::to_string(status.pc) + " report=" + std::to_string(status.report));
+        }
+
+        if (not behaviour.busy()) { break; }
+    }
+
+    std::printf("status=%s fault=%d t_s=%.3f executed=%u pc=%u report=%d travel_mm=%.1f min_gap_mm=%.1f arm_deg=%.1f claw_deg=%.1f\n",
+                stateName(status.state), static_cast<int>(status.fault),
+                double(zms::hal::nowMicros() - start_us) * 1e-6,
+                unsigned(status.executed), unsigned(status.pc), int(status.report),
+                std::hypot(sim.drive.x - start_x, sim.drive.y - start_y), double(min_gap_mm),
+                double(sim.arm.angle), double(sim.claw.angle));
+
+    if (not options.trace.empty()) {
+        std::ofstream out{options.trace};
+        for (const auto &line: lines) { out << line << '\n'; }
+    }
+
+    if (not options.expect.empty()) {
+        const auto mismatches = compareTrace(lines, options.expect);
+
+        if (mismatches < 0) {
+            std::fprintf(stderr, "%s: cannot open\n", options.expect.c_str());
+            return 2;
+        }
+
+        std::printf("trace: %zu lines, %ld differ from %s\n", lines.size(), mismatches, options.expect.c_str());
+        return (mismatches == 0) ? 0 : 1;
+    }
+
+    return 0;
+}
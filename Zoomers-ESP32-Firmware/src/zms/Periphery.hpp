@@ -3,13 +3,28 @@
 #include <kf/tools/validation.hpp>
 #include <kf/tools/meta/Singleton.hpp>
 #include <kf/tools/Storage.hpp>
-#include <kf/EspNow.hpp>
 #include <kf/Option.hpp>
 
+#if defined(ZMS_NATIVE)
+#include <array>
+#else
+#include <kf/EspNow.hpp>
+#endif
+
 #include "zms/drivers/Encoder.hpp"
 #include "zms/drivers/Motor.hpp"
 #include "zms/drivers/Sharp.hpp"
 #include "zms/drivers/Manipulator2DOF.hpp"
+#include "zms/hal/Hal.hpp"
+#include "zms/RobotVariant.hpp"
+#include "zms/tools/BehaviourVm.hpp"
+#include "zms/tools/BlackboxRing.hpp"
+#include "zms/tools/BootTimeline.hpp"
+#include "zms/tools/DifferentialOdometry.hpp"
+#include "zms/tools/ForwardLimiter.hpp"
+#include "zms/tools/MotionPrimitive.hpp"
+#include "zms/tools/PowerPolicy.hpp"
+#include "zms/tools/PurePursuit.hpp"
 
 /// @brief MISIS-Zoomers
 namespace zms {
@@ -20,6 +35,27 @@ namespace zms {
 struct Periphery final : kf::tools::Singleton<Periphery> {
     friend struct Singleton<Periphery>;
 
+#if defined(ZMS_NATIVE)
+    /// @brief MAC узла Espnow (на хосте ESP-NOW недоступен, поле сохраняет раскладку настроек)
+    using EspNowMac = std::array<kf::u8, 6>;
+#else
+    using EspNowMac = kf::EspNow::Mac;
+#endif
+
+#if defined(ZMS_STATIC_DRIVERS)
+    /// @brief Левый мотор: подключение варианта робота задано при компиляции
+    using LeftMotor = BasicMotor<StaticMotorWiring<RobotVariant::left_motor>>;
+
+    /// @brief Правый мотор: подключение варианта робота задано при компиляции
+    using RightMotor = BasicMotor<StaticMotorWiring<RobotVariant::right_motor>>;
+#else
+    /// @brief Левый мотор: подключение из настроек
+    using LeftMotor = Motor;
+
+    /// @brief Правый мотор: подключение из настроек
+    using RightMotor = Motor;
+#endif
+
     /// @brief Настройки аппаратного обеспечения
     struct Settings : kf::tools::Validable<Settings> {
 
@@ -46,10 +82,31 @@ struct Periphery final : kf::tools::Singleton<Periphery> {
         /// @brief ИК датчики расстояния
         Sharp::Settings left_distance_sensor, right_distance_sensor;
 
+        /// @brief Рефлекс уклонения от препятствий
+        ForwardLimiter::Settings obstacle_reflex;
+
+        /// @brief Геометрия и частота одометрии
+        DifferentialOdometry::Settings odometry;
+
+        /// @brief Регулятор примитивов движения
+        MotionPrimitive::Settings motion;
+
+        /// @brief Следование по пути
+        PurePursuit::Settings path_follower;
+
+        /// @brief Бортовой самописец
+        BlackboxSettings blackbox;
+
+        /// @brief Исполнитель поведений
+        BehaviourSettings behaviour;
+
+        /// @brief Управление питанием
+        PowerSettings power;
+
         // Софт
 
         /// @brief Настройки узла Espnow
-        kf::EspNow::Mac espnow_mac;
+        EspNowMac espnow_mac;
 
         void check(kf::tools::Validator &validator) const {
             // motors
@@ -66,6 +123,21 @@ struct Periphery final : kf::tools::Singleton<Periphery> {
             // distance sensors
             kf_Validator_check(validator, left_distance_sensor.isValid());
             kf_Validator_check(validator, right_distance_sensor.isValid());
+            kf_Validator_check(validator, obstacle_reflex.isValid());
+
+            // odometry
+            kf_Validator_check(validator, odometry.isValid());
+            kf_Validator_check(validator, motion.isValid());
+            kf_Validator_check(validator, path_follower.isValid());
+
+            // blackbox
+            kf_Validator_check(validator, blackbox.isValid());
+
+            // behaviour
+            kf_Validator_check(validator, behaviour.isValid());
+
+            // power
+            kf_Validator_check(validator, power.isValid());
         }
     };
 
@@ -77,10 +149,10 @@ struct Periphery final : kf::tools::Singleton<Periphery> {
     // Моторы
 
     /// @brief Левый мотор
-    Motor left_motor{storage.settings.left_motor, storage.settings.motor_pwm};
+    LeftMotor left_motor{storage.settings.left_motor, storage.settings.motor_pwm};
 
     /// @brief Правый мотор
-    Motor right_motor{storage.settings.right_motor, storage.settings.motor_pwm};
+    RightMotor right_motor{storage.settings.right_motor, storage.settings.motor_pwm};
 
     // Манипуляторы
 
@@ -105,43 +177,64 @@ struct Periphery final : kf::tools::Singleton<Periphery> {
 
     //
 
+#if not defined(ZMS_NATIVE)
     /// @brief Узел протокола Espnow
     kf::Option<kf::EspNow::Peer> espnow_peer{};
+#endif
+
+    /// @brief Хронология загрузки
+    BootTimeline boot{};
 
-    /// @brief Инициализировать всю периферию
+    /// @brief Наибольшее ожидание запуска WiFi и ESP-NOW после настройки драйверов (мс)
+    static constexpr kf::u32 espnow_start_timeout_ms = 2000;
+
+    /// @brief Инициализировать всю периферию.
+    /// Этапы проходятся независимо: неудавшийся отмечается в хронологии, остальное продолжает работу
+    /// (деградированный режим). WiFi и ESP-NOW поднимаются фоновой задачей параллельно с драйверами
+    /// @returns Все этапы успешны
     [[nodiscard]] bool init() {
-        // Попытка загрузить настройки
-        if (not storage.load()) {
-            // Не удалось - сохраняем значения по умолчанию
-            if (not storage.save()) {
-                storage.erase();
-                return false;
-            }
-        }
+#if not defined(ZMS_NATIVE)
+        // Запуск WiFi не зависит от настроек и дольше всего: идёт первым, на другом ядре
+        (void) espnow_task.start("zms_espnow", startEspnow, this);
+#endif
 
-        if (not storage.settings.isValid()) {
-            storage.erase();
-            return false;
-        }
+        boot.begin(BootStage::Storage);
+        boot.end(BootStage::Storage, loadSettings());
 
-        if (not manipulator.init()) { return false; }
+        boot.begin(BootStage::Manipulator);
+        boot.end(BootStage::Manipulator, manipulator.init());
 
-        if (not left_motor.init()) { return false; }
-        if (not right_motor.init()) { return false; }
+        boot.begin(BootStage::Motors);
+        const bool left_motor_ok = left_motor.init();
+        const bool right_motor_ok = right_motor.init();
+        boot.end(BootStage::Motors, left_motor_ok and right_motor_ok);
 
-        if (not left_distance_sensor.init()) { return false; }
-        if (not right_distance_sensor.init()) { return false; }
+        boot.begin(BootStage::DistanceSensors);
+        const bool left_distance_sensor_ok = left_distance_sensor.init();
+        const bool right_distance_sensor_ok = right_distance_sensor.init();
+        boot.end(BootStage::DistanceSensors, left_distance_sensor_ok and right_distance_sensor_ok);
 
+        boot.begin(BootStage::Encoders);
         left_encoder.init();
         right_encoder.init();
+        boot.end(BootStage::Encoders, true);
 
-        auto peer_init = initEspnowPeer();
-        if (peer_init.hasValue()) {
-            kf_Logger_error(kf::EspNow::stringFromError(peer_init.value()));
-            return false;
-        }
+#if not defined(ZMS_NATIVE)
+        boot.begin(BootStage::EspNowPeer);
+        boot.end(BootStage::EspNowPeer, initEspnowPeer());
+#endif
 
-        return true;
+        return not boot.degraded();
+    }
+
+    /// @brief Применить изменения настроек, внесённые на лету (UI, мост).
+    /// Каждый драйвер перенастраивает только изменившиеся параметры
+    void poll() {
+        if (not left_motor.reconfigure()) { left_motor.stop(); }
+        if (not right_motor.reconfigure()) { right_motor.stop(); }
+
+        left_encoder.reconfigure();
+        right_encoder.reconfigure();
     }
 
     /// @brief Получить настройки по умолчанию
@@ -152,22 +245,18 @@ struct Periphery final : kf::tools::Singleton<Periphery> {
                 .ledc_frequency_hz = 20000,
                 .dead_zone = 580,// Значение получено экспериментально
                 .ledc_resolution_bits = 10,
+                .stop_mode = Motor::StopMode::Coast,
+                .sample_pin = Motor::no_pin,
+                .sample_phase_permille = 500,
             },
-            .left_motor = {
-                .impl = Motor::DriverImpl::IArduino,
-                .direction = Motor::Direction::CCW,
-                .pin_a = static_cast<kf::u8>(GPIO_NUM_27),
-                .pin_b = static_cast<kf::u8>(GPIO_NUM_21),
-                .ledc_channel = 0,
-            },
-            .right_motor = {
-                .impl = Motor::DriverImpl::IArduino,
-                .direction = Motor::Direction::CW,
-                .pin_a = static_cast<kf::u8>(GPIO_NUM_19),
-                .pin_b = static_cast<kf::u8>(GPIO_NUM_18),
-                .ledc_channel = 1,
-            },
+            .left_motor = RobotVariant::left_motor,
+            .right_motor = RobotVariant::right_motor,
             .manipulator = {
+                .backend = Manipulator2DOF::Backend::Ledc,
+                .rmt = {
+                    .arm_channel = 0,
+                    .claw_channel = 1,
+                },
                 .servo_pwm = {
                     .ledc_frequency_hz = 50,
                     .ledc_resolution_bits = 10,
@@ -198,16 +287,8 @@ struct Periphery final : kf::tools::Singleton<Periphery> {
             .encoder_conversion = {
                 .ticks_in_one_mm = (5000.0f / 2100.0f),
             },
-            .left_encoder = {
-                .phase_a = static_cast<kf::u8>(GPIO_NUM_32),
-                .phase_b = static_cast<kf::u8>(GPIO_NUM_33),
-                .edge = Encoder::PinsSettings::Edge::Falling,
-            },
-            .right_encoder = {
-                .phase_a = static_cast<kf::u8>(GPIO_NUM_25),
-                .phase_b = static_cast<kf::u8>(GPIO_NUM_26),
-                .edge = Encoder::PinsSettings::Edge::Falling,
-            },
+            .left_encoder = RobotVariant::left_encoder,
+            .right_encoder = RobotVariant::right_encoder,
             .left_distance_sensor = {
                 .pin = static_cast<kf::u8>(GPIO_NUM_35),
                 .resolution = 10,
@@ -216,6 +297,47 @@ struct Periphery final : kf::tools::Singleton<Periphery> {
                 .pin = static_cast<kf::u8>(GPIO_NUM_34),
                 .resolution = 10,
             },
+            .obstacle_reflex = {
+                .enabled = true,
+                .stop_distance_mm = 120,
+                .slow_distance_mm = 300,
+                .sample_frequency_hz = 100,
+            },
+            .odometry = {
+                .track_width_mm = 130.0f,// Требует калибровки разворотом на месте
+                .update_frequency_hz = 200,
+            },
+            .motion = {
+                .position_gain = 0.02f,
+                .velocity_feedforward = 1.0f / 600.0f,// Скорость колеса при полной команде ~600 мм/с
+                .tolerance_mm = 2.0f,
+                .settle_timeout_ms = 500,
+                .update_frequency_hz = 200,
+            },
+            .path_follower = {
+                .lookahead_mm = 150.0f,
+                .cruise_speed_mm_s = 300.0f,
+                .deceleration_mm_s2 = 400.0f,
+                .goal_tolerance_mm = 10.0f,
+            },
+            .blackbox = {
+                .sample_frequency_hz = 200,
+                .post_trigger_samples = 128,
+                .trigger_on_reflex = true,
+                .spill_to_flash = false,
+            },
+            .behaviour = {
+                .update_frequency_hz = 100,
+                .instruction_budget = 64,
+            },
+            .power = {
+                .mode = PowerSettings::Mode::Balanced,
+                .max_frequency_mhz = 240,
+                .min_frequency_mhz = 80,
+                .idle_timeout_ms = 3000,
+                .sleep_slice_ms = 50,// Пульт шлёт пакеты чаще: первый же пакет в окне приёма будит робота
+                .listen_window_ms = 10,
+            },
             .espnow_mac = {
                 {0x78, 0x1c, 0x3c, 0xa4, 0x96, 0xdc},
             }
@@ -224,18 +346,70 @@ struct Periphery final : kf::tools::Singleton<Periphery> {
     }
 
 private:
+    /// @brief Загрузить настройки; если их нет - сохранить значения по умолчанию
+    /// @returns false - работа на значениях по умолчанию без сохранения
+    [[nodiscard]] bool loadSettings() {
+        // Попытка загрузить настройки
+        if (not storage.load()) {
+            // Не удалось - сохраняем значения по умолчанию
+            if (not storage.save()) {
+                storage.erase();
+                return false;
+            }
+        }
+
+        if (not storage.settings.isValid()) {
+            storage.erase();
+
+            // Драйверы не должны получить недопустимые значения
+            storage.settings = defaultSettings();
+            return false;
+        }
+
+        return true;
+    }
+
+#if not defined(ZMS_NATIVE)
+    /// @brief Фоновая задача запуска ESP-NOW
+    hal::BackgroundTask espnow_task{};
+
+    /// @brief Ошибка запуска ESP-NOW (заполняет фоновая задача)
+    kf::Option<kf::EspNow::Error> espnow_start_error{};
+
+    /// @brief Запуск WiFi и ESP-NOW (в фоновой задаче: без журнала, порт занят основным ядром)
+    static void startEspnow(void *self) {
+        auto &p = *static_cast<Periphery *>(self);
+
+        p.boot.begin(BootStage::EspNow);
 
-    [[nodiscard]] kf::Option<kf::EspNow::Error> initEspnowPeer() {
         const auto init_result = kf::EspNow::init();
-        if (not init_result.isOk()) { return init_result.error(); }
+        if (not init_result.isOk()) { p.espnow_start_error = init_result.error(); }
+
+        p.boot.end(BootStage::EspNow, init_result.isOk());
+    }
+
+    /// @brief Дождаться запуска ESP-NOW и добавить узел пульта
+    [[nodiscard]] bool initEspnowPeer() {
+        if (not espnow_task.join(espnow_start_timeout_ms)) {
+            kf_Logger_error("espnow start timeout");
+            return false;
+        }
+
+        if (espnow_start_error.hasValue()) {
+            kf_Logger_error(kf::EspNow::stringFromError(espnow_start_error.value()));
+            return false;
+        }
 
         const auto peer_result = kf::EspNow::Peer::add(storage.settings.espnow_mac);
-        if (not peer_result.isOk()) { return peer_result.error(); }
+        if (not peer_result.isOk()) {
+            kf_Logger_error(kf::EspNow::stringFromError(peer_result.error()));
+            return false;
+        }
 
         espnow_peer = peer_result.ok();
-
-        return {};
+        return true;
     }
+#endif
 };
 
 }// namespace zms
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "zms/drivers/Encoder.hpp"
+#include "zms/drivers/Motor.hpp"
+#include "zms/hal/Hal.hpp"
+
+namespace zms {
+
+/// @brief Вариант робота: подключение, неизменное для конкретной сборки.
+/// Служит значениями по умолчанию для хранилища, а при ZMS_STATIC_DRIVERS
+/// задаёт реализацию, пины и каналы драйверов моторов при компиляции (см. StaticMotorWiring)
+struct RobotVariant final {
+
+    /// @brief Левый мотор
+    static constexpr MotorBase::DriverSettings left_motor{
+        .impl = MotorBase::DriverImpl::IArduino,
+        .direction = MotorBase::Direction::CCW,
+        .pin_a = static_cast<kf::u8>(GPIO_NUM_27),
+        .pin_b = static_cast<kf::u8>(GPIO_NUM_21),
+        .ledc_channel = 0,
+    };
+
+    /// @brief Правый мотор
+    static constexpr MotorBase::DriverSettings right_motor{
+        .impl = MotorBase::DriverImpl::IArduino,
+        .direction = MotorBase::Direction::CW,
+        .pin_a = static_cast<kf::u8>(GPIO_NUM_19),
+        .pin_b = static_cast<kf::u8>(GPIO_NUM_18),
+        .ledc_channel = 1,
+    };
+
+    /// @brief Левый энкодер
+    static constexpr Encoder::PinsSettings left_encoder{
+        .phase_a = static_cast<kf::u8>(GPIO_NUM_32),
+        .phase_b = static_cast<kf::u8>(GPIO_NUM_33),
+        .edge = Encoder::PinsSettings::Edge::Falling,
+    };
+
+    /// @brief Правый энкодер
+    static constexpr Encoder::PinsSettings right_encoder{
+        .phase_a = static_cast<kf::u8>(GPIO_NUM_25),
+        .phase_b = static_cast<kf::u8>(GPIO_NUM_26),
+        .edge = Encoder::PinsSettings::Edge::Falling,
+    };
+};
+
+}// namespace zms
@@ -4,9 +4,19 @@
 #include <kf/tools/meta/Singleton.hpp>
 
 #include "zms/Periphery.hpp"
+#include "zms/services/BehaviourExecutor.hpp"
+#include "zms/services/Blackbox.hpp"
 #include "zms/services/ByteLangBridgeProtocol.hpp"
 #include "zms/services/DualJoystickRemoteController.hpp"
+#include "zms/services/ManipulatorTrajectoryExecutor.hpp"
+#include "zms/services/MotionExecutor.hpp"
+#include "zms/services/ObstacleReflex.hpp"
+#include "zms/services/Odometry.hpp"
+#include "zms/services/PathFollower.hpp"
+#include "zms/services/PowerManager.hpp"
 #include "zms/services/TextUI.hpp"
+#include "zms/tools/ServiceList.hpp"
+#include "zms/tools/Trace.hpp"
 
 namespace zms {
 
@@ -14,20 +24,175 @@ namespace zms {
 struct Service final : kf::tools::Singleton<Service> {
     friend struct Singleton<Service>;
 
+    /// @brief Привязка пульта к сервисам движения и манипулятору
+    struct RemoteControlBinding final {
+        ManipulatorTrajectoryExecutor &manipulator_executor;
+        ObstacleReflex &obstacle_reflex;
+        MotionExecutor &motion_executor;
+        PathFollower &path_follower;
+        BehaviourExecutor &behaviour_executor;
+
+        /// @brief Пакет управления с пульта
+        void onControl(const DualJoystickControlPacket &packet) {
+            static auto &periphery = zms::Periphery::instance();
+
+            // Пульт имеет приоритет над бортовыми примитивами и поведениями
+            motion_executor.cancel();
+            path_follower.cancel();
+            behaviour_executor.cancel();
+
+            obstacle_reflex.set(packet.left_y + packet.left_x, packet.left_y - packet.left_x);
+
+            const auto arm = static_cast<kf::Degrees>(packet.right_y * 45 + 90 + 45);
+            const auto claw = static_cast<kf::Degrees>(packet.right_x * 90 + 90);
+
+            // Пульт имеет приоритет над траекторией
+            manipulator_executor.cancel();
+            manipulator_executor.rehome(arm, claw);
+
+            periphery.manipulator.setArm(arm);
+            periphery.manipulator.setClaw(claw);
+        }
+
+        /// @brief Потеря связи с пультом
+        void onDisconnect() {
+            static auto &periphery = zms::Periphery::instance();
+
+            manipulator_executor.cancel();
+            motion_executor.cancel();
+            path_follower.cancel();
+            behaviour_executor.cancel();
+
+            obstacle_reflex.stop();
+
+            periphery.manipulator.disableArm();
+            periphery.manipulator.disableClaw();
+        }
+    };
+
+#if defined(ZMS_NATIVE)
+    /// @brief Текстовый интерфейс работает по ESP-NOW, на хосте отправки нет
+    using TextUISender = TextUINullSender;
+#else
+    /// @brief Отправка кадра текстового интерфейса по ESP-NOW
+    struct TextUISender final {
+        bool operator()(kf::slice<const kf::u8> slice) const {
+            static auto &periphery = zms::Periphery::instance();
+
+            // ESP-NOW не поднялся при загрузке (деградированный режим): отправлять некуда
+            if (not periphery.espnow_peer.hasValue()) { return false; }
+
+            const auto send_result = periphery.espnow_peer.value().sendBuffer(
+                kf::slice<const void>{
+                    slice.ptr,
+                    slice.size});
+
+            if (not send_result.isOk()) {
+                kf_Logger_error("text ui send fail: %s", kf::EspNow::stringFromError(send_result.error().value()));
+                return false;
+            }
+
+            return true;
+        }
+    };
+#endif
+
+    /// @brief Бортовая одометрия
+    Odometry odometry{};
+
     /// @brief Менеджер текстового пользовательского интерфейса
-    TextUI text_ui{};
+    TextUI<TextUISender> text_ui{odometry};
+
+    /// @brief Исполнитель траекторий манипулятора
+    ManipulatorTrajectoryExecutor manipulator_executor{};
+
+    /// @brief Рефлекс уклонения от препятствий (единственный выход на моторы колёс)
+    ObstacleReflex obstacle_reflex{};
+
+    /// @brief Исполнитель примитивов движения
+    MotionExecutor motion_executor{obstacle_reflex};
+
+    /// @brief Следование по пути
+    PathFollower path_follower{odometry, obstacle_reflex};
+
+    /// @brief Исполнитель поведений, загруженных с хоста
+    BehaviourExecutor behaviour_executor{obstacle_reflex, odometry, manipulator_executor};
 
     /// @brief Удаленный контроллер
-    DualJoystickRemoteController dual_joystick_remote_controller{200};
+    DualJoystickRemoteController<RemoteControlBinding> dual_joystick_remote_controller{
+        200,
+        RemoteControlBinding{manipulator_executor, obstacle_reflex, motion_executor, path_follower, behaviour_executor}};
 
-    /// @brief ByteLang мост
-    ByteLangBridgeProtocol bytelang_bridge{};
+    /// @brief Бортовой самописец
+    Blackbox blackbox{obstacle_reflex};
+
+    /// @brief Управление питанием (простой и сон основного цикла)
+    PowerManager power_manager{obstacle_reflex, motion_executor, path_follower, behaviour_executor, manipulator_executor};
 
-    /// @brief Инициализация сервисов
-    void init() {
+    /// @brief ByteLang мост
+    ByteLangBridgeProtocol bytelang_bridge{manipulator_executor, odometry, motion_executor, path_follower, obstacle_reflex, blackbox, behaviour_executor, power_manager};
+
+    /// @brief Инициализация сервисов (неудавшийся сервис не мешает остальным)
+    /// @returns Все сервисы инициализированы
+    bool init() {
+        bool ok = true;
+
+        if (not manipulator_executor.init()) {
+            kf_Logger_error("manipulator executor init failed");
+            ok = false;
+        }
+
+        if (not obstacle_reflex.init()) {
+            kf_Logger_error("obstacle reflex init failed");
+            ok = false;
+        }
+
+        if (not odometry.init()) {
+            kf_Logger_error("odometry init failed");
+            ok = false;
+        }
+
+        if (not motion_executor.init()) {
+            kf_Logger_error("motion executor init failed");
+            ok = false;
+        }
+
+        if (not path_follower.init()) {
+            kf_Logger_error("path follower init failed");
+            ok = false;
+        }
+
+        if (not behaviour_executor.init()) {
+            kf_Logger_error("behaviour executor init failed");
+            ok = false;
+        }
+
+        if (not blackbox.init()) {
+            kf_Logger_error("blackbox init failed");
+            ok = false;
+        }
+
+        if (not power_manager.init()) {
+            kf_Logger_error("power manager init failed");
+            ok = false;
+        }
+
+#if not defined(ZMS_NATIVE)
+        // Пульт и текстовый интерфейс работают по ESP-NOW, на хосте их нет.
+        // Обработчик приёма хранит библиотека (std::function): это единственный косвенный вызов, на пакет, а не на цикл
         static auto &periphery = zms::Periphery::instance();
 
+        if (not periphery.espnow_peer.hasValue()) {
+            kf_Logger_warn("no ESP-NOW peer: remote controller and text UI disabled");
+            return ok;
+        }
+
         periphery.espnow_peer.value().setReceiveHandler([this](kf::slice<const void> data) {
+            zms_trace_scope(TracePoint::EspNowReceive, std::min<std::size_t>(data.size, 0xFF));
+
+            // Пакет в окне приёма между снами будит робота
+            power_manager.notifyActivity();
+
             /// Действие в меню
             enum Action : kf::u8 {
                 None = 0x00,
@@ -55,8 +220,8 @@ struct Service final : kf::tools::Singleton<Service> {
             };
 
             switch (data.size) {
-                case sizeof(zms::DualJoystickRemoteController::ControlPacket)://
-                    dual_joystick_remote_controller.updateControlPacket(*static_cast<const zms::DualJoystickRemoteController::ControlPacket *>(data.ptr));
+                case sizeof(DualJoystickControlPacket)://
+                    dual_joystick_remote_controller.updateControlPacket(*static_cast<const DualJoystickControlPacket *>(data.ptr));
                     return;
 
                 case sizeof(Action)://
@@ -66,44 +231,21 @@ struct Service final : kf::tools::Singleton<Service> {
                 default: kf_Logger_warn("Unknown packet: (%d bytes)", data.size);
             }
         });
+#endif
 
-        dual_joystick_remote_controller.control_handler = [](const DualJoystickRemoteController::ControlPacket &packet) {
-            periphery.left_motor.set(packet.left_y + packet.left_x);
-            periphery.right_motor.set(packet.left_y - packet.left_x);
-
-            periphery.manipulator.setArm(static_cast<kf::Degrees>(packet.right_y * 45 + 90 + 45));
-            periphery.manipulator.setClaw(static_cast<kf::Degrees>(packet.right_x * 90 + 90));
-        };
-
-        dual_joystick_remote_controller.disconnect_handler = []() {
-            periphery.left_motor.stop();
-            periphery.right_motor.stop();
-
-            periphery.manipulator.disableArm();
-            periphery.manipulator.disableClaw();
-        };
-
-        text_ui.send_handler = [](kf::slice<const kf::u8> slice) -> bool {
-            const auto send_result = periphery.espnow_peer.value().sendBuffer(
-                kf::slice<const void>{
-                    slice.ptr,
-                    slice.size});
-
-            if (not send_result.isOk()) {
-                kf_Logger_error("text ui send fail: %s", kf::EspNow::stringFromError(send_result.error().value()));
-                return false;
-            }
-
-            return true;
-        };
+        return ok;
     }
 
     /// @brief Прокрутка событий сервисов
     void poll() {
-        text_ui.poll();
-        bytelang_bridge.poll();
-        dual_joystick_remote_controller.poll();
-    };
+        zms_trace_scope(TracePoint::Services, 0);
+
+        ServiceList<
+            &Service::text_ui,
+            &Service::bytelang_bridge,
+            &Service::dual_joystick_remote_controller,
+            &Service::blackbox>::poll(*this);
+    }
 };
 
 }// namespace zms
@@ -0,0 +1,367 @@
+#pragma once
+
+#include <kf/UI.hpp>
+
+#include "zms/Periphery.hpp"
+#include "zms/Service.hpp"
+#include "zms/bench/Reference.hpp"
+#include "zms/tools/Benchmark.hpp"
+#include "zms/tools/MemoryStream.hpp"
+#include "zms/tools/Trace.hpp"
+
+/// Замеры горячих путей основного цикла.
+/// Один и тот же набор идёт на хост (окружение bench, фейковая плата) и на плату (ZMS_BENCHMARK,
+/// результаты через мост). На плате замеры не должны двигать робота: моторы получают только 0,
+/// сервопривод пишет в свободный канал LEDC без пина, мост работает поверх потока в памяти.
+/// Замеры *_reference - прежние реализации (Reference.hpp) на тех же входах, для сравнения
+
+namespace zms::bench {
+
+/// @brief Свободный канал LEDC (моторы - 0, 1; манипулятор - 14, 15)
+static constexpr kf::u8 spare_ledc_channel = 7;
+
+/// @brief Шаг перебора нормализованной команды (простое число: проходит разные значения)
+static constexpr kf::i32 normalized_step = 997;
+
+// Мотор
+
+static void motor_pwm_from_normalized(Benchmark::State &state) {
+    const auto &pwm = Periphery::instance().left_motor.pwmSettings();
+    const auto span = static_cast<Motor::SignedPwm>(pwm.maxPwm() - pwm.dead_zone);
+
+    kf::i32 raw = -NormalizedCommand::one;
+
+    for (auto _: state) {
+        Benchmark::doNotOptimize(Motor::pwmFromNormalized(NormalizedCommand::fromRaw(raw), pwm.dead_zone, span));
+        raw = (raw >= NormalizedCommand::one) ? -NormalizedCommand::one : raw + normalized_step;
+    }
+}
+zms_benchmark(motor_pwm_from_normalized);
+
+static void motor_write(Benchmark::State &state) {
+    auto &motor = Periphery::instance().left_motor;
+
+    for (auto _: state) {
+        motor.write(0);
+    }
+}
+zms_benchmark(motor_write);
+
+/// @brief Шаг перебора нормализованного значения float: проходит весь диапазон, почти всё - вне мёртвой зоны
+static constexpr kf::f32 float_step = 0.0371f;
+
+static void motor_pwm_from_normalized_reference(Benchmark::State &state) {
+    const auto &pwm = Periphery::instance().left_motor.pwmSettings();
+    const auto max_pwm = static_cast<Motor::SignedPwm>(pwm.maxPwm());
+
+    kf::i32 raw = -NormalizedCommand::one;
+
+    for (auto _: state) {
+        Benchmark::doNotOptimize(reference::motorPwmFromNormalized(NormalizedCommand::fromRaw(raw).toFloat(), pwm.dead_zone, max_pwm));
+        raw = (raw >= NormalizedCommand::one) ? -NormalizedCommand::one : raw + normalized_step;
+    }
+}
+zms_benchmark(motor_pwm_from_normalized_reference);
+
+static void motor_set_float(Benchmark::State &state) {
+    // Путь set(float) без записи в драйвер (запись - motor_write): на плате мотор не двигается
+    const auto &pwm = Periphery::instance().left_motor.pwmSettings();
+    const auto span = static_cast<Motor::SignedPwm>(pwm.maxPwm() - pwm.dead_zone);
+
+    kf::f32 value = -1.0f;
+
+    for (auto _: state) {
+        Benchmark::doNotOptimize(Motor::pwmFromFloat(value, pwm.dead_zone, span));
+        value = (value >= 1.0f) ? -1.0f : value + float_step;
+    }
+}
+zms_benchmark(motor_set_float);
+
+static void motor_set_float_reference(Benchmark::State &state) {
+    const auto &pwm = Periphery::instance().left_motor.pwmSettings();
+    const auto max_pwm = static_cast<Motor::SignedPwm>(pwm.maxPwm());
+
+    kf::f32 value = -1.0f;
+
+    for (auto _: state) {
+        Benchmark::doNotOptimize(reference::motorPwmFromNormalized(value, pwm.dead_zone, max_pwm));
+        value = (value >= 1.0f) ? -1.0f : value + float_step;
+    }
+}
+zms_benchmark(motor_set_float_reference);
+
+// Сервопривод
+
+static void servo_set(Benchmark::State &state) {
+    const auto &manipulator = Periphery::instance().storage.settings.manipulator;
+
+    static PwmPositionServo::DriverSettings axis{};
+    axis = manipulator.arm_axis;
+    axis.ledc_channel = spare_ledc_channel;
+
+    static PwmPositionServo servo{manipulator.servo_pwm, axis, manipulator.servo_generic_pulse_settings};
+    servo.updateCoefficients();
+
+    // Канал настраивается, но к пину не подключается
+    (void) hal::ledcSetup(spare_ledc_channel, manipulator.servo_pwm.ledc_frequency_hz, manipulator.servo_pwm.ledc_resolution_bits);
+
+    auto angle = axis.min_angle;
+
+    for (auto _: state) {
+        servo.set(angle);
+        angle = (angle >= axis.max_angle) ? axis.min_angle : angle + 1;
+    }
+}
+zms_benchmark(servo_set);
+
+static void servo_duty(Benchmark::State &state) {
+    // Только перевод угла в скважность, без записи в LEDC
+    const auto &manipulator = Periphery::instance().storage.settings.manipulator;
+    const auto &pulse = manipulator.servo_generic_pulse_settings;
+
+    const auto coefficients = ServoPulseCoefficients::calculate(
+        static_cast<kf::i32>(pulse.min_position.pulse),
+        static_cast<kf::i32>(pulse.min_position.angle),
+        static_cast<kf::i32>(pulse.max_position.pulse),
+        static_cast<kf::i32>(pulse.max_position.angle),
+        static_cast<kf::i32>(pulse.min_position.angle),
+        static_cast<kf::i32>(pulse.max_position.angle));
+    const auto duty_per_us_q32 = manipulator.servo_pwm.dutyPerMicrosecondQ32();
+
+    kf::i32 angle = 0;
+
+    for (auto _: state) {
+        const auto pulse_us = coefficients.pulseWidth(angle);
+        Benchmark::doNotOptimize(static_cast<kf::u16>((kf::u64(pulse_us) * duty_per_us_q32) >> 32));
+        angle = (angle >= 180) ? 0 : angle + 1;
+    }
+}
+zms_benchmark(servo_duty);
+
+static void servo_duty_reference(Benchmark::State &state) {
+    const auto &manipulator = Periphery::instance().storage.settings.manipulator;
+
+    kf::Degrees angle = 0;
+
+    for (auto _: state) {
+        Benchmark::doNotOptimize(reference::servoDuty(manipulator.servo_pwm, manipulator.servo_generic_pulse_settings, angle));
+        angle = (angle >= 180) ? 0 : angle + 1;
+    }
+}
+zms_benchmark(servo_duty_reference);
+
+// Дальномер
+
+static void sharp_distance(Benchmark::State &state) {
+    kf::u32 sum = 1;
+
+    for (auto _: state) {
+        Benchmark::doNotOptimize(Sharp::distanceFromSum(sum, 4));
+        sum = (sum >= 4 * 4095) ? 1 : sum + 37;
+    }
+}
+zms_benchmark(sharp_distance);
+
+static void sharp_distance_reference(Benchmark::State &state) {
+    kf::u32 sum = 1;
+
+    for (auto _: state) {
+        Benchmark::doNotOptimize(reference::sharpDistance(sum, 4));
+        sum = (sum >= 4 * 4095) ? 1 : sum + 37;
+    }
+}
+zms_benchmark(sharp_distance_reference);
+
+// Энкодер
+
+static void encoder_to_millimeters(Benchmark::State &state) {
+    const auto &encoder = Periphery::instance().left_encoder;
+
+    Encoder::Ticks ticks = -100000;
+
+    for (auto _: state) {
+        Benchmark::doNotOptimize(encoder.toFixedMillimeters(ticks));
+        ticks += 7;
+    }
+}
+zms_benchmark(encoder_to_millimeters);
+
+static void encoder_to_millimeters_reference(Benchmark::State &state) {
+    const auto &conversion = Periphery::instance().storage.settings.encoder_conversion;
+
+    Encoder::Ticks ticks = -100000;
+
+    for (auto _: state) {
+        Benchmark::doNotOptimize(conversion.toMillimeters(ticks));
+        ticks += 7;
+    }
+}
+zms_benchmark(encoder_to_millimeters_reference);
+
+static void encoder_to_ticks(Benchmark::State &state) {
+    const auto &encoder = Periphery::instance().left_encoder;
+
+    auto mm = FixedMillimeters::fromInt(-1000);
+
+    for (auto _: state) {
+        Benchmark::doNotOptimize(encoder.toTicks(mm));
+        mm = FixedMillimeters::fromRaw(mm.raw + 13);
+    }
+}
+zms_benchmark(encoder_to_ticks);
+
+static void encoder_to_ticks_reference(Benchmark::State &state) {
+    const auto &conversion = Periphery::instance().storage.settings.encoder_conversion;
+
+    auto mm = FixedMillimeters::fromInt(-1000);
+
+    for (auto _: state) {
+        Benchmark::doNotOptimize(conversion.toTicks(kf::Millimeters(mm.toFloat())));
+        mm = FixedMillimeters::fromRaw(mm.raw + 13);
+    }
+}
+zms_benchmark(encoder_to_ticks_reference);
+
+// Поведения
+
+static void behaviour_vm_step(Benchmark::State &state) {
+    // loop: sense r0, left_distance; li r1, 150; jlt r0, r1, end; addi r2, 1; jmp loop; end: halt
+    static const kf::u8 program[] = {
+        0x20, 0x00, 0x00,
+        0x01, 0x01, 0x96, 0x00,
+        0x11, 0x00, 0x01, 0x14, 0x00,
+        0x05, 0x02, 0x01, 0x00,
+        0x10, 0x00, 0x00,
+        0x00,
+    };
+
+    static BehaviourVm vm{};
+    vm.clear();
+    (void) vm.append(program, sizeof(program));
+    (void) vm.start(0);
+
+    const BehaviourVm::Inputs inputs{{400, 400, 0, 0, 0, 0, 0}};
+    BehaviourVm::Outputs outputs{};
+
+    // Шаг с бюджетом по умолчанию: 64 инструкции, программа не завершается
+    for (auto _: state) {
+        Benchmark::doNotOptimize(vm.step(inputs, outputs, 0, 64));
+    }
+}
+zms_benchmark(behaviour_vm_step);
+
+// Мост
+
+/// @brief Мост поверх потока в памяти, связанный с сервисами робота
+struct BridgeFixture {
+    MemoryStream<64> stream{};
+    ByteLangBridgeProtocol bridge;
+
+    BridgeFixture() :
+        bridge{stream, Service::instance().manipulator_executor, Service::instance().odometry,
+               Service::instance().motion_executor, Service::instance().path_follower,
+               Service::instance().obstacle_reflex, Service::instance().blackbox,
+               Service::instance().behaviour_executor, Service::instance().power_manager} {}
+
+    static BridgeFixture &instance() {
+        static BridgeFixture fixture{};
+        return fixture;
+    }
+};
+
+static void bridge_encode_pose(Benchmark::State &state) {
+    auto &fixture = BridgeFixture::instance();
+    const auto stamped = Service::instance().odometry.get();
+
+    for (auto _: state) {
+        (void) fixture.bridge.send_pose(stamped);
+    }
+
+    fixture.stream.clear();
+}
+zms_benchmark(bridge_encode_pose);
+
+static void bridge_decode_set_motors(Benchmark::State &state) {
+    auto &fixture = BridgeFixture::instance();
+
+    // set_motors(0, 0): разбор, диспетчеризация и запись в рефлекс; в замер входит цикл poll() моста
+    const kf::u8 instruction[] = {0x03, 0x00, 0x00, 0x00, 0x00};
+
+    for (auto _: state) {
+        (void) fixture.stream.feed(instruction, sizeof(instruction));
+        fixture.bridge.poll();
+    }
+
+    fixture.stream.clear();
+}
+zms_benchmark(bridge_decode_set_motors);
+
+// Интерфейс
+
+static void ui_render(Benchmark::State &state) {
+    auto &page_manager = kf::UI::instance();
+
+    for (auto _: state) {
+        Benchmark::doNotOptimize(page_manager.render().size);
+    }
+}
+zms_benchmark(ui_render);
+
+// Питание
+
+static void power_policy_decide(Benchmark::State &state) {
+    // Решение и учёт задержки - то, что idle() добавляет к каждой итерации основного цикла
+    static PowerPolicy policy{};
+    static LatencyStats latency{};
+
+    const auto &settings = Periphery::defaultSettings().power;
+    kf::u32 now_ms = 0;
+
+    for (auto _: state) {
+        Benchmark::doNotOptimize(policy.decide(settings, false, now_ms));
+        latency.add(now_ms & 0xFF);
+        now_ms += 1;
+    }
+
+    Benchmark::doNotOptimize(latency.mean());
+}
+zms_benchmark(power_policy_decide);
+
+// Трасса
+
+static void trace_scope(Benchmark::State &state) {
+    // Участок трассы при идущей записи: поиск задачи, два события (кольцо перезаписывается)
+    Trace::start();
+
+    for (auto _: state) {
+        const TraceScope scope{TracePoint::ServicePoll, 0xFF};
+    }
+
+    Trace::stop();
+}
+zms_benchmark(trace_scope);
+
+// Пульт
+
+static void remote_controller_poll(Benchmark::State &state) {
+    // Тайм-аут с запасом: пульт "подключён" всю партию
+    static DualJoystickControlPacket received{};
+
+    struct Capture {
+        void onControl(const DualJoystickControlPacket &packet) { received = packet; }
+
+        void onDisconnect() {}
+    };
+
+    static DualJoystickRemoteController<Capture> controller{60000, Capture{}};
+
+    controller.updateControlPacket({0.1f, 0.2f, 0.3f, 0.4f});
+
+    for (auto _: state) {
+        controller.poll();
+        Benchmark::clobberMemory();
+    }
+}
+zms_benchmark(remote_controller_poll);
+
+}// namespace zms::bench
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <kf/aliases.hpp>
+#include <kf/units.hpp>
+
+#include "zms/drivers/Motor.hpp"
+#include "zms/drivers/PwmPositionServo.hpp"
+
+/// Эталонные реализации преобразований до перехода на фиксированную точку.
+/// По ним замеры (Benchmarks.hpp) показывают выигрыш, а тесты (test/test_fixed_point) - точность новых путей.
+/// Допуски относительно эталона (проверяются тестами):
+/// - мотор: не больше 1 шага ШИМ; граница мёртвой зоны для команд моста совпадает точно,
+///   для float - кроме полосы шириной в 1 шаг Q15 ниже 0.01;
+/// - энкодер: мм - не дальше |ticks| * 2^-25 + 1/256 мм плюс шаг float (0.07 мм на 2e6 отсчётов), отсчёты - не больше 1;
+/// - дальномер: целая часть эталона;
+/// - сервопривод: совпадает точно
+
+namespace zms::bench::reference {
+
+/// @brief Нормализованная команда -> ШИМ (прежний Motor::fromNormalized, float)
+[[nodiscard]] inline Motor::SignedPwm motorPwmFromNormalized(kf::f32 value, Motor::SignedPwm dead_zone, Motor::SignedPwm max_pwm) {
+    constexpr auto normalized_dead_zone = 1e-2f;
+
+    if (std::isnan(value)) { return 0; }
+
+    const auto abs_value = std::abs(std::clamp(value, -1.0f, +1.0f));
+    if (abs_value < normalized_dead_zone) { return 0; }
+
+    const auto ret = int(abs_value * float(max_pwm - dead_zone)) + dead_zone;
+    return static_cast<Motor::SignedPwm>((value > 0.0f) ? ret : -ret);
+}
+
+/// @brief Значение мотора из моста [-1000, 1000] -> нормализованное (прежний set_motors)
+[[nodiscard]] inline kf::f32 normalizedFromBridge(kf::i16 value) {
+    constexpr auto max_value = 1000.0f;
+    return std::clamp(kf::f32(value), -max_value, max_value) / max_value;
+}
+
+/// @brief Расстояние дальномера по сумме n отсчётов АЦП (прежний Sharp::read, деление float)
+[[nodiscard]] inline kf::f32 sharpDistance(kf::u32 sum, kf::u32 n) {
+    return (65535.0f * kf::f32(n)) / kf::f32(sum);
+}
+
+/// @brief Скважность сервопривода для угла (прежний PwmPositionServo::set: map() и 64-битное деление)
+[[nodiscard]] inline kf::u16 servoDuty(
+    const PwmPositionServo::PwmSettings &pwm,
+    const PwmPositionServo::PulseSettings &pulse,
+    kf::Degrees angle
+) {
+    return pwm.dutyFromPulseWidth(pulse.pulseWidthFromAngle(angle));
+}
+
+}// namespace zms::bench::reference
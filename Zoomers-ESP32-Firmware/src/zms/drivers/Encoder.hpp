@@ -1,12 +1,15 @@
 #pragma once
 
-#include <Arduino.h>
 #include <kf/units.hpp>
 #include <kf/tools/validation.hpp>
 
+#include "zms/hal/Hal.hpp"
+#include "zms/tools/DoubleBuffer.hpp"
+#include "zms/tools/FixedPoint.hpp"
+#include "zms/tools/Trace.hpp"
 
 /// @brief Обработчик прерывания на основной фазе
-static void IRAM_ATTR encoderInterruptHandler(void *);
+static void zms_hal_isr encoderInterruptHandler(void *);
 
 namespace zms {
 
@@ -31,6 +34,16 @@ struct Encoder {
             return Ticks(mm * ticks_in_one_mm);
         }
 
+        /// @brief Коэффициент "отсчёты -> мм" (обратная величина, считается один раз)
+        [[nodiscard]] ScaleFactor millimetersPerTick() const {
+            return ScaleFactor::fromFloat(1.0 / kf::f64(ticks_in_one_mm));
+        }
+
+        /// @brief Коэффициент "мм -> отсчёты"
+        [[nodiscard]] ScaleFactor ticksPerMillimeter() const {
+            return ScaleFactor::fromFloat(ticks_in_one_mm);
+        }
+
         void check(kf::tools::Validator &validator) const {
             kf_Validator_check(validator, ticks_in_one_mm > 0);
         }
@@ -43,10 +56,10 @@ struct Encoder {
         enum class Edge : kf::u8 {
 
             /// @brief Прерывание по нарастанию (LOW -> HIGH)
-            Rising = RISING,
+            Rising = static_cast<kf::u8>(hal::Edge::Rising),
 
             /// @brief Прерывание по спаду (HIGH -> LOW)
-            Falling = FALLING
+            Falling = static_cast<kf::u8>(hal::Edge::Falling)
         };
 
         /// @brief Пин основного сигнала (источник прерывания)
@@ -59,38 +72,74 @@ struct Encoder {
         Edge edge;
     };
 
-    /// @brief Настройки подключения
-    const PinsSettings &pins;
+    /// @brief Настройки подключения (редактируемые + активные)
+    DoubleBuffer<PinsSettings> pins;
 
-    /// @brief Настройки преобразования
-    const ConversionSettings &conversion;
+    /// @brief Настройки преобразования (редактируемые + активные)
+    DoubleBuffer<ConversionSettings> conversion;
 
     /// @brief Текущее положение энкодера в отсчётах
     Ticks position{0};
 
+    /// @brief Пин вторичной фазы, читаемый из прерывания
+    kf::u8 phase_b_pin{0};
+
+private:
+    /// @brief Обработка прерываний подключена
+    bool enabled{false};
+
+    /// @brief Предрасчитанный коэффициент "отсчёты -> мм"
+    ScaleFactor mm_per_tick{};
+
+    /// @brief Предрасчитанный коэффициент "мм -> отсчёты"
+    ScaleFactor ticks_per_mm{};
+
+public:
     explicit Encoder(const PinsSettings &pins_settings, const ConversionSettings &conversion_settings) :
         pins{pins_settings}, conversion{conversion_settings} {}
 
     /// @brief Инициализировать пины энкодера
     void init() {
-        pinMode(pins.phase_a, INPUT);
-        pinMode(pins.phase_b, INPUT);
+        updateConversion();
+        setupPins();
+    }
 
-        enable();
+    /// @brief Применить изменившиеся настройки подключения.
+    /// Прерывание переподключается только при смене пинов или фронта, положение сохраняется
+    void reconfigure() {
+        if (conversion.changed() and conversion.pending().isValid()) {
+            updateConversion();
+        }
+
+        if (not pins.changed()) { return; }
+
+        const bool was_enabled = enabled;
+        disable();
+
+        // Только пины: init() повторно переключил бы буфер преобразования
+        setupPins();
+
+        if (not was_enabled) { disable(); }
     }
 
     /// @brief Разрешить (Подключить) обработку прерываний с основной фазы
     void enable() {
-        attachInterruptArg(
-            pins.phase_a,
+        const auto &active = pins.active();
+        phase_b_pin = active.phase_b;
+
+        hal::interruptAttach(
+            active.phase_a,
             encoderInterruptHandler,
             static_cast<void *>(this),
-            static_cast<int>(pins.edge));
+            static_cast<hal::Edge>(active.edge));
+
+        enabled = true;
     }
 
     /// @brief Отключить обработку прерываний
-    void disable() const {
-        detachInterrupt(pins.phase_a);
+    void disable() {
+        hal::interruptDetach(pins.active().phase_a);
+        enabled = false;
     }
 
     /// @brief Положение энкодера в отчётах
@@ -103,14 +152,48 @@ struct Encoder {
         position = new_position;
     }
 
+    /// @brief Положение энкодера в мм (фиксированная точка)
+    [[nodiscard]] inline FixedMillimeters getPositionFixed() const {
+        return toFixedMillimeters(position);
+    }
+
+    /// @brief Перевести отсчёты в мм по предрасчитанному коэффициенту
+    [[nodiscard]] inline FixedMillimeters toFixedMillimeters(Ticks ticks) const {
+        return FixedMillimeters::fromRaw(mm_per_tick.apply<FixedMillimeters::fraction_bits>(ticks));
+    }
+
+    /// @brief Перевести мм в отсчёты по предрасчитанному коэффициенту (усечение к нулю, как ConversionSettings::toTicks)
+    [[nodiscard]] inline Ticks toTicks(FixedMillimeters mm) const {
+        if (mm.raw < 0) { return -(ticks_per_mm.apply(-mm.raw) >> FixedMillimeters::fraction_bits); }
+        return ticks_per_mm.apply(mm.raw) >> FixedMillimeters::fraction_bits;
+    }
+
     /// @brief Положение энкодера в мм
     [[nodiscard]] inline kf::Millimeters getPositionMillimeters() const {
-        return conversion.toMillimeters(position);
+        return kf::Millimeters(getPositionFixed().toFloat());
     }
 
     /// @brief Установить положение энкодера в мм
     void setPositionMillimeters(kf::Millimeters new_position) {
-        position = conversion.toTicks(new_position);
+        position = conversion.active().toTicks(new_position);
+    }
+
+private:
+    /// @brief Переключить буфер пинов, настроить входы и подключить прерывание
+    void setupPins() {
+        pins.swap();
+
+        hal::gpioMode(pins.active().phase_a, hal::PinMode::Input);
+        hal::gpioMode(pins.active().phase_b, hal::PinMode::Input);
+
+        enable();
+    }
+
+    /// @brief Применить настройки преобразования и пересчитать коэффициенты
+    void updateConversion() {
+        conversion.swap();
+        mm_per_tick = conversion.active().millimetersPerTick();
+        ticks_per_mm = conversion.active().ticksPerMillimeter();
     }
 };
 
@@ -118,8 +201,9 @@ struct Encoder {
 
 void encoderInterruptHandler(void *instance) {
     auto &encoder = *static_cast<zms::Encoder *>(instance);
+    zms_trace_isr_scope(zms::TracePoint::EncoderInterrupt, encoder.phase_b_pin);
 
-    if (digitalRead(encoder.pins.phase_b)) {
+    if (zms::hal::gpioRead(encoder.phase_b_pin)) {
         encoder.position += 1;
     } else {
         encoder.position -= 1;
@@ -4,15 +4,31 @@
 #include <kf/units.hpp>
 
 #include "zms/drivers/PwmPositionServo.hpp"
+#include "zms/drivers/RmtServoPair.hpp"
 
 namespace zms {
 
 /// @brief Двухосевой манипулятор
 struct Manipulator2DOF {
 
+    /// @brief Периферия генерации импульсов
+    enum class Backend : kf::u8 {
+        /// @brief LEDC ШИМ (шаг скважности зависит от разрешения)
+        Ledc = 0x00,
+
+        /// @brief RMT, шаг импульса 1 мкс, оси обновляются синхронно
+        Rmt = 0x01,
+    };
+
     /// @brief Настройки двухосного манипулятора
     struct Settings : kf::tools::Validable<Settings> {
 
+        /// @brief Выбранная периферия генерации импульсов
+        Backend backend;
+
+        /// @brief Каналы RMT (используются при Backend::Rmt)
+        RmtServoPair::Settings rmt;
+
         /// @brief Настройки ШИМ сервопривода
         PwmPositionServo::PwmSettings servo_pwm;
 
@@ -30,6 +46,10 @@ struct Manipulator2DOF {
             kf_Validator_check(validator, claw_axis.isValid());
             kf_Validator_check(validator, servo_pwm.isValid());
             kf_Validator_check(validator, servo_generic_pulse_settings.isValid());
+
+            if (backend == Backend::Rmt) {
+                kf_Validator_check(validator, rmt.isValid());
+            }
         }
     };
 
@@ -43,14 +63,39 @@ private:
     /// @brief Привод оси захвата
     PwmPositionServo claw_axis;
 
+    /// @brief Пара осей на RMT
+    RmtServoPair rmt_axes;
+
+    /// @brief Периферия, выбранная при инициализации
+    Backend backend{Backend::Ledc};
+
+    /// @brief Последний заданный угол звена
+    kf::Degrees arm_angle{0};
+
+    /// @brief Последний заданный угол захвата
+    kf::Degrees claw_angle{0};
+
 public:
     explicit Manipulator2DOF(const Settings &settings) :
         settings{settings},
         arm_axis{settings.servo_pwm, settings.arm_axis, settings.servo_generic_pulse_settings},
-        claw_axis{settings.servo_pwm, settings.claw_axis, settings.servo_generic_pulse_settings} {}
+        claw_axis{settings.servo_pwm, settings.claw_axis, settings.servo_generic_pulse_settings},
+        rmt_axes{settings.rmt, settings.servo_pwm, settings.servo_generic_pulse_settings, settings.arm_axis, settings.claw_axis} {}
 
-    /// @brief Инициализировать захват
+    /// @brief Инициализировать захват.
+    /// Коэффициенты импульсов рассчитываются здесь: изменённые настройки вступают в силу после перезапуска
     [[nodiscard]] bool init() {
+        backend = settings.backend;
+
+        if (backend == Backend::Rmt) {
+            if (not rmt_axes.init()) {
+                kf_Logger_error("rmt axes fail");
+                return false;
+            }
+
+            return true;
+        }
+
         if (not arm_axis.init()) {
             kf_Logger_error("arm axis fail");
             return false;
@@ -64,13 +109,60 @@ public:
         return true;
     }
 
-    inline void setArm(kf::Degrees angle) { arm_axis.set(angle); }
+    /// @brief Установить обе оси (на RMT - в одном периоде)
+    void set(kf::Degrees arm, kf::Degrees claw) {
+        arm_angle = arm;
+        claw_angle = claw;
+
+        if (backend == Backend::Rmt) {
+            rmt_axes.set(arm, claw);
+        } else {
+            arm_axis.set(arm);
+            claw_axis.set(claw);
+        }
+    }
+
+    void setArm(kf::Degrees angle) {
+        arm_angle = angle;
+
+        if (backend == Backend::Rmt) {
+            rmt_axes.setArm(angle);
+        } else {
+            arm_axis.set(angle);
+        }
+    }
 
-    inline void setClaw(kf::Degrees angle) { claw_axis.set(angle); }
+    void setClaw(kf::Degrees angle) {
+        claw_angle = angle;
 
-    inline void disableArm() { arm_axis.disable(); }
+        if (backend == Backend::Rmt) {
+            rmt_axes.setClaw(angle);
+        } else {
+            claw_axis.set(angle);
+        }
+    }
 
-    inline void disableClaw() { claw_axis.disable(); }
+    /// @brief Последний заданный угол звена
+    [[nodiscard]] inline kf::Degrees armAngle() const { return arm_angle; }
+
+    /// @brief Последний заданный угол захвата
+    [[nodiscard]] inline kf::Degrees clawAngle() const { return claw_angle; }
+
+    void disableArm() {
+        if (backend == Backend::Rmt) {
+            rmt_axes.disableArm();
+        } else {
+            arm_axis.disable();
+        }
+    }
+
+    void disableClaw() {
+        if (backend == Backend::Rmt) {
+            rmt_axes.disableClaw();
+        } else {
+            claw_axis.disable();
+        }
+    }
 };
 
 }// namespace zms
@@ -1,14 +1,22 @@
 #pragma once
 
-#include <Arduino.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <kf/Logger.hpp>
 #include <kf/tools/validation.hpp>
 #include <kf/units.hpp>
+#include <type_traits>
 
+#include "zms/hal/Hal.hpp"
+#include "zms/tools/DoubleBuffer.hpp"
+#include "zms/tools/FixedPoint.hpp"
+#include "zms/tools/Trace.hpp"
 
 namespace zms {
 
-/// @brief Драйвер мотора (IArduino Motor Shield)
-struct Motor {
+/// @brief Типы и настройки драйвера мотора (общие для всех вариантов подключения)
+struct MotorBase {
 
     /// @brief Псевдоним типа для значения ШИМ
     using SignedPwm = kf::i16;
@@ -20,8 +28,24 @@ struct Motor {
 
         /// @brief Реализация драйвера моторов на H-Мосте L298nModule
         L298nModule = 0x01,
+
+        /// @brief H-мост с двумя входами на MCPWM: моторы - операторы одного таймера,
+        /// скважности обоих обновляются на одной границе периода (setPair)
+        Mcpwm = 0x02,
     };
 
+    /// @brief Поведение H-моста в паузе ШИМ и при нулевой команде (L298nModule, Mcpwm)
+    enum class StopMode : kf::u8 {
+        /// @brief Выбег: оба входа низкие, ток спадает быстро
+        Coast = 0x00,
+
+        /// @brief Торможение: оба входа высокие (закоротка обмотки), ток спадает медленно
+        Brake = 0x01,
+    };
+
+    /// @brief Пин не используется
+    static constexpr kf::u8 no_pin = 0xFF;
+
     /// @brief Определяет направление положительного вращения
     enum class Direction : kf::u8 {
         /// @brief Положительное вращение - по часовой
@@ -41,18 +65,22 @@ struct Motor {
         Direction direction;
 
         /// @brief IArduino Motor Shield: Пин направления (H-bridge)
-        /// @brief L293N Module: IN1 / IN3
+        /// @brief L293N Module, MCPWM: IN1 / IN3
         kf::u8 pin_a;
 
         /// @brief IArduino Motor Shield: Пин скорости (Enable)
-        /// @brief L293N Module: IN2 / IN4
+        /// @brief L293N Module, MCPWM: IN2 / IN4
         kf::u8 pin_b;
 
-        /// @brief Канал (0 .. 15)
+        /// @brief Канал LEDC (0 .. 15); MCPWM - оператор (0 .. 1, оператор 2 - точка выборки)
         kf::u8 ledc_channel;
 
         void check(kf::tools::Validator &validator) const {
             kf_Validator_check(validator, ledc_channel <= 15);
+
+            if (impl == DriverImpl::Mcpwm) {
+                kf_Validator_check(validator, ledc_channel < sample_operator);
+            }
         }
     };
 
@@ -70,6 +98,15 @@ struct Motor {
         /// @brief Разрешение (8 .. 12)
         kf::u8 ledc_resolution_bits;
 
+        /// @brief Поведение в паузе ШИМ и при нулевой команде
+        StopMode stop_mode;
+
+        /// @brief MCPWM: пин импульса точки выборки (для будущего датчика тока), no_pin - нет
+        kf::u8 sample_pin;
+
+        /// @brief MCPWM: фаза точки выборки в периоде ШИМ (промилле): фронт импульса
+        kf::u16 sample_phase_permille;
+
         /// @brief Рассчитать актуальное максимальное значение ШИМ
         [[nodiscard]] inline SignedPwm maxPwm() const {
             return static_cast<SignedPwm>((1u << ledc_resolution_bits) - 1u);
@@ -79,52 +116,295 @@ struct Motor {
             kf_Validator_check(validator, dead_zone >= 0);
             kf_Validator_check(validator, ledc_resolution_bits >= 8);
             kf_Validator_check(validator, ledc_resolution_bits <= 12);
+            kf_Validator_check(validator, sample_phase_permille <= 1000);
         }
     };
 
-    /// @brief Настройки драйвера
-    const DriverSettings &driver_settings;
+    /// @brief MCPWM: оператор импульса точки выборки
+    static constexpr kf::u8 sample_operator = hal::mcpwm_operator_count - 1;
 
-    /// @brief Настройки ШИМ
-    const PwmSettings &pwm_settings;
+    /// @brief Перевести нормализованную команду в ШИМ.
+    /// Только целочисленная арифметика: одно умножение и сдвиг
+    [[nodiscard]] static constexpr SignedPwm pwmFromNormalized(NormalizedCommand value, SignedPwm dead_zone, SignedPwm pwm_span) {
+        // 1e-2 с округлением вверх: команда моста 10/1000 (Q15 327.68 -> 328) остаётся вне мёртвой зоны, 0.00999 - внутри
+        constexpr auto normalized_dead_zone = (NormalizedCommand::one + 99) / 100;
+
+        auto raw = value.raw;
+        if (raw > NormalizedCommand::one) { raw = NormalizedCommand::one; }
+        if (raw < -NormalizedCommand::one) { raw = -NormalizedCommand::one; }
+
+        const auto abs_raw = (raw < 0) ? -raw : raw;
+        if (abs_raw < normalized_dead_zone) { return 0; }
+
+        const auto ret = ((abs_raw * pwm_span) >> NormalizedCommand::fraction_bits) + dead_zone;
+        return static_cast<SignedPwm>((raw > 0) ? ret : -ret);
+    }
+
+    /// @brief Перевести нормализованное значение с плавающей точкой в ШИМ (одно преобразование в Q15)
+    [[nodiscard]] static SignedPwm pwmFromFloat(kf::f32 value, SignedPwm dead_zone, SignedPwm pwm_span) {
+        if (std::isnan(value)) { return 0; }
+
+        return pwmFromNormalized(NormalizedCommand::fromFloat(std::clamp(value, -1.0f, +1.0f)), dead_zone, pwm_span);
+    }
+
+    /// @brief Установить оба мотора сразу: на MCPWM новые скважности вступают в силу на одной границе периода.
+    /// Смена направления (уровни выходов) применяется сразу
+    template<typename L, typename R> static void setPair(L &left, float left_value, R &right, float right_value) {
+        const bool synchronous = left.isMcpwm() or right.isMcpwm();
+
+        if (synchronous) { hal::mcpwmHold(); }
+
+        left.set(left_value);
+        right.set(right_value);
+
+        if (synchronous) { hal::mcpwmCommit(); }
+    }
+};
+
+/// @brief Подключение мотора из настроек: редактируется на лету, применяется reconfigure()
+using RuntimeMotorWiring = DoubleBuffer<MotorBase::DriverSettings>;
+
+/// @brief Подключение мотора, зафиксированное при сборке (вариант робота).
+/// Реализация, пины и канал - константы: write() не ветвится по реализации и не читает настройки.
+/// Повторяет интерфейс DoubleBuffer; настройки подключения из хранилища не применяются
+template<const MotorBase::DriverSettings &wiring> struct StaticMotorWiring final {
+
+    explicit constexpr StaticMotorWiring(const MotorBase::DriverSettings &) {}
+
+    [[nodiscard]] static constexpr const MotorBase::DriverSettings &active() { return wiring; }
+
+    [[nodiscard]] static constexpr const MotorBase::DriverSettings &previous() { return wiring; }
+
+    [[nodiscard]] static constexpr const MotorBase::DriverSettings &pending() { return wiring; }
+
+    [[nodiscard]] static constexpr bool changed() { return false; }
+
+    static constexpr void swap() {}
+};
+
+/// @brief Драйвер мотора (IArduino Motor Shield, H-мост L298n, H-мост на MCPWM)
+/// @tparam Wiring Подключение: RuntimeMotorWiring или StaticMotorWiring
+template<typename Wiring> struct BasicMotor : MotorBase {
+
+    /// @brief Подключение известно при сборке
+    static constexpr bool fixed_wiring = not std::is_same_v<Wiring, RuntimeMotorWiring>;
 
 private:
+    /// @brief Настройки драйвера (редактируемые + активные)
+    Wiring driver_settings;
+
+    /// @brief Настройки ШИМ (редактируемые + активные)
+    DoubleBuffer<PwmSettings> pwm_settings;
+
     /// @brief Максимальное значение ШИМ
     SignedPwm max_pwm{0};
 
+    /// @brief Рабочий диапазон ШИМ над мёртвой зоной (max_pwm - dead_zone)
+    SignedPwm pwm_span{0};
+
+    /// @brief Мёртвая зона ШИМ (копия активной настройки)
+    SignedPwm dead_zone{0};
+
+    /// @brief Поведение в паузе ШИМ (копия активной настройки)
+    StopMode stop_mode{StopMode::Coast};
+
+    /// @brief Последнее записанное значение ШИМ
+    SignedPwm last_pwm{0};
+
+    /// @brief Длительность последней переконфигурации
+    kf::Microseconds last_reconfigure_duration{0};
+
 public:
-    explicit constexpr Motor(const DriverSettings &driver_settings, const PwmSettings &pwm_settings) :
+    explicit BasicMotor(const DriverSettings &driver_settings, const PwmSettings &pwm_settings) :
         driver_settings{driver_settings}, pwm_settings{pwm_settings} {}
 
     [[nodiscard]] bool init() {
-        max_pwm = pwm_settings.maxPwm();
+        driver_settings.swap();
+        pwm_settings.swap();
+
+        return setupHardware();
+    }
+
+    /// @brief Применить изменившиеся настройки без полной переинициализации.
+    /// Перенастраивается только то, что действительно изменилось:
+    /// смена направления не трогает периферию, смена частоты меняет только делитель LEDC,
+    /// и лишь смена реализации драйвера, пинов или канала требует полной инициализации
+    /// @returns false, если требуемая переинициализация завершилась ошибкой
+    [[nodiscard]] bool reconfigure() {
+        const bool driver_changed = driver_settings.changed();
+        const bool pwm_changed = pwm_settings.changed();
+
+        if (not driver_changed and not pwm_changed) { return true; }
+
+        if (not driver_settings.pending().isValid() or not pwm_settings.pending().isValid()) {
+            // Некорректное промежуточное значение из UI: продолжаем работать на активных настройках
+            return true;
+        }
+
+        const auto start = hal::nowMicros();
+        bool ok = true;
+
+        if (driver_changed) { driver_settings.swap(); }
+        if (pwm_changed) { pwm_settings.swap(); }
+
+        const auto &driver = driver_settings.active();
+        const auto &pwm = pwm_settings.active();
+
+        if (driver_changed and requiresFullInit(driver_settings.previous(), driver)) {
+            releasePins(driver_settings.previous());
+            // Буферы уже переключены: повторный swap() в init() затёр бы previous()
+            ok = setupHardware();
+        } else if (pwm_changed) {
+            updateScale();
+
+            const auto &previous_pwm = pwm_settings.previous();
+            const bool frequency_changed =
+                previous_pwm.ledc_frequency_hz != pwm.ledc_frequency_hz or
+                previous_pwm.ledc_resolution_bits != pwm.ledc_resolution_bits;
+
+            if (frequency_changed) {
+                switch (driver.impl) {
+                    case DriverImpl::IArduino:
+                        ok = 0 != hal::ledcChangeFrequency(driver.ledc_channel, pwm.ledc_frequency_hz, pwm.ledc_resolution_bits);
+                        break;
+
+                    case DriverImpl::L298nModule:
+                        hal::analogOutConfigure(pwm.ledc_frequency_hz, pwm.ledc_resolution_bits);
+                        break;
+
+                    case DriverImpl::Mcpwm:
+                        ok = 0 != hal::mcpwmConfigure(pwm.ledc_frequency_hz);
+                        break;
+                }
+            }
+
+            const bool sample_changed =
+                previous_pwm.sample_pin != pwm.sample_pin or
+                previous_pwm.sample_phase_permille != pwm.sample_phase_permille;
+
+            if (driver.impl == DriverImpl::Mcpwm and sample_changed) {
+                if (previous_pwm.sample_pin != no_pin) { hal::mcpwmDetach(previous_pwm.sample_pin); }
+                ok = ok and initSamplePoint(pwm);
+            }
+
+            // Повторить последнюю команду в новом масштабе ШИМ
+            write(last_pwm);
+        } else {
+            // Изменилось только направление: следующая запись уже учтёт его
+            write(last_pwm);
+        }
+
+        last_reconfigure_duration = static_cast<kf::Microseconds>(hal::nowMicros() - start);
+        kf_Logger_debug("reconfigured in %d us", static_cast<int>(last_reconfigure_duration));
+
+        if (not ok) { kf_Logger_error("reconfigure failed"); }
+        return ok;
+    }
 
-        pinMode(driver_settings.pin_a, OUTPUT);
-        pinMode(driver_settings.pin_b, OUTPUT);
+    /// @brief Последнее записанное значение ШИМ (со знаком направления)
+    [[nodiscard]] inline SignedPwm lastPwm() const { return last_pwm; }
 
-        switch (driver_settings.impl) {
+    /// @brief Длительность последней переконфигурации
+    [[nodiscard]] inline kf::Microseconds lastReconfigureDuration() const {
+        return last_reconfigure_duration;
+    }
+
+    /// @brief Активные настройки драйвера
+    [[nodiscard]] inline const DriverSettings &driverSettings() const { return driver_settings.active(); }
+
+    /// @brief Активные настройки ШИМ
+    [[nodiscard]] inline const PwmSettings &pwmSettings() const { return pwm_settings.active(); }
+
+    /// @brief Установить значение в нормализованной величине
+    void set(float value) {
+        write(pwmFromFloat(value, dead_zone, pwm_span));
+    }
+
+    /// @brief Установить значение в нормализованной величине (фиксированная точка)
+    inline void setNormalized(NormalizedCommand value) {
+        write(pwmFromNormalized(value, dead_zone, pwm_span));
+    }
+
+    /// @brief Остановить мотор
+    inline void stop() {
+        write(0);
+    }
+
+    /// @brief Установить значение ШИМ + направление
+    /// @param pwm Значение - ШИМ, Знак - направление
+    void write(SignedPwm pwm) {
+        zms_trace_scope(TracePoint::MotorWrite, driver_settings.active().pin_a);
+
+        pwm = std::clamp<SignedPwm>(pwm, -max_pwm, max_pwm);
+        last_pwm = pwm;
+
+        if constexpr (fixed_wiring) {
+            writeAs<Wiring::active().impl>(Wiring::active(), pwm);
+        } else {
+            const auto &driver = driver_settings.active();
+
+            switch (driver.impl) {
+                case DriverImpl::IArduino:
+                    writeAs<DriverImpl::IArduino>(driver, pwm);
+                    return;
+
+                case DriverImpl::L298nModule:
+                    writeAs<DriverImpl::L298nModule>(driver, pwm);
+                    return;
+
+                case DriverImpl::Mcpwm:
+                    writeAs<DriverImpl::Mcpwm>(driver, pwm);
+                    return;
+            }
+        }
+    }
+
+    /// @brief Мотор на MCPWM (участвует в синхронном обновлении setPair)
+    [[nodiscard]] inline bool isMcpwm() const { return driver_settings.active().impl == DriverImpl::Mcpwm; }
+
+private:
+    /// @brief Настроить пины и периферию по активным настройкам (буферы не переключаются)
+    [[nodiscard]] bool setupHardware() {
+        const auto &driver = driver_settings.active();
+        const auto &pwm = pwm_settings.active();
+
+        updateScale();
+
+        hal::gpioMode(driver.pin_a, hal::PinMode::Output);
+        hal::gpioMode(driver.pin_b, hal::PinMode::Output);
+
+        switch (driver.impl) {
             case DriverImpl::IArduino: {
                 kf_Logger_debug("IArduino mode");
 
-                const auto current_frequency = ledcSetup(
-                    driver_settings.ledc_channel,
-                    pwm_settings.ledc_frequency_hz,
-                    pwm_settings.ledc_resolution_bits);
+                const auto current_frequency = hal::ledcSetup(
+                    driver.ledc_channel,
+                    pwm.ledc_frequency_hz,
+                    pwm.ledc_resolution_bits);
 
                 if (current_frequency == 0) {
                     kf_Logger_error("LEDC setup failed!");
                     return false;
                 }
 
-                ledcAttachPin(driver_settings.pin_b, driver_settings.ledc_channel);
+                hal::ledcAttach(driver.pin_b, driver.ledc_channel);
             }
                 break;
 
             case DriverImpl::L298nModule: {
                 kf_Logger_debug("L293n mode");
 
-                analogWriteFrequency(pwm_settings.ledc_frequency_hz);
-                analogWriteResolution(pwm_settings.ledc_resolution_bits);
+                hal::analogOutConfigure(pwm.ledc_frequency_hz, pwm.ledc_resolution_bits);
+            }
+                break;
+
+            case DriverImpl::Mcpwm: {
+                kf_Logger_debug("MCPWM mode");
+
+                if (not initMcpwm(driver, pwm)) {
+                    kf_Logger_error("MCPWM setup failed!");
+                    return false;
+                }
             }
                 break;
         }
@@ -135,60 +415,107 @@ public:
         return true;
     }
 
-    /// @brief Установить значение в нормализованной величине
-    void set(float value) const {
-        write(fromNormalized(value));
-    }
+    /// @brief Запись ШИМ для заданной реализации драйвера
+    template<DriverImpl impl> inline void writeAs(const DriverSettings &driver, SignedPwm pwm) {
+        if constexpr (impl == DriverImpl::IArduino) {
+            hal::gpioWrite(driver.pin_a, matchDirection(driver, pwm));
+            hal::ledcWrite(driver.ledc_channel, std::abs(pwm));
 
-    /// @brief Остановить мотор
-    inline void stop() const {
-        write(0);
-    }
+        } else if constexpr (impl == DriverImpl::L298nModule) {
+            if (pwm == 0 and stop_mode == StopMode::Brake) {
+                hal::analogOutWrite(driver.pin_a, max_pwm);
+                hal::analogOutWrite(driver.pin_b, max_pwm);
+                return;
+            }
 
-    /// @brief Установить значение ШИМ + направление
-    /// @param pwm Значение - ШИМ, Знак - направление
-    void write(SignedPwm pwm) const {
-        pwm = constrain(pwm, -max_pwm, max_pwm);
+            if (matchDirection(driver, pwm)) {
+                hal::analogOutWrite(driver.pin_a, std::abs(pwm));
+                hal::analogOutWrite(driver.pin_b, 0);
+            } else {
+                hal::analogOutWrite(driver.pin_a, 0);
+                hal::analogOutWrite(driver.pin_b, std::abs(pwm));
+            }
 
-        switch (driver_settings.impl) {
+        } else {
+            const auto max = static_cast<kf::u32>(max_pwm);
 
-            case DriverImpl::IArduino: {
-                digitalWrite(driver_settings.pin_a, matchDirection(pwm));
-                ledcWrite(driver_settings.ledc_channel, std::abs(pwm));
-            }
+            if (pwm == 0) {
+                const auto level = stop_mode == StopMode::Brake ? hal::McpwmLevel::High : hal::McpwmLevel::Low;
+                hal::mcpwmWrite(driver.ledc_channel, level, level, 0, max);
                 return;
+            }
 
-            case DriverImpl::L298nModule: {
-                const bool positive_direction = matchDirection(pwm);
-                if (positive_direction) {
-                    analogWrite(driver_settings.pin_a, std::abs(pwm));
-                    analogWrite(driver_settings.pin_b, 0);
-                } else {
-                    analogWrite(driver_settings.pin_a, 0);
-                    analogWrite(driver_settings.pin_b, std::abs(pwm));
-                }
+            // Ведущий вход ШИМ-ит, второй держит уровень паузы:
+            // выбег - импульс высокий, пауза "оба низкие"; торможение - импульс низкий на втором входе, пауза "оба высокие"
+            const auto duty = static_cast<kf::u32>(std::abs(pwm));
+            const auto drive = stop_mode == StopMode::Brake ? hal::McpwmLevel::High : hal::McpwmLevel::Pwm;
+            const auto hold = stop_mode == StopMode::Brake ? hal::McpwmLevel::PwmInverted : hal::McpwmLevel::Low;
+
+            if (matchDirection(driver, pwm)) {
+                hal::mcpwmWrite(driver.ledc_channel, drive, hold, duty, max);
+            } else {
+                hal::mcpwmWrite(driver.ledc_channel, hold, drive, duty, max);
             }
-                return;
         }
     }
 
-private:
-    [[nodiscard]] inline bool matchDirection(SignedPwm pwm) const {
+    /// @brief Таймер MCPWM (общий для моторов, повторная настройка безвредна), оператор мотора, точка выборки
+    [[nodiscard]] static bool initMcpwm(const DriverSettings &driver, const PwmSettings &pwm) {
+        if (0 == hal::mcpwmConfigure(pwm.ledc_frequency_hz)) { return false; }
+        if (not hal::mcpwmAttach(driver.ledc_channel, driver.pin_a, driver.pin_b)) { return false; }
+
+        return initSamplePoint(pwm);
+    }
+
+    /// @brief Импульс точки выборки: фронт на заданной фазе периода общего таймера
+    [[nodiscard]] static bool initSamplePoint(const PwmSettings &pwm) {
+        if (pwm.sample_pin == no_pin) { return true; }
+        if (not hal::mcpwmAttach(sample_operator, pwm.sample_pin, no_pin)) { return false; }
+
+        hal::mcpwmWrite(sample_operator, hal::McpwmLevel::PwmInverted, hal::McpwmLevel::Low, pwm.sample_phase_permille, 1000);
+        return true;
+    }
+
+    [[nodiscard]] static inline bool matchDirection(const DriverSettings &driver, SignedPwm pwm) {
         const bool positive = pwm > 0;
-        return driver_settings.direction == Direction::CW == positive;
+        return driver.direction == Direction::CW == positive;
     }
 
-    [[nodiscard]] SignedPwm fromNormalized(float value) const {
-        constexpr auto normalized_dead_zone = 1e-2f;
+    /// @brief Требует ли смена настроек драйвера полной инициализации
+    [[nodiscard]] static bool requiresFullInit(const DriverSettings &was, const DriverSettings &now) {
+        return was.impl != now.impl or
+               was.pin_a != now.pin_a or
+               was.pin_b != now.pin_b or
+               was.ledc_channel != now.ledc_channel;
+    }
 
-        if (std::isnan(value)) { return 0; }
+    /// @brief Освободить пины прежней конфигурации
+    static void releasePins(const DriverSettings &was) {
+        if (was.impl == DriverImpl::IArduino) {
+            hal::ledcDetach(was.pin_b);
+        }
 
-        const auto abs_value = std::abs(constrain(value, -1.0f, +1.0f));
-        if (abs_value < normalized_dead_zone) { return 0; }
+        if (was.impl == DriverImpl::Mcpwm) {
+            hal::mcpwmWrite(was.ledc_channel, hal::McpwmLevel::Low, hal::McpwmLevel::Low, 0, 1);
+            hal::mcpwmDetach(was.pin_a);
+            hal::mcpwmDetach(was.pin_b);
+        }
+
+        hal::gpioWrite(was.pin_a, false);
+        hal::gpioWrite(was.pin_b, false);
+    }
 
-        const auto ret = int(abs_value * float(max_pwm - pwm_settings.dead_zone)) + pwm_settings.dead_zone;
-        return static_cast<SignedPwm>((value > 0.0f) ? ret : -ret);
+    /// @brief Обновить предрасчитанные величины ШИМ из активных настроек
+    void updateScale() {
+        const auto &pwm = pwm_settings.active();
+        max_pwm = pwm.maxPwm();
+        dead_zone = pwm.dead_zone;
+        stop_mode = pwm.stop_mode;
+        pwm_span = static_cast<SignedPwm>(max_pwm - dead_zone);
     }
 };
 
+/// @brief Драйвер мотора с подключением из настроек
+using Motor = BasicMotor<RuntimeMotorWiring>;
+
 }// namespace zms
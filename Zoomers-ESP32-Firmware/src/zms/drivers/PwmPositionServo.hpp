@@ -1,9 +1,14 @@
 #pragma once
 
-#include <Arduino.h>
+#include <algorithm>
+#include <kf/Logger.hpp>
 #include <kf/tools/validation.hpp>
 #include <kf/units.hpp>
 
+#include "zms/drivers/ServoPulseCoefficients.hpp"
+#include "zms/hal/Hal.hpp"
+#include "zms/tools/Trace.hpp"
+
 
 namespace zms {
 
@@ -22,6 +27,13 @@ struct PwmPositionServo {
             return kf::u16(t / 1000000u);
         }
 
+        /// @brief Коэффициент "мкс -> скважность" в формате Q32, округлён вверх.
+        /// Для импульсов до 4294 мкс (любой реальный сервопривод) даёт тот же результат, что и dutyFromPulseWidth, без 64-битного деления
+        [[nodiscard]] kf::u64 dutyPerMicrosecondQ32() const {
+            const auto k = kf::u64(ledc_frequency_hz) * maxDuty();
+            return ((k << 32) + 1000000u - 1u) / 1000000u;
+        }
+
         void check(kf::tools::Validator &validator) const {
             kf_Validator_check(validator, ledc_frequency_hz > 0);
             kf_Validator_check(validator, ledc_resolution_bits >= 8);
@@ -55,13 +67,14 @@ struct PwmPositionServo {
         Pulse max_position;
 
         [[nodiscard]] kf::Microseconds pulseWidthFromAngle(kf::Degrees angle) const {
-            return map(
-                constrain(angle, min_position.angle, max_position.angle),
-                min_position.angle,
-                max_position.angle,
-                static_cast<long>(min_position.pulse),
-                static_cast<long>(max_position.pulse)
-            );
+            const auto a = static_cast<long>(std::clamp(angle, min_position.angle, max_position.angle));
+            const auto a_min = static_cast<long>(min_position.angle);
+            const auto a_max = static_cast<long>(max_position.angle);
+            const auto p_min = static_cast<long>(min_position.pulse);
+            const auto p_max = static_cast<long>(max_position.pulse);
+
+            // Как Arduino map()
+            return static_cast<kf::Microseconds>((a - a_min) * (p_max - p_min) / (a_max - a_min) + p_min);
         }
 
         void check(kf::tools::Validator &validator) const {
@@ -76,6 +89,12 @@ private:
     const DriverSettings &driver_settings;
     const PulseSettings &pulse_settings;
 
+    /// @brief Предрасчитанные коэффициенты "угол -> импульс"
+    ServoPulseCoefficients coefficients{};
+
+    /// @brief Предрасчитанный коэффициент "мкс -> скважность" (Q32)
+    kf::u64 duty_per_us_q32{0};
+
 public:
     explicit constexpr PwmPositionServo(
         const PwmSettings &pwm_settings,
@@ -84,8 +103,10 @@ public:
     ) :
         driver_settings{driver_settings}, pwm_settings(pwm_settings), pulse_settings(pulse_settings) {}
 
-    [[nodiscard]] bool init() const {
-        const auto freq = ledcSetup(
+    [[nodiscard]] bool init() {
+        updateCoefficients();
+
+        const auto freq = hal::ledcSetup(
             driver_settings.ledc_channel,
             pwm_settings.ledc_frequency_hz,
             pwm_settings.ledc_resolution_bits
@@ -96,13 +117,27 @@ public:
             return false;
         }
 
-        ledcAttachPin(driver_settings.signal_pin, driver_settings.ledc_channel);
+        hal::ledcAttach(driver_settings.signal_pin, driver_settings.ledc_channel);
 
         return true;
     }
 
+    /// @brief Рассчитать коэффициенты по текущим настройкам (вызывается из init)
+    void updateCoefficients() {
+        coefficients = ServoPulseCoefficients::calculate(
+            static_cast<kf::i32>(pulse_settings.min_position.pulse),
+            static_cast<kf::i32>(pulse_settings.min_position.angle),
+            static_cast<kf::i32>(pulse_settings.max_position.pulse),
+            static_cast<kf::i32>(pulse_settings.max_position.angle),
+            static_cast<kf::i32>(pulse_settings.min_position.angle),
+            static_cast<kf::i32>(pulse_settings.max_position.angle));
+
+        duty_per_us_q32 = pwm_settings.dutyPerMicrosecondQ32();
+    }
+
     void set(kf::Degrees angle) {
-        write(pwm_settings.dutyFromPulseWidth(pulse_settings.pulseWidthFromAngle(angle)));
+        const auto pulse = coefficients.pulseWidth(static_cast<kf::i32>(angle));
+        write(static_cast<kf::u16>((kf::u64(pulse) * duty_per_us_q32) >> 32));
     }
 
     void disable() {
@@ -111,7 +146,8 @@ public:
 
 private:
     void write(kf::u16 duty) const {
-        ledcWrite(driver_settings.ledc_channel, duty);
+        zms_trace_scope(TracePoint::ServoWrite, driver_settings.ledc_channel);
+        hal::ledcWrite(driver_settings.ledc_channel, duty);
     }
 };
 
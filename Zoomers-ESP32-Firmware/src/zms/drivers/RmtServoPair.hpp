@@ -0,0 +1,179 @@
+#pragma once
+
+#include <kf/Logger.hpp>
+#include <kf/tools/validation.hpp>
+
+#include "zms/drivers/PwmPositionServo.hpp"
+#include "zms/drivers/ServoPulseCoefficients.hpp"
+#include "zms/hal/Hal.hpp"
+#include "zms/tools/Trace.hpp"
+
+
+namespace zms {
+
+/// @brief Пара сервоприводов на периферии RMT.
+/// Тактирование 1 МГц (1 мкс на отсчёт) вместо ~19.5 мкс на шаг у LEDC 10 бит / 50 Гц.
+/// Каналы работают в режиме петли с одним элементом "импульс + пауза",
+/// обе оси запускаются и обновляются вместе
+struct RmtServoPair {
+
+    /// @brief Настройки каналов RMT
+    struct Settings : kf::tools::Validable<Settings> {
+        /// @brief Канал RMT оси звена (0 .. 7)
+        kf::u8 arm_channel;
+
+        /// @brief Канал RMT оси захвата (0 .. 7)
+        kf::u8 claw_channel;
+
+        void check(kf::tools::Validator &validator) const {
+            kf_Validator_check(validator, arm_channel < hal::rmt_channel_count);
+            kf_Validator_check(validator, claw_channel < hal::rmt_channel_count);
+            kf_Validator_check(validator, arm_channel != claw_channel);
+        }
+    };
+
+private:
+    /// @brief Делитель APB (80 МГц) до 1 МГц
+    static constexpr kf::u8 clock_divider = 80;
+
+    /// @brief Ось пары
+    struct Axis {
+        /// @brief Канал RMT
+        kf::u8 channel;
+
+        /// @brief Пин сигнала
+        kf::u8 pin;
+
+        /// @brief Предрасчитанные коэффициенты импульса
+        ServoPulseCoefficients coefficients;
+
+        /// @brief Длительность импульса (мкс)
+        kf::u16 pulse_us;
+
+        /// @brief Канал выдаёт импульсы
+        bool running;
+    };
+
+    const Settings &settings;
+    const PwmPositionServo::PwmSettings &pwm_settings;
+    const PwmPositionServo::PulseSettings &pulse_settings;
+    const PwmPositionServo::DriverSettings &arm_settings;
+    const PwmPositionServo::DriverSettings &claw_settings;
+
+    /// @brief Период импульсов (мкс)
+    kf::u16 period_us{20000};
+
+    Axis arm{}, claw{};
+
+    /// @brief Синхронизация обновления обеих осей
+    hal::CriticalSection lock{};
+
+public:
+    explicit RmtServoPair(
+        const Settings &settings,
+        const PwmPositionServo::PwmSettings &pwm_settings,
+        const PwmPositionServo::PulseSettings &pulse_settings,
+        const PwmPositionServo::DriverSettings &arm_settings,
+        const PwmPositionServo::DriverSettings &claw_settings
+    ) :
+        settings{settings},
+        pwm_settings{pwm_settings},
+        pulse_settings{pulse_settings},
+        arm_settings{arm_settings},
+        claw_settings{claw_settings} {}
+
+    [[nodiscard]] bool init() {
+        if (not settings.isValid()) {
+            kf_Logger_error("invalid RMT settings");
+            return false;
+        }
+
+        updateCoefficients();
+
+        arm.channel = settings.arm_channel;
+        arm.pin = arm_settings.signal_pin;
+        claw.channel = settings.claw_channel;
+        claw.pin = claw_settings.signal_pin;
+
+        if (not initChannel(arm)) { return false; }
+        if (not initChannel(claw)) { return false; }
+
+        return true;
+    }
+
+    /// @brief Установить обе оси одновременно
+    void set(kf::Degrees arm_angle, kf::Degrees claw_angle) {
+        prepare(arm, arm_angle);
+        prepare(claw, claw_angle);
+
+        lock.enter();
+        commit(arm);
+        commit(claw);
+        lock.exit();
+    }
+
+    void setArm(kf::Degrees angle) {
+        prepare(arm, angle);
+        commit(arm);
+    }
+
+    void setClaw(kf::Degrees angle) {
+        prepare(claw, angle);
+        commit(claw);
+    }
+
+    void disableArm() { stop(arm); }
+
+    void disableClaw() { stop(claw); }
+
+private:
+    /// @brief Рассчитать период и коэффициенты осей по настройкам (при инициализации)
+    void updateCoefficients() {
+        period_us = static_cast<kf::u16>(1000000u / pwm_settings.ledc_frequency_hz);
+        arm.coefficients = calculate(arm_settings);
+        claw.coefficients = calculate(claw_settings);
+    }
+
+    [[nodiscard]] ServoPulseCoefficients calculate(const PwmPositionServo::DriverSettings &axis) const {
+        return ServoPulseCoefficients::calculate(
+            static_cast<kf::i32>(pulse_settings.min_position.pulse),
+            static_cast<kf::i32>(pulse_settings.min_position.angle),
+            static_cast<kf::i32>(pulse_settings.max_position.pulse),
+            static_cast<kf::i32>(pulse_settings.max_position.angle),
+            static_cast<kf::i32>(axis.min_angle),
+            static_cast<kf::i32>(axis.max_angle));
+    }
+
+    [[nodiscard]] static bool initChannel(Axis &axis) {
+        if (not hal::rmtConfigureLoop(axis.channel, axis.pin, clock_divider)) {
+            kf_Logger_error("RMT config fail");
+            return false;
+        }
+
+        axis.running = false;
+        return true;
+    }
+
+    /// @brief Подготовить импульс (без обращения к периферии)
+    static void prepare(Axis &axis, kf::Degrees angle) {
+        axis.pulse_us = axis.coefficients.pulseWidth(static_cast<kf::i32>(angle));
+    }
+
+    /// @brief Записать элемент в память канала; в режиме петли новый импульс начнётся со следующего периода
+    void commit(Axis &axis) const {
+        zms_trace_scope(TracePoint::ServoWrite, axis.channel);
+        hal::rmtWriteLoopItem(axis.channel, axis.pulse_us, period_us - axis.pulse_us);
+
+        if (not axis.running) {
+            hal::rmtStart(axis.channel);
+            axis.running = true;
+        }
+    }
+
+    static void stop(Axis &axis) {
+        hal::rmtStop(axis.channel);
+        axis.running = false;
+    }
+};
+
+}// namespace zms
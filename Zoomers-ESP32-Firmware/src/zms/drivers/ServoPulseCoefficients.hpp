@@ -0,0 +1,70 @@
+#pragma once
+
+#include <kf/aliases.hpp>
+
+
+namespace zms {
+
+/// @brief Предрасчитанные коэффициенты "угол -> ширина импульса" одной оси.
+/// Считаются один раз при смене настроек, далее перевод угла - одно умножение и сдвиг.
+/// Не зависит от Arduino: проверяется на хосте
+struct ServoPulseCoefficients final {
+
+    /// @brief Разрядность дробной части наклона
+    static constexpr kf::u8 fraction_bits = 16;
+
+    /// @brief Нижняя граница угла оси
+    kf::i32 min_angle{0};
+
+    /// @brief Верхняя граница угла оси
+    kf::i32 max_angle{0};
+
+    /// @brief Угол опорной точки
+    kf::i32 origin_angle{0};
+
+    /// @brief Ширина импульса в опорной точке (мкс)
+    kf::i32 origin_pulse_us{0};
+
+    /// @brief Наклон (мкс/град) в формате Q16, округлён вверх:
+    /// так результат совпадает с целочисленным map() во всём диапазоне углов
+    kf::i32 slope_q16{0};
+
+    /// @brief Рассчитать коэффициенты
+    /// @param pulse_min_us Ширина импульса калибровочной точки min
+    /// @param pulse_min_angle Угол калибровочной точки min
+    /// @param pulse_max_us Ширина импульса калибровочной точки max
+    /// @param pulse_max_angle Угол калибровочной точки max
+    /// @param axis_min_angle Нижний предел оси
+    /// @param axis_max_angle Верхний предел оси
+    static constexpr ServoPulseCoefficients calculate(
+        kf::i32 pulse_min_us, kf::i32 pulse_min_angle,
+        kf::i32 pulse_max_us, kf::i32 pulse_max_angle,
+        kf::i32 axis_min_angle, kf::i32 axis_max_angle
+    ) {
+        const auto angle_span = pulse_max_angle - pulse_min_angle;
+        const auto pulse_span = pulse_max_us - pulse_min_us;
+
+        // Пределы оси не могут выходить за калибровочный диапазон (как constrain в PulseSettings)
+        const auto low = (axis_min_angle > pulse_min_angle) ? axis_min_angle : pulse_min_angle;
+        const auto high = (axis_max_angle < pulse_max_angle) ? axis_max_angle : pulse_max_angle;
+
+        return ServoPulseCoefficients{
+            low,
+            high,
+            pulse_min_angle,
+            pulse_min_us,
+            (angle_span <= 0) ? 0 : static_cast<kf::i32>(((kf::i64(pulse_span) << fraction_bits) + angle_span - 1) / angle_span),
+        };
+    }
+
+    /// @brief Ширина импульса (мкс) для угла
+    [[nodiscard]] constexpr kf::u16 pulseWidth(kf::i32 angle) const {
+        if (angle < min_angle) { angle = min_angle; }
+        if (angle > max_angle) { angle = max_angle; }
+
+        const auto offset = ((angle - origin_angle) * slope_q16) >> fraction_bits;
+        return static_cast<kf::u16>(origin_pulse_us + offset);
+    }
+};
+
+}// namespace zms
@@ -1,9 +1,10 @@
 #pragma once
 
-#include <Arduino.h>
 #include <kf/units.hpp>
 #include <kf/tools/validation.hpp>
 
+#include "zms/hal/Hal.hpp"
+
 
 namespace zms {
 
@@ -44,30 +45,35 @@ public:
     [[nodiscard]] bool init() {
         max_value = settings.maxValue();
 
-        pinMode(settings.pin, INPUT);
-        analogReadResolution(settings.resolution);
+        hal::gpioMode(settings.pin, hal::PinMode::Input);
+        hal::adcSetResolution(settings.resolution);
 
         return true;
     }
 
     /// @brief Считать значения датчика в величине АЦП 
     [[nodiscard]] inline AnalogValue readRaw() const {
-        return analogRead(settings.pin);
+        return hal::adcRead(settings.pin);
     }
 
     /// @brief Считать расстояние в миллиметрах
     [[nodiscard]] kf::Millimeters read() const {
         // 65535 / analogRead(a)
-        long sum = 0;
+        kf::u32 sum = 0;
 
         const auto n = 4;
 
         for (int i = 0; i < n; i += 1) {
             sum += readRaw();
-            delay(1);
+            hal::delayMillis(1);
         }
 
-        return (65535.0F * n) / kf::Millimeters(sum);
+        return kf::Millimeters(distanceFromSum(sum, n));
+    }
+
+    /// @brief Расстояние по сумме n отсчётов АЦП (целочисленное деление вместо деления float)
+    [[nodiscard]] static constexpr kf::u32 distanceFromSum(kf::u32 sum, kf::u32 n) {
+        return (65535u * n) / ((sum == 0) ? 1u : sum);
     }
 };
 
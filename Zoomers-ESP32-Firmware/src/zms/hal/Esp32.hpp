@@ -0,0 +1,574 @@
+#pragma once
+
+#include <Arduino.h>
+#include <algorithm>
+#include <FS.h>
+#include <LittleFS.h>
+#include <driver/gpio.h>
+#include <driver/mcpwm.h>
+#include <driver/rmt.h>
+#include <driver/uart.h>
+#include <esp_ipc.h>
+#include <esp_pm.h>
+#include <esp_sleep.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#include <hal/mcpwm_ll.h>
+#include <kf/aliases.hpp>
+#include <soc/gpio_struct.h>
+#include <soc/mcpwm_struct.h>
+
+/// @brief Атрибут обработчика прерывания (размещение в IRAM)
+#define zms_hal_isr IRAM_ATTR
+
+namespace zms::hal {
+
+// Время
+
+/// @brief Время от запуска (мкс)
+inline kf::u64 nowMicros() { return static_cast<kf::u64>(esp_timer_get_time()); }
+
+/// @brief Время от запуска (мс)
+inline kf::u32 nowMillis() { return millis(); }
+
+inline void delayMillis(kf::u32 ms) { delay(ms); }
+
+/// @brief Перезапуск контроллера
+[[noreturn]] inline void restart() { ESP.restart(); }
+
+/// @brief Счётчик тактов ядра (переполняется за ~18 с на 240 МГц: годится для разностей)
+inline kf::u32 cycleCount() { return ESP.getCycleCount(); }
+
+/// @brief Частота счётчика тактов (МГц)
+inline kf::u32 cycleFrequencyMhz() { return getCpuFrequencyMhz(); }
+
+/// @brief Уникальный идентификатор платы (заводской MAC из eFuse, 48 бит)
+inline kf::u64 chipId() { return ESP.getEfuseMac(); }
+
+// GPIO
+
+/// @brief Режим пина
+enum class PinMode : kf::u8 {
+    Input = INPUT,
+    Output = OUTPUT,
+};
+
+inline void gpioMode(kf::u8 pin, PinMode mode) { pinMode(pin, static_cast<kf::u8>(mode)); }
+
+inline void gpioWrite(kf::u8 pin, bool level) { digitalWrite(pin, level ? HIGH : LOW); }
+
+inline bool gpioRead(kf::u8 pin) { return digitalRead(pin) == HIGH; }
+
+// LEDC
+
+/// @returns Установленная частота, 0 - ошибка
+inline kf::u32 ledcSetup(kf::u8 channel, kf::u32 frequency_hz, kf::u8 resolution_bits) {
+    return ::ledcSetup(channel, frequency_hz, resolution_bits);
+}
+
+/// @returns Установленная частота, 0 - ошибка
+inline kf::u32 ledcChangeFrequency(kf::u8 channel, kf::u32 frequency_hz, kf::u8 resolution_bits) {
+    return ::ledcChangeFrequency(channel, frequency_hz, resolution_bits);
+}
+
+inline void ledcAttach(kf::u8 pin, kf::u8 channel) { ::ledcAttachPin(pin, channel); }
+
+inline void ledcDetach(kf::u8 pin) { ::ledcDetachPin(pin); }
+
+inline void ledcWrite(kf::u8 channel, kf::u32 duty) { ::ledcWrite(channel, duty); }
+
+// ШИМ по пину (analogWrite)
+
+inline void analogOutConfigure(kf::u32 frequency_hz, kf::u8 resolution_bits) {
+    analogWriteFrequency(frequency_hz);
+    analogWriteResolution(resolution_bits);
+}
+
+inline void analogOutWrite(kf::u8 pin, kf::u32 value) { analogWrite(pin, static_cast<int>(value)); }
+
+// АЦП
+
+inline void adcSetResolution(kf::u8 bits) { analogReadResolution(bits); }
+
+inline kf::u16 adcRead(kf::u8 pin) { return analogRead(pin); }
+
+// Прерывания
+
+/// @brief Фронт прерывания
+enum class Edge : kf::u8 {
+    Rising = RISING,
+    Falling = FALLING,
+};
+
+/// @brief Обработчик прерывания с аргументом
+using InterruptHandler = void (*)(void *);
+
+inline void interruptAttach(kf::u8 pin, InterruptHandler handler, void *arg, Edge edge) {
+    attachInterruptArg(pin, handler, arg, static_cast<int>(edge));
+}
+
+inline void interruptDetach(kf::u8 pin) { detachInterrupt(pin); }
+
+// RMT
+
+/// @brief Количество каналов RMT
+constexpr kf::u8 rmt_channel_count = RMT_CHANNEL_MAX;
+
+/// @brief Настроить канал RMT на передачу в режиме петли
+inline bool rmtConfigureLoop(kf::u8 channel, kf::u8 pin, kf::u8 clock_divider) {
+    rmt_config_t config = RMT_DEFAULT_CONFIG_TX(static_cast<gpio_num_t>(pin), static_cast<rmt_channel_t>(channel));
+    config.clk_div = clock_divider;
+    config.tx_config.loop_en = true;
+    config.tx_config.idle_output_en = true;
+    config.tx_config.idle_level = RMT_IDLE_LEVEL_LOW;
+
+    if (ESP_OK != rmt_config(&config)) { return false; }
+    return ESP_OK == rmt_driver_install(static_cast<rmt_channel_t>(channel), 0, 0);
+}
+
+/// @brief Записать элемент петли "высокий уровень + низкий уровень" (в отсчётах канала)
+inline void rmtWriteLoopItem(kf::u8 channel, kf::u16 high_ticks, kf::u16 low_ticks) {
+    rmt_item32_t item{};
+    item.level0 = 1;
+    item.duration0 = high_ticks;
+    item.level1 = 0;
+    item.duration1 = low_ticks;
+    rmt_fill_tx_items(static_cast<rmt_channel_t>(channel), &item, 1, 0);
+}
+
+inline void rmtStart(kf::u8 channel) { rmt_tx_start(static_cast<rmt_channel_t>(channel), true); }
+
+inline void rmtStop(kf::u8 channel) { rmt_tx_stop(static_cast<rmt_channel_t>(channel)); }
+
+// MCPWM
+
+/// @brief Количество операторов блока MCPWM 0
+constexpr kf::u8 mcpwm_operator_count = 3;
+
+/// @brief Уровень выхода генератора MCPWM
+enum class McpwmLevel : kf::u8 {
+    /// @brief Постоянно низкий
+    Low = 0x00,
+
+    /// @brief Постоянно высокий
+    High = 0x01,
+
+    /// @brief Высокий с начала периода до скважности
+    Pwm = 0x02,
+
+    /// @brief Низкий с начала периода до скважности, затем высокий
+    PwmInverted = 0x03,
+};
+
+namespace esp32 {
+
+/// @brief Состояние блока MCPWM 0, общее для настройки и записи
+struct McpwmState {
+    /// @brief Установленная частота (0 - блок не настроен)
+    kf::u32 frequency_hz{0};
+
+    /// @brief Период таймера 0 в тактах: сравнение = duty * period_ticks / max
+    kf::u32 period_ticks{0};
+
+    /// @brief Режим генераторов A, B каждого оператора: режим переключается только при смене уровня
+    McpwmLevel levels[mcpwm_operator_count][2]{};
+
+    /// @brief Режим генератора уже задан через mcpwmWrite
+    bool levels_known[mcpwm_operator_count][2]{};
+};
+
+inline McpwmState &mcpwm() {
+    static McpwmState state{};
+    return state;
+}
+
+}// namespace esp32
+
+/// @brief Настроить блок MCPWM 0: все операторы тактируются таймером 0 (одна фаза для всех выходов).
+/// Сравнения защёлкиваются из теневых регистров на нуле таймера. Повторный вызов меняет только частоту
+/// @returns Установленная частота, 0 - ошибка
+inline kf::u32 mcpwmConfigure(kf::u32 frequency_hz) {
+    auto &state = esp32::mcpwm();
+
+    if (state.frequency_hz == frequency_hz) { return state.frequency_hz; }
+
+    for (kf::u8 op = 0; op < mcpwm_operator_count; op += 1) {
+        const auto timer = static_cast<mcpwm_timer_t>(op);
+
+        if (state.frequency_hz != 0) {
+            if (ESP_OK != mcpwm_set_frequency(MCPWM_UNIT_0, timer, frequency_hz)) { return 0; }
+            continue;
+        }
+
+        mcpwm_config_t config{};
+        config.frequency = frequency_hz;
+        config.cmpr_a = 0;
+        config.cmpr_b = 0;
+        config.counter_mode = MCPWM_UP_COUNTER;
+        config.duty_mode = MCPWM_DUTY_MODE_0;
+
+        if (ESP_OK != mcpwm_init(MCPWM_UNIT_0, timer, &config)) { return 0; }
+    }
+
+    // Драйвер связывает оператор N с таймером N: переключаем все операторы на таймер 0.
+    // Таймеры 1, 2 остаются только источником периода для расчёта сравнений (та же частота)
+    MCPWM0.timer_sel.operator0_sel = 0;
+    MCPWM0.timer_sel.operator1_sel = 0;
+    MCPWM0.timer_sel.operator2_sel = 0;
+
+    state.frequency_hz = frequency_hz;
+    state.period_ticks = mcpwm_ll_timer_get_peak(&MCPWM0, 0, false);
+    return state.frequency_hz;
+}
+
+/// @brief Подключить выходы A, B оператора к пинам (пин вне диапазона GPIO - выход не подключается)
+inline bool mcpwmAttach(kf::u8 op, kf::u8 pin_a, kf::u8 pin_b) {
+    const auto attach = [op](kf::u8 generator, kf::u8 pin) {
+        if (pin >= GPIO_NUM_MAX) { return true; }
+
+        const auto signal = static_cast<mcpwm_io_signals_t>(MCPWM0A + 2 * op + generator);
+        return ESP_OK == mcpwm_gpio_init(MCPWM_UNIT_0, signal, pin);
+    };
+
+    return attach(0, pin_a) and attach(1, pin_b);
+}
+
+/// @brief Отключить пин от MCPWM (вернуть обычный выход GPIO)
+inline void mcpwmDetach(kf::u8 pin) { pinMatrixOutDetach(pin, false, false); }
+
+/// @brief Задать выходы оператора; новая скважность вступит в силу с начала следующего периода.
+/// Скважность пишется в регистры сравнения в тактах таймера; режим генератора (драйвер MCPWM)
+/// переключается, только когда меняется уровень
+/// @param duty Скважность в единицах max
+/// @param max Не больше 0xFFFF: произведение duty * period_ticks помещается в 32 бита
+inline void mcpwmWrite(kf::u8 op, McpwmLevel a, McpwmLevel b, kf::u32 duty, kf::u32 max) {
+    auto &state = esp32::mcpwm();
+    const auto timer = static_cast<mcpwm_timer_t>(op);
+    const auto compare = max == 0 ? 0 : std::min(duty, max) * state.period_ticks / max;
+
+    const auto apply = [&state, op, timer, compare](kf::u8 generator, McpwmLevel level) {
+        if (level == McpwmLevel::Pwm or level == McpwmLevel::PwmInverted) {
+            mcpwm_ll_operator_set_compare_value(&MCPWM0, op, generator, compare);
+        }
+
+        if (state.levels_known[op][generator] and state.levels[op][generator] == level) { return; }
+        state.levels[op][generator] = level;
+        state.levels_known[op][generator] = true;
+
+        const auto gen = static_cast<mcpwm_generator_t>(generator);
+
+        switch (level) {
+            case McpwmLevel::Low: mcpwm_set_signal_low(MCPWM_UNIT_0, timer, gen); return;
+            case McpwmLevel::High: mcpwm_set_signal_high(MCPWM_UNIT_0, timer, gen); return;
+            case McpwmLevel::Pwm: mcpwm_set_duty_type(MCPWM_UNIT_0, timer, gen, MCPWM_DUTY_MODE_0); return;
+            case McpwmLevel::PwmInverted: mcpwm_set_duty_type(MCPWM_UNIT_0, timer, gen, MCPWM_DUTY_MODE_1); return;
+        }
+    };
+
+    apply(MCPWM_GEN_A, a);
+    apply(MCPWM_GEN_B, b);
+}
+
+/// @brief Задержать защёлкивание сравнений всех операторов: записи копятся в теневых регистрах
+inline void mcpwmHold() {
+    MCPWM0.update_cfg.op0_up_en = 0;
+    MCPWM0.update_cfg.op1_up_en = 0;
+    MCPWM0.update_cfg.op2_up_en = 0;
+}
+
+/// @brief Разрешить защёлкивание: все накопленные сравнения вступят в силу на одной границе периода
+inline void mcpwmCommit() {
+    MCPWM0.update_cfg.op0_up_en = 1;
+    MCPWM0.update_cfg.op1_up_en = 1;
+    MCPWM0.update_cfg.op2_up_en = 1;
+}
+
+// Таймеры
+
+/// @brief Периодический программный таймер (задача esp_timer)
+struct PeriodicTimer {
+    using Callback = void (*)(void *);
+
+private:
+    esp_timer_handle_t handle{nullptr};
+
+public:
+    /// @returns false, если таймер не удалось создать или запустить
+    [[nodiscard]] bool start(const char *name, Callback callback, void *arg, kf::u32 period_us) {
+        const esp_timer_create_args_t args{
+            .callback = callback,
+            .arg = arg,
+            .dispatch_method = ESP_TIMER_TASK,
+            .name = name,
+            .skip_unhandled_events = true,
+        };
+
+        if (handle == nullptr and ESP_OK != esp_timer_create(&args, &handle)) { return false; }
+        return ESP_OK == esp_timer_start_periodic(handle, period_us);
+    }
+
+    void stop() {
+        if (handle != nullptr) { esp_timer_stop(handle); }
+    }
+};
+
+/// @brief Фоновая задача на ядре 0 (PRO_CPU, там же стек WiFi): параллельная работа при загрузке,
+/// пока основной цикл Arduino (ядро 1) настраивает периферию
+struct BackgroundTask {
+    using Function = void (*)(void *);
+
+private:
+    Function function{nullptr};
+    void *arg{nullptr};
+    SemaphoreHandle_t done{nullptr};
+
+    /// @brief Функция уже исполнена на месте (задачу создать не удалось)
+    bool finished{false};
+
+    static void entry(void *self) {
+        auto &task = *static_cast<BackgroundTask *>(self);
+        task.function(task.arg);
+        xSemaphoreGive(task.done);
+        vTaskDelete(nullptr);
+    }
+
+public:
+    /// @brief Запустить функцию в фоне; если задачу создать не удалось - исполнить на месте
+    /// @returns true - функция исполняется параллельно
+    bool start(const char *name, Function f, void *a, kf::u32 stack_bytes = 4096) {
+        function = f;
+        arg = a;
+        finished = false;
+
+        done = xSemaphoreCreateBinary();
+
+        if (done != nullptr and pdPASS == xTaskCreatePinnedToCore(entry, name, stack_bytes, this, 1, nullptr, 0)) {
+            return true;
+        }
+
+        if (done != nullptr) {
+            vSemaphoreDelete(done);
+            done = nullptr;
+        }
+
+        function(arg);
+        finished = true;
+        return false;
+    }
+
+    /// @brief Дождаться завершения функции
+    /// @returns false - тайм-аут (задача продолжает работу) или задача не запускалась
+    [[nodiscard]] bool join(kf::u32 timeout_ms) {
+        if (finished) { return true; }
+        if (done == nullptr) { return false; }
+        if (pdTRUE != xSemaphoreTake(done, pdMS_TO_TICKS(timeout_ms))) { return false; }
+
+        vSemaphoreDelete(done);
+        done = nullptr;
+        finished = true;
+        return true;
+    }
+};
+
+/// @brief Критическая секция (спин-блокировка между задачами и ядрами)
+struct CriticalSection {
+
+private:
+    portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
+
+public:
+    inline void enter() { portENTER_CRITICAL(&mux); }
+
+    inline void exit() { portEXIT_CRITICAL(&mux); }
+};
+
+// Ядра и задачи
+
+/// @brief Число ядер
+constexpr kf::u8 core_count = portNUM_PROCESSORS;
+
+/// @brief Ядро, исполняющее вызывающий код (чтение регистра, годится и в прерывании)
+inline kf::u8 coreId() { return static_cast<kf::u8>(xPortGetCoreID()); }
+
+/// @brief Идентификатор задачи
+using TaskId = const void *;
+
+/// @brief Текущая задача ядра (в прерывании - прерванная задача)
+inline TaskId currentTask() { return xTaskGetCurrentTaskHandleForCPU(xPortGetCoreID()); }
+
+/// @brief Имя текущей задачи (не из прерывания)
+inline const char *currentTaskName() { return pcTaskGetName(nullptr); }
+
+/// @brief Одновременные показания счётчика тактов ядра и времени от запуска
+struct CycleReference {
+    kf::u32 cycles;
+    kf::u64 micros;
+};
+
+/// @brief Показания на заданном ядре: счётчики тактов ядер независимы.
+/// Чужое ядро опрашивается блокирующим вызовом IPC (не из прерывания)
+inline CycleReference cycleReference(kf::u8 core) {
+    CycleReference reference{};
+
+    const auto sample = [](void *arg) {
+        auto &r = *static_cast<CycleReference *>(arg);
+        r.micros = nowMicros();
+        r.cycles = cycleCount();
+    };
+
+    if (core == coreId()) {
+        sample(&reference);
+    } else {
+        esp_ipc_call_blocking(core, sample, &reference);
+    }
+
+    return reference;
+}
+
+// Питание
+
+/// @brief Причина выхода из лёгкого сна
+enum class WakeCause : kf::u8 {
+    Timer = 0x00,
+    Uart = 0x01,
+    Gpio = 0x02,
+    Other = 0x03,
+};
+
+/// @brief Наибольшее число пинов пробуждения
+constexpr kf::u8 wake_pin_count = 4;
+
+/// @brief Автоматическое управление частотой (DFS): без удерживаемой PerformanceLock частота падает до min_mhz
+/// @param light_sleep Автоматический лёгкий сон в простое (требует tickless idle в сборке ESP-IDF)
+/// @returns false - не поддерживается сборкой (частота - вручную, cpuFrequencySet)
+inline bool powerConfigure(kf::u16 max_mhz, kf::u16 min_mhz, bool light_sleep) {
+    esp_pm_config_esp32_t config{};
+    config.max_freq_mhz = max_mhz;
+    config.min_freq_mhz = min_mhz;
+    config.light_sleep_enable = light_sleep;
+
+    if (ESP_OK != esp_pm_configure(&config)) { return false; }
+
+    // Автоматический сон не должен терять команды моста
+    if (light_sleep) {
+        uart_set_wakeup_threshold(UART_NUM_0, 3);
+        esp_sleep_enable_uart_wakeup(UART_NUM_0);
+    }
+
+    return true;
+}
+
+/// @brief Задать частоту ЦП вручную (без DFS)
+inline bool cpuFrequencySet(kf::u16 mhz) { return setCpuFrequencyMhz(mhz); }
+
+/// @brief Блокировка наибольшей частоты (и запрет автоматического сна) при DFS
+struct PerformanceLock {
+
+private:
+    esp_pm_lock_handle_t handle{nullptr};
+
+public:
+    /// @returns false - DFS в сборке нет
+    [[nodiscard]] bool create(const char *name) {
+        return handle != nullptr or ESP_OK == esp_pm_lock_create(ESP_PM_CPU_FREQ_MAX, 0, name, &handle);
+    }
+
+    inline void acquire() {
+        if (handle != nullptr) { esp_pm_lock_acquire(handle); }
+    }
+
+    inline void release() {
+        if (handle != nullptr) { esp_pm_lock_release(handle); }
+    }
+};
+
+/// @brief Лёгкий сон: ядра и периферия с тактированием от APB стоят, ОЗУ и состояние сохраняются.
+/// Пробуждение: тайм-аут, приём UART0 (байты пробуждения теряются), смена уровня пинов.
+/// WiFi на время сна выключен: пакеты ESP-NOW принимаются только между снами.
+/// Таймеры esp_timer во сне не срабатывают (пропущенные периоды отбрасываются)
+inline WakeCause lightSleep(kf::u32 max_us, const kf::u8 *wake_pins, kf::u8 pin_count) {
+    pin_count = std::min(pin_count, wake_pin_count);
+
+    // Исходящие байты моста должны уйти до остановки UART
+    Serial.flush();
+
+    esp_sleep_enable_timer_wakeup(max_us);
+
+    uart_set_wakeup_threshold(UART_NUM_0, 3);
+    esp_sleep_enable_uart_wakeup(UART_NUM_0);
+
+    // Пробуждение по уровню, противоположному текущему; тип прерывания фронтов восстанавливается после сна
+    kf::u8 saved_type[wake_pin_count]{};
+
+    for (kf::u8 i = 0; i < pin_count; i += 1) {
+        const auto pin = static_cast<gpio_num_t>(wake_pins[i]);
+
+        saved_type[i] = GPIO.pin[pin].int_type;
+        gpio_wakeup_enable(pin, gpio_get_level(pin) ? GPIO_INTR_LOW_LEVEL : GPIO_INTR_HIGH_LEVEL);
+    }
+
+    if (pin_count > 0) { esp_sleep_enable_gpio_wakeup(); }
+
+    esp_light_sleep_start();
+
+    for (kf::u8 i = 0; i < pin_count; i += 1) {
+        const auto pin = static_cast<gpio_num_t>(wake_pins[i]);
+
+        gpio_wakeup_disable(pin);
+        gpio_set_intr_type(pin, static_cast<gpio_int_type_t>(saved_type[i]));
+    }
+
+    esp_sleep_disable_wakeup_source(ESP_SLEEP_WAKEUP_ALL);
+
+    switch (esp_sleep_get_wakeup_cause()) {
+        case ESP_SLEEP_WAKEUP_TIMER: return WakeCause::Timer;
+        case ESP_SLEEP_WAKEUP_UART: return WakeCause::Uart;
+        case ESP_SLEEP_WAKEUP_GPIO: return WakeCause::Gpio;
+        default: return WakeCause::Other;
+    }
+}
+
+// Serial
+
+/// @brief Поток байт последовательного порта
+using Stream = ::Stream;
+
+/// @brief Основной последовательный порт (мост)
+inline Stream &serial() { return Serial; }
+
+/// @brief Настроить основной последовательный порт
+inline void serialBegin(kf::u32 baud) {
+    Serial.setDebugOutput(false);
+    Serial.setRxBufferSize(1024);
+    Serial.setTxBufferSize(1024);
+    Serial.setTimeout(10);
+    Serial.begin(baud);
+}
+
+// Флеш
+
+/// @brief Подключить файловую систему (форматирует при ошибке)
+inline bool fsBegin() { return LittleFS.begin(true); }
+
+/// @brief Запись файла во флеш
+struct FileWriter {
+
+private:
+    fs::File file;
+
+public:
+    [[nodiscard]] bool open(const char *path) {
+        file = LittleFS.open(path, FILE_WRITE);
+        return static_cast<bool>(file);
+    }
+
+    inline void write(const void *data, kf::u32 size) {
+        file.write(static_cast<const kf::u8 *>(data), size);
+    }
+
+    inline void close() { file.close(); }
+};
+
+}// namespace zms::hal
@@ -0,0 +1,28 @@
+#pragma once
+
+/// @brief Слой абстракции оборудования.
+/// Драйверы и сервисы обращаются к периферии (GPIO, LEDC, АЦП, прерывания, RMT, таймеры,
+/// критические секции, Serial, флеш) только через zms::hal.
+/// Реализация выбирается при сборке: ESP32 (Arduino + ESP-IDF) или хост (ZMS_NATIVE, окружение native)
+///
+/// Общий интерфейс (namespace zms::hal):
+/// - Время: nowMicros, nowMillis, delayMillis, restart; счётчик тактов для замеров: cycleCount, cycleFrequencyMhz
+/// - Идентификатор платы: chipId
+/// - GPIO: gpioMode, gpioWrite, gpioRead
+/// - LEDC: ledcSetup, ledcChangeFrequency, ledcAttach, ledcDetach, ledcWrite
+/// - ШИМ драйвера L298n: analogOutConfigure, analogOutWrite
+/// - АЦП: adcSetResolution, adcRead
+/// - Прерывания: interruptAttach, interruptDetach, атрибут обработчика zms_hal_isr
+/// - RMT: rmtConfigureLoop, rmtWriteLoopItem, rmtStart, rmtStop
+/// - MCPWM (операторы на общем таймере): mcpwmConfigure, mcpwmAttach, mcpwmDetach, mcpwmWrite, mcpwmHold, mcpwmCommit
+/// - PeriodicTimer, BackgroundTask (параллельная работа при загрузке), CriticalSection
+/// - Ядра и задачи: core_count, coreId, TaskId, currentTask, currentTaskName, cycleReference (такты ядра и время)
+/// - Питание: powerConfigure (DFS), cpuFrequencySet, PerformanceLock, lightSleep
+/// - Serial: Stream, serial()
+/// - Флеш: fsBegin, FileWriter
+
+#if defined(ZMS_NATIVE)
+#include "zms/hal/Native.hpp"
+#else
+#include "zms/hal/Esp32.hpp"
+#endif
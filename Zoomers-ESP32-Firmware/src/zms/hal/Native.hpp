@@ -0,0 +1,545 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <vector>
+
+#include <kf/aliases.hpp>
+
+/// @brief Атрибут обработчика прерывания (на хосте не требуется)
+#define zms_hal_isr
+
+/// @brief Номера GPIO (как в driver/gpio.h), чтобы настройки по умолчанию собирались на хосте
+enum gpio_num_t : kf::u8 {
+    GPIO_NUM_0 = 0, GPIO_NUM_1, GPIO_NUM_2, GPIO_NUM_3, GPIO_NUM_4, GPIO_NUM_5, GPIO_NUM_6, GPIO_NUM_7,
+    GPIO_NUM_8, GPIO_NUM_9, GPIO_NUM_10, GPIO_NUM_11, GPIO_NUM_12, GPIO_NUM_13, GPIO_NUM_14, GPIO_NUM_15,
+    GPIO_NUM_16, GPIO_NUM_17, GPIO_NUM_18, GPIO_NUM_19, GPIO_NUM_20, GPIO_NUM_21, GPIO_NUM_22, GPIO_NUM_23,
+    GPIO_NUM_24, GPIO_NUM_25, GPIO_NUM_26, GPIO_NUM_27, GPIO_NUM_28, GPIO_NUM_29, GPIO_NUM_30, GPIO_NUM_31,
+    GPIO_NUM_32, GPIO_NUM_33, GPIO_NUM_34, GPIO_NUM_35, GPIO_NUM_36, GPIO_NUM_37, GPIO_NUM_38, GPIO_NUM_39,
+    GPIO_NUM_MAX,
+};
+
+namespace zms::hal {
+
+/// @brief Режим пина
+enum class PinMode : kf::u8 {
+    Input = 0x01,
+    Output = 0x03,
+};
+
+/// @brief Фронт прерывания
+enum class Edge : kf::u8 {
+    Rising = 0x01,
+    Falling = 0x02,
+};
+
+/// @brief Обработчик прерывания с аргументом
+using InterruptHandler = void (*)(void *);
+
+/// @brief Количество каналов RMT
+constexpr kf::u8 rmt_channel_count = 8;
+
+/// @brief Количество операторов блока MCPWM 0
+constexpr kf::u8 mcpwm_operator_count = 3;
+
+/// @brief Уровень выхода генератора MCPWM
+enum class McpwmLevel : kf::u8 {
+    Low = 0x00,
+    High = 0x01,
+    Pwm = 0x02,
+    PwmInverted = 0x03,
+};
+
+struct PeriodicTimer;
+
+/// @brief Поток байт (подмножество интерфейса Arduino Stream, сигнатуры совпадают)
+struct Stream {
+    virtual ~Stream() = default;
+
+    virtual int available() = 0;
+
+    virtual int read() = 0;
+
+    virtual int peek() = 0;
+
+    virtual std::size_t write(kf::u8 byte) = 0;
+
+    virtual std::size_t write(const kf::u8 *buffer, std::size_t size) {
+        for (std::size_t i = 0; i < size; i += 1) { write(buffer[i]); }
+        return size;
+    }
+
+    virtual void flush() {}
+};
+
+/// @brief Хостовая реализация: фейковая плата с наблюдаемым состоянием.
+/// Время виртуальное и идёт только через advance(), поэтому прогон детерминирован
+namespace native {
+
+/// @brief Поток последовательного порта: хост дописывает входящие байты и забирает исходящие
+struct SerialStream final : Stream {
+    std::deque<kf::u8> rx, tx;
+
+    int available() override { return static_cast<int>(rx.size()); }
+
+    int read() override {
+        if (rx.empty()) { return -1; }
+        const auto byte = rx.front();
+        rx.pop_front();
+        return byte;
+    }
+
+    int peek() override { return rx.empty() ? -1 : rx.front(); }
+
+    std::size_t write(kf::u8 byte) override {
+        tx.push_back(byte);
+        return 1;
+    }
+
+    using Stream::write;
+};
+
+/// @brief Состояние фейковой платы
+struct Board {
+    static constexpr kf::u8 pin_count = GPIO_NUM_MAX;
+    static constexpr kf::u8 ledc_channel_count = 16;
+
+    struct LedcChannel {
+        kf::u32 frequency_hz;
+        kf::u8 resolution_bits;
+        kf::u32 duty;
+    };
+
+    struct Interrupt {
+        InterruptHandler handler;
+        void *arg;
+        Edge edge;
+    };
+
+    struct RmtChannel {
+        kf::u8 pin;
+        kf::u16 high_ticks, low_ticks;
+        bool running;
+    };
+
+    /// @brief Выходы оператора MCPWM
+    struct McpwmOutputs {
+        McpwmLevel a, b;
+        kf::u32 duty, max;
+    };
+
+    struct McpwmOperator {
+        kf::i8 pin_a, pin_b;
+
+        /// @brief Действующие выходы (меняются на границе периода)
+        McpwmOutputs active;
+
+        /// @brief Записанные, но ещё не защёлкнутые (mcpwmHold)
+        McpwmOutputs pending;
+    };
+
+    /// @brief Виртуальное время (мкс)
+    kf::u64 time_us{0};
+
+    PinMode pin_mode[pin_count]{};
+    bool pin_level[pin_count]{};
+
+    /// @brief Канал LEDC, подключённый к пину (-1 - нет)
+    kf::i8 pin_ledc[pin_count]{};
+
+    LedcChannel ledc[ledc_channel_count]{};
+
+    kf::u32 analog_out[pin_count]{};
+    kf::u32 analog_out_frequency_hz{0};
+    kf::u8 analog_out_resolution_bits{8};
+
+    /// @brief Значения АЦП, задаваемые тестом
+    kf::u16 adc[pin_count]{};
+    kf::u8 adc_resolution_bits{12};
+
+    Interrupt interrupts[pin_count]{};
+
+    RmtChannel rmt[rmt_channel_count]{};
+
+    kf::u32 mcpwm_frequency_hz{0};
+    McpwmOperator mcpwm[mcpwm_operator_count]{};
+
+    /// @brief Защёлкивание сравнений MCPWM задержано
+    bool mcpwm_held{false};
+
+    std::vector<PeriodicTimer *> timers{};
+
+    SerialStream serial{};
+
+    /// @brief Идентификатор платы (задаётся тестом, несколько фейковых роботов различаются им)
+    kf::u64 chip_id{0x5A4D5300'0001};
+
+    /// @brief Частота ЦП, заданная прошивкой (МГц)
+    kf::u16 cpu_frequency_mhz{240};
+
+    /// @brief Число входов в лёгкий сон
+    kf::u32 light_sleeps{0};
+
+    /// @brief Задачи фейковой платы: основной цикл и таймеры (имя - и идентификатор)
+    static constexpr const char *loop_task = "loopTask";
+    static constexpr const char *timer_task = "esp_timer";
+
+    /// @brief Текущая задача
+    const char *task{loop_task};
+
+    Board() {
+        std::fill(std::begin(pin_ledc), std::end(pin_ledc), kf::i8(-1));
+
+        for (auto &op: mcpwm) { op.pin_a = op.pin_b = -1; }
+    }
+};
+
+inline Board &board() {
+    static Board instance{};
+    return instance;
+}
+
+/// @brief Установить уровень входа; на заданном фронте вызывается обработчик прерывания
+inline void setPin(kf::u8 pin, bool level) {
+    auto &b = board();
+    const bool was = b.pin_level[pin];
+    b.pin_level[pin] = level;
+
+    const auto &interrupt = b.interrupts[pin];
+    if (interrupt.handler == nullptr or was == level) { return; }
+
+    const bool rising = level;
+    if (rising == (interrupt.edge == Edge::Rising)) { interrupt.handler(interrupt.arg); }
+}
+
+/// @brief Задать значение АЦП пина
+inline void setAdc(kf::u8 pin, kf::u16 value) { board().adc[pin] = value; }
+
+/// @brief Продвинуть виртуальное время, вызывая таймеры в порядке срабатывания
+inline void advance(kf::u64 us);
+
+}// namespace native
+
+// Время
+
+inline kf::u64 nowMicros() { return native::board().time_us; }
+
+inline kf::u32 nowMillis() { return static_cast<kf::u32>(native::board().time_us / 1000u); }
+
+/// @brief Задержка сдвигает время, но не вызывает таймеры (как блокировка основного цикла)
+inline void delayMillis(kf::u32 ms) { native::board().time_us += kf::u64(ms) * 1000u; }
+
+[[noreturn]] inline void restart() { std::exit(EXIT_FAILURE); }
+
+/// @brief Счётчик "тактов" хоста - наносекунды реальных часов, а не виртуального времени платы:
+/// используется только для замеров производительности
+inline kf::u32 cycleCount() {
+    const auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<kf::u32>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+}
+
+/// @brief Частота счётчика тактов (МГц): на хосте такт - 1 нс
+inline kf::u32 cycleFrequencyMhz() { return 1000; }
+
+inline kf::u64 chipId() { return native::board().chip_id; }
+
+// GPIO
+
+inline void gpioMode(kf::u8 pin, PinMode mode) { native::board().pin_mode[pin] = mode; }
+
+inline void gpioWrite(kf::u8 pin, bool level) { native::board().pin_level[pin] = level; }
+
+inline bool gpioRead(kf::u8 pin) { return native::board().pin_level[pin]; }
+
+// LEDC
+
+inline kf::u32 ledcSetup(kf::u8 channel, kf::u32 frequency_hz, kf::u8 resolution_bits) {
+    if (channel >= native::Board::ledc_channel_count or resolution_bits == 0 or resolution_bits > 20) { return 0; }
+
+    auto &c = native::board().ledc[channel];
+    c.frequency_hz = frequency_hz;
+    c.resolution_bits = resolution_bits;
+    return frequency_hz;
+}
+
+inline kf::u32 ledcChangeFrequency(kf::u8 channel, kf::u32 frequency_hz, kf::u8 resolution_bits) {
+    return ledcSetup(channel, frequency_hz, resolution_bits);
+}
+
+inline void ledcAttach(kf::u8 pin, kf::u8 channel) { native::board().pin_ledc[pin] = static_cast<kf::i8>(channel); }
+
+inline void ledcDetach(kf::u8 pin) { native::board().pin_ledc[pin] = -1; }
+
+inline void ledcWrite(kf::u8 channel, kf::u32 duty) { native::board().ledc[channel].duty = duty; }
+
+// ШИМ по пину (analogWrite)
+
+inline void analogOutConfigure(kf::u32 frequency_hz, kf::u8 resolution_bits) {
+    native::board().analog_out_frequency_hz = frequency_hz;
+    native::board().analog_out_resolution_bits = resolution_bits;
+}
+
+inline void analogOutWrite(kf::u8 pin, kf::u32 value) { native::board().analog_out[pin] = value; }
+
+// АЦП
+
+inline void adcSetResolution(kf::u8 bits) { native::board().adc_resolution_bits = bits; }
+
+inline kf::u16 adcRead(kf::u8 pin) { return native::board().adc[pin]; }
+
+// Прерывания
+
+inline void interruptAttach(kf::u8 pin, InterruptHandler handler, void *arg, Edge edge) {
+    native::board().interrupts[pin] = {handler, arg, edge};
+}
+
+inline void interruptDetach(kf::u8 pin) { native::board().interrupts[pin] = {}; }
+
+// RMT
+
+inline bool rmtConfigureLoop(kf::u8 channel, kf::u8 pin, kf::u8) {
+    if (channel >= rmt_channel_count) { return false; }
+    native::board().rmt[channel] = {pin, 0, 0, false};
+    return true;
+}
+
+inline void rmtWriteLoopItem(kf::u8 channel, kf::u16 high_ticks, kf::u16 low_ticks) {
+    auto &c = native::board().rmt[channel];
+    c.high_ticks = high_ticks;
+    c.low_ticks = low_ticks;
+}
+
+inline void rmtStart(kf::u8 channel) { native::board().rmt[channel].running = true; }
+
+inline void rmtStop(kf::u8 channel) { native::board().rmt[channel].running = false; }
+
+// MCPWM
+
+inline kf::u32 mcpwmConfigure(kf::u32 frequency_hz) { return native::board().mcpwm_frequency_hz = frequency_hz; }
+
+/// @brief Пин вне диапазона GPIO - выход не подключается (-1)
+inline bool mcpwmAttach(kf::u8 op, kf::u8 pin_a, kf::u8 pin_b) {
+    if (op >= mcpwm_operator_count) { return false; }
+
+    auto &o = native::board().mcpwm[op];
+    o.pin_a = static_cast<kf::i8>(pin_a);
+    o.pin_b = static_cast<kf::i8>(pin_b);
+    return true;
+}
+
+inline void mcpwmDetach(kf::u8 pin) {
+    for (auto &o: native::board().mcpwm) {
+        if (o.pin_a == pin) { o.pin_a = -1; }
+        if (o.pin_b == pin) { o.pin_b = -1; }
+    }
+}
+
+/// @brief Как на плате: без mcpwmHold запись действует сразу (граница ближайшего периода)
+inline void mcpwmWrite(kf::u8 op, McpwmLevel level_a, McpwmLevel level_b, kf::u32 duty, kf::u32 max) {
+    auto &b = native::board();
+    auto &o = b.mcpwm[op];
+    o.pending = {level_a, level_b, duty, max};
+
+    if (not b.mcpwm_held) { o.active = o.pending; }
+}
+
+inline void mcpwmHold() { native::board().mcpwm_held = true; }
+
+inline void mcpwmCommit() {
+    auto &b = native::board();
+    b.mcpwm_held = false;
+
+    for (auto &o: b.mcpwm) { o.active = o.pending; }
+}
+
+// Таймеры
+
+/// @brief Периодический таймер на виртуальном времени (вызывается из native::advance)
+struct PeriodicTimer {
+    using Callback = void (*)(void *);
+
+    Callback callback{nullptr};
+    void *arg{nullptr};
+    kf::u32 period_us{0};
+    kf::u64 due_us{0};
+
+    PeriodicTimer() = default;
+
+    PeriodicTimer(const PeriodicTimer &) = delete;
+
+    ~PeriodicTimer() { stop(); }
+
+    [[nodiscard]] bool start(const char *, Callback timer_callback, void *timer_arg, kf::u32 period) {
+        if (period == 0) { return false; }
+
+        stop();
+
+        callback = timer_callback;
+        arg = timer_arg;
+        period_us = period;
+        due_us = nowMicros() + period;
+        native::board().timers.push_back(this);
+        return true;
+    }
+
+    void stop() {
+        auto &timers = native::board().timers;
+        timers.erase(std::remove(timers.begin(), timers.end(), this), timers.end());
+    }
+};
+
+/// @brief Фоновая задача: на хосте функция исполняется сразу в start(), прогон остаётся детерминированным
+struct BackgroundTask {
+    using Function = void (*)(void *);
+
+private:
+    bool finished{false};
+
+public:
+    /// @returns false - функция исполнена на месте
+    bool start(const char *, Function function, void *arg, kf::u32 = 0) {
+        function(arg);
+        finished = true;
+        return false;
+    }
+
+    [[nodiscard]] bool join(kf::u32) { return finished; }
+};
+
+/// @brief Критическая секция: на хосте всё исполняется в одном потоке
+struct CriticalSection {
+    inline void enter() {}
+
+    inline void exit() {}
+};
+
+inline void native::advance(kf::u64 us) {
+    auto &b = board();
+    const auto target = b.time_us + us;
+
+    while (true) {
+        PeriodicTimer *next = nullptr;
+
+        for (auto *timer: b.timers) {
+            if (timer->due_us <= target and (next == nullptr or timer->due_us < next->due_us)) { next = timer; }
+        }
+
+        if (next == nullptr) { break; }
+
+        b.time_us = std::max(b.time_us, next->due_us);
+        next->due_us += next->period_us;
+
+        // Таймеры исполняются в своей задаче (как esp_timer на плате)
+        const auto *task = b.task;
+        b.task = Board::timer_task;
+        next->callback(next->arg);
+        b.task = task;
+    }
+
+    b.time_us = target;
+}
+
+// Ядра и задачи (на хосте одно ядро)
+
+constexpr kf::u8 core_count = 1;
+
+inline kf::u8 coreId() { return 0; }
+
+using TaskId = const void *;
+
+inline TaskId currentTask() { return native::board().task; }
+
+inline const char *currentTaskName() { return native::board().task; }
+
+struct CycleReference {
+    kf::u32 cycles;
+    kf::u64 micros;
+};
+
+/// @brief Такты - реальные наносекунды хоста, время - виртуальное: события трассы
+/// размещаются относительно виртуального времени с длительностями исполнения на хосте
+inline CycleReference cycleReference(kf::u8) { return {cycleCount(), nowMicros()}; }
+
+// Питание
+
+/// @brief Причина выхода из лёгкого сна
+enum class WakeCause : kf::u8 {
+    Timer = 0x00,
+    Uart = 0x01,
+    Gpio = 0x02,
+    Other = 0x03,
+};
+
+/// @brief Наибольшее число пинов пробуждения
+constexpr kf::u8 wake_pin_count = 4;
+
+/// @brief На хосте DFS нет: частота - вручную
+inline bool powerConfigure(kf::u16, kf::u16, bool) { return false; }
+
+inline bool cpuFrequencySet(kf::u16 mhz) {
+    native::board().cpu_frequency_mhz = mhz;
+    return true;
+}
+
+struct PerformanceLock {
+    [[nodiscard]] bool create(const char *) { return false; }
+
+    inline void acquire() {}
+
+    inline void release() {}
+};
+
+/// @brief Сон на хосте: виртуальное время идёт до тайм-аута (таймеры срабатывают), пробуждение по приёму порта
+inline WakeCause lightSleep(kf::u32 max_us, const kf::u8 *, kf::u8) {
+    auto &b = native::board();
+    b.light_sleeps += 1;
+
+    if (not b.serial.rx.empty()) { return WakeCause::Uart; }
+
+    native::advance(max_us);
+    return WakeCause::Timer;
+}
+
+// Serial
+
+inline Stream &serial() { return native::board().serial; }
+
+inline void serialBegin(kf::u32) {}
+
+// Флеш (файлы хоста относительно рабочего каталога)
+
+inline bool fsBegin() { return true; }
+
+struct FileWriter {
+
+private:
+    std::FILE *file{nullptr};
+
+public:
+    FileWriter() = default;
+
+    FileWriter(const FileWriter &) = delete;
+
+    ~FileWriter() { close(); }
+
+    [[nodiscard]] bool open(const char *path) {
+        close();
+        file = std::fopen((path[0] == '/') ? path + 1 : path, "wb");
+        return file != nullptr;
+    }
+
+    inline void write(const void *data, kf::u32 size) {
+        if (file != nullptr) { std::fwrite(data, 1, size, file); }
+    }
+
+    inline void close() {
+        if (file != nullptr) { std::fclose(file); }
+        file = nullptr;
+    }
+};
+
+}// namespace zms::hal
@@ -0,0 +1,234 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <kf/Logger.hpp>
+
+#include "zms/Periphery.hpp"
+#include "zms/hal/Hal.hpp"
+#include "zms/services/ManipulatorTrajectoryExecutor.hpp"
+#include "zms/services/ObstacleReflex.hpp"
+#include "zms/services/Odometry.hpp"
+#include "zms/tools/BehaviourVm.hpp"
+
+
+namespace zms {
+
+/// @brief Исполнитель поведений, загруженных с хоста (BehaviourVm).
+/// Программа шагает в периодическом таймере с бюджетом инструкций на шаг:
+/// датчики снимаются до шага, команды применяются после, под блокировкой - только интерпретация.
+/// Моторы - через рефлекс (защита от препятствий действует и для программ)
+struct BehaviourExecutor final {
+
+    /// @brief Снимок состояния
+    struct Status {
+        /// @brief Состояние машины
+        BehaviourVm::State state;
+
+        /// @brief Ошибка программы
+        BehaviourVm::Fault fault;
+
+        /// @brief Счётчик инструкций
+        kf::u16 pc;
+
+        /// @brief Исполнено инструкций с запуска
+        kf::u32 executed;
+
+        /// @brief Последнее значение report
+        kf::i32 report;
+    };
+
+private:
+    /// @brief Выход на моторы через рефлекс
+    ObstacleReflex &reflex;
+
+    /// @brief Бортовая одометрия
+    Odometry &odometry;
+
+    /// @brief Исполнитель траекторий манипулятора (прерывается командами программы)
+    ManipulatorTrajectoryExecutor &manipulator_executor;
+
+    /// @brief Машина
+    BehaviourVm vm{};
+
+    /// @brief Последнее значение report
+    kf::i32 report{0};
+
+    /// @brief Состояние или report изменились и ещё не сообщены
+    bool state_changed{false};
+
+    /// @brief Программа управляет моторами
+    bool driving{false};
+
+    /// @brief Бюджет инструкций на шаг
+    kf::u16 budget{1};
+
+    /// @brief Периодический таймер шага
+    hal::PeriodicTimer timer{};
+
+    /// @brief Защита машины
+    hal::CriticalSection lock{};
+
+public:
+    explicit BehaviourExecutor(ObstacleReflex &reflex, Odometry &odometry, ManipulatorTrajectoryExecutor &manipulator_executor) :
+        reflex{reflex}, odometry{odometry}, manipulator_executor{manipulator_executor} {}
+
+    /// @brief Запустить таймер шага
+    [[nodiscard]] bool init() {
+        const auto &settings = Periphery::instance().storage.settings.behaviour;
+        budget = settings.instruction_budget;
+
+        const bool started = timer.start(
+            "behaviour",
+            [](void *instance) { static_cast<BehaviourExecutor *>(instance)->tick(); },
+            this,
+            1000000u / settings.update_frequency_hz);
+
+        if (not started) {
+            kf_Logger_error("timer start fail");
+            return false;
+        }
+
+        return true;
+    }
+
+    /// @brief Загрузить фрагмент кода (исполняемая программа прерывается)
+    /// @param append false - новая программа, true - дописать к загруженной
+    /// @returns false - программа переполнена
+    [[nodiscard]] bool load(bool append, const kf::u8 *bytes, kf::u16 count) {
+        cancel();
+
+        lock.enter();
+        if (not append) { vm.clear(); }
+        const bool ok = vm.append(bytes, count);
+        state_changed = true;
+        lock.exit();
+
+        return ok;
+    }
+
+    /// @brief Проверить и запустить загруженную программу
+    /// @returns Fault::None - запущена
+    BehaviourVm::Fault run() {
+        lock.enter();
+        const auto fault = vm.start(static_cast<kf::u32>(hal::nowMicros() / 1000));
+        report = 0;
+        state_changed = true;
+        lock.exit();
+
+        return fault;
+    }
+
+    /// @brief Прервать программу.
+    /// Моторы останавливаются только если программа ими управляла; после отмены она их не трогает,
+    /// поэтому команда, ради которой отменяли, не перезаписывается остановкой
+    void cancel() {
+        lock.enter();
+
+        if (vm.cancel()) { state_changed = true; }
+
+        if (driving) {
+            driving = false;
+            reflex.stop();
+        }
+
+        lock.exit();
+    }
+
+    /// @brief Программа исполняется
+    [[nodiscard]] inline bool busy() const { return vm.getState() == BehaviourVm::State::Running; }
+
+    /// @brief Состояние изменилось с последнего снимка
+    [[nodiscard]] inline bool stateChanged() const { return state_changed; }
+
+    /// @brief Снимок состояния (сбрасывает флаг изменения)
+    [[nodiscard]] Status takeStatus() {
+        lock.enter();
+        const Status status{
+            .state = vm.getState(),
+            .fault = vm.getFault(),
+            .pc = vm.getPc(),
+            .executed = vm.getExecuted(),
+            .report = report,
+        };
+        state_changed = false;
+        lock.exit();
+
+        return status;
+    }
+
+private:
+    /// @brief Шаг программы (контекст задачи таймера)
+    void tick() {
+        const auto inputs = sense();
+        BehaviourVm::Outputs outputs{};
+
+        lock.enter();
+
+        if (not busy()) {
+            // Программа завершилась или отказала: останавливаем моторы один раз (отмена останавливает их сама)
+            if (driving) {
+                driving = false;
+                reflex.stop();
+            }
+
+            lock.exit();
+            return;
+        }
+
+        const auto state = vm.step(inputs, outputs, static_cast<kf::u32>(hal::nowMicros() / 1000), budget);
+
+        if (outputs.report) { report = outputs.report_value; }
+        if (outputs.report or state != BehaviourVm::State::Running) { state_changed = true; }
+
+        // Команды шага применяются под lock: после одновременной отмены они не перезапишут более новую команду
+        apply(outputs);
+
+        lock.exit();
+    }
+
+    /// @brief Снимок датчиков для шага
+    [[nodiscard]] BehaviourVm::Inputs sense() {
+        auto &periphery = Periphery::instance();
+        const auto pose = odometry.get().pose;
+
+        using Source = BehaviourVm::Source;
+        BehaviourVm::Inputs inputs{};
+
+        inputs.values[static_cast<kf::u8>(Source::LeftDistance)] = reflex.leftDistance();
+        inputs.values[static_cast<kf::u8>(Source::RightDistance)] = reflex.rightDistance();
+        inputs.values[static_cast<kf::u8>(Source::LeftEncoder)] = static_cast<kf::i32>(periphery.left_encoder.getPositionFixed().toFloat());
+        inputs.values[static_cast<kf::u8>(Source::RightEncoder)] = static_cast<kf::i32>(periphery.right_encoder.getPositionFixed().toFloat());
+        inputs.values[static_cast<kf::u8>(Source::PoseX)] = static_cast<kf::i32>(pose.x);
+        inputs.values[static_cast<kf::u8>(Source::PoseY)] = static_cast<kf::i32>(pose.y);
+        inputs.values[static_cast<kf::u8>(Source::Heading)] = static_cast<kf::i32>(pose.heading * static_cast<kf::f32>(180.0 / M_PI));
+
+        return inputs;
+    }
+
+    /// @brief Применить команды шага (под lock)
+    void apply(const BehaviourVm::Outputs &outputs) {
+        if (outputs.drive) {
+            constexpr kf::i32 max_value = 1000;
+
+            driving = true;
+            reflex.set(
+                kf::f32(std::clamp(outputs.left, -max_value, max_value)) / kf::f32(max_value),
+                kf::f32(std::clamp(outputs.right, -max_value, max_value)) / kf::f32(max_value));
+        }
+
+        if (outputs.arm or outputs.claw) {
+            auto &manipulator = Periphery::instance().manipulator;
+
+            // Программа имеет приоритет над траекторией; профиль продолжит с заданных углов
+            manipulator_executor.cancel();
+
+            if (outputs.arm) { manipulator.setArm(static_cast<kf::Degrees>(std::clamp(outputs.arm_angle, 0, 180))); }
+            if (outputs.claw) { manipulator.setClaw(static_cast<kf::Degrees>(std::clamp(outputs.claw_angle, 0, 180))); }
+
+            manipulator_executor.rehome(manipulator.armAngle(), manipulator.clawAngle());
+        }
+    }
+};
+
+}// namespace zms
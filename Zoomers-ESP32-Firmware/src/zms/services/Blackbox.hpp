@@ -0,0 +1,282 @@
+#pragma once
+
+#include <kf/Logger.hpp>
+
+#include "zms/Periphery.hpp"
+#include "zms/hal/Hal.hpp"
+#include "zms/services/ObstacleReflex.hpp"
+#include "zms/tools/BlackboxRing.hpp"
+
+
+namespace zms {
+
+/// @brief Бортовой самописец.
+/// Пишет отсчёты с частотой контура управления в кольцевой буфер ОЗУ;
+/// по триггеру (команда, сбой, рефлекс) замораживает окно до и после события
+struct Blackbox final {
+
+    /// @brief Настройки самописца
+    using Settings = BlackboxSettings;
+
+    /// @brief Отсчёт самописца (упакован: выгружается по мосту как есть)
+    struct __attribute__((packed)) Sample {
+        /// @brief Бортовое время (мкс, младшие 32 бита)
+        kf::u32 timestamp_us;
+
+        /// @brief Положения энкодеров (отсчёты)
+        Encoder::Ticks left_ticks, right_ticks;
+
+        /// @brief Расстояния датчиков (мм)
+        kf::u16 left_distance_mm, right_distance_mm;
+
+        /// @brief ШИМ моторов
+        Motor::SignedPwm left_pwm, right_pwm;
+
+        /// @brief Команды моторов до рефлекса [-1000; 1000]
+        kf::i16 left_command, right_command;
+
+        /// @brief Углы манипулятора
+        kf::u8 arm, claw;
+    };
+
+    static_assert(sizeof(Sample) == 26, "формат отсчёта согласован с клиентом моста");
+
+    /// @brief Причина триггера
+    enum class Reason : kf::u8 {
+        /// @brief Нет триггера
+        None = 0x00,
+
+        /// @brief Команда по мосту
+        Command = 0x01,
+
+        /// @brief Сбой (например, примитив движения не достиг цели)
+        Fault = 0x02,
+
+        /// @brief Остановка рефлексом
+        Reflex = 0x03,
+    };
+
+    /// @brief Ёмкость буфера (~2.5 с при 200 Гц)
+    static constexpr kf::u16 capacity = 512;
+
+    /// @brief Буфер
+    using Ring = BlackboxRing<Sample, capacity>;
+
+    /// @brief Отсчётов в одном фрагменте выгрузки
+    static constexpr kf::u8 chunk_samples = 8;
+
+    /// @brief Файл выгрузки во флеш
+    static constexpr auto spill_path = "/blackbox.bin";
+
+    /// @brief Заголовок выгрузки
+    struct Header {
+        /// @brief Размер отсчёта (байт)
+        kf::u8 sample_size;
+
+        /// @brief Количество отсчётов
+        kf::u16 count;
+
+        /// @brief Индекс отсчёта триггера
+        kf::u16 trigger_index;
+
+        /// @brief Причина триггера
+        Reason reason;
+
+        /// @brief Частота записи (Гц)
+        kf::u16 sample_frequency_hz;
+    };
+
+    /// @brief Фрагмент выгрузки
+    struct Chunk {
+        /// @brief Индекс первого отсчёта
+        kf::u16 offset;
+
+        /// @brief Отсчётов во фрагменте
+        kf::u8 count;
+
+        /// @brief Отсчёты
+        const Sample *samples;
+    };
+
+private:
+    /// @brief Источник расстояний и команд
+    ObstacleReflex &reflex;
+
+    /// @brief Буфер
+    Ring ring{};
+
+    /// @brief Причина последнего триггера
+    Reason reason{Reason::None};
+
+    /// @brief Уровень рефлекса на прошлом отсчёте
+    ForwardLimiter::Level last_reflex_level{ForwardLimiter::Level::Pass};
+
+    /// @brief Буфер уже сохранён во флеш
+    bool spilled{false};
+
+    /// @brief Выгрузка по мосту: следующий отсчёт (count - выгрузки нет)
+    kf::u16 dump_cursor{capacity};
+
+    /// @brief Временная копия фрагмента выгрузки
+    Sample chunk_buffer[chunk_samples]{};
+
+    /// @brief Периодический таймер записи
+    hal::PeriodicTimer timer{};
+
+    hal::CriticalSection lock{};
+
+public:
+    explicit Blackbox(ObstacleReflex &reflex) :
+        reflex{reflex} {}
+
+    /// @brief Запустить запись
+    [[nodiscard]] bool init() {
+        const auto &settings = Periphery::instance().storage.settings.blackbox;
+
+        if (settings.spill_to_flash and not hal::fsBegin()) {
+            kf_Logger_warn("LittleFS unavailable, spill disabled");
+        }
+
+        const bool started = timer.start(
+            "blackbox",
+            [](void *instance) { static_cast<Blackbox *>(instance)->sample(); },
+            this,
+            1000000u / settings.sample_frequency_hz);
+
+        if (not started) {
+            kf_Logger_error("timer start fail");
+            return false;
+        }
+
+        return true;
+    }
+
+    /// @brief Сработал триггер
+    void trigger(Reason trigger_reason) {
+        const auto post = Periphery::instance().storage.settings.blackbox.post_trigger_samples;
+
+        lock.enter();
+        if (ring.trigger(post)) { reason = trigger_reason; }
+        lock.exit();
+    }
+
+    /// @brief Возобновить непрерывную запись
+    void rearm() {
+        lock.enter();
+        ring.rearm();
+        reason = Reason::None;
+        spilled = false;
+        dump_cursor = capacity;
+        lock.exit();
+    }
+
+    /// @brief Начать выгрузку. Запись при этом замораживается, если ещё идёт
+    /// @returns Заголовок выгрузки
+    [[nodiscard]] Header beginDump() {
+        lock.enter();
+        // Окно после триггера, если ещё пишется, обрезается: отсчёты не меняются во время выгрузки
+        if (ring.getState() != Ring::State::Frozen) {
+            ring.freeze();
+            if (reason == Reason::None) { reason = Reason::Command; }
+        }
+
+        dump_cursor = 0;
+
+        const Header header{
+            .sample_size = sizeof(Sample),
+            .count = ring.size(),
+            .trigger_index = ring.triggerIndex(),
+            .reason = reason,
+            .sample_frequency_hz = Periphery::instance().storage.settings.blackbox.sample_frequency_hz,
+        };
+        lock.exit();
+
+        return header;
+    }
+
+    /// @brief Следующий фрагмент выгрузки
+    /// @returns false, если выгрузка завершена или не начата
+    [[nodiscard]] bool nextChunk(Chunk &chunk) {
+        if (dump_cursor >= ring.size()) { return false; }
+
+        kf::u8 n = 0;
+        while (n < chunk_samples and dump_cursor + n < ring.size()) {
+            chunk_buffer[n] = ring.at(dump_cursor + n);
+            n += 1;
+        }
+
+        chunk = {dump_cursor, n, chunk_buffer};
+        dump_cursor += n;
+        return true;
+    }
+
+    /// @brief Фоновые задачи основного цикла (сохранение во флеш)
+    void poll() {
+        if (spilled or ring.getState() != Ring::State::Frozen) { return; }
+        spilled = true;
+
+        if (not Periphery::instance().storage.settings.blackbox.spill_to_flash) { return; }
+
+        hal::FileWriter file{};
+        if (not file.open(spill_path)) {
+            kf_Logger_error("spill open fail");
+            return;
+        }
+
+        const auto header = Header{
+            .sample_size = sizeof(Sample),
+            .count = ring.size(),
+            .trigger_index = ring.triggerIndex(),
+            .reason = reason,
+            .sample_frequency_hz = Periphery::instance().storage.settings.blackbox.sample_frequency_hz,
+        };
+
+        file.write(&header, sizeof(header));
+
+        for (kf::u16 i = 0; i < ring.size(); i += 1) {
+            file.write(&ring.at(i), sizeof(Sample));
+        }
+
+        file.close();
+        kf_Logger_info("blackbox spilled: %d samples", ring.size());
+    }
+
+private:
+    /// @brief Запись отсчёта (контекст задачи таймера)
+    void sample() {
+        auto &periphery = Periphery::instance();
+
+        const auto command = reflex.requestedCommand();
+        const auto level = reflex.currentLevel();
+
+        const Sample s{
+            .timestamp_us = static_cast<kf::u32>(hal::nowMicros()),
+            .left_ticks = periphery.left_encoder.getPositionTicks(),
+            .right_ticks = periphery.right_encoder.getPositionTicks(),
+            .left_distance_mm = reflex.leftDistance(),
+            .right_distance_mm = reflex.rightDistance(),
+            .left_pwm = periphery.left_motor.lastPwm(),
+            .right_pwm = periphery.right_motor.lastPwm(),
+            .left_command = static_cast<kf::i16>(command.left * 1000.0f),
+            .right_command = static_cast<kf::i16>(command.right * 1000.0f),
+            .arm = static_cast<kf::u8>(periphery.manipulator.armAngle()),
+            .claw = static_cast<kf::u8>(periphery.manipulator.clawAngle()),
+        };
+
+        const bool reflex_stopped =
+            level == ForwardLimiter::Level::Stop and
+            last_reflex_level != ForwardLimiter::Level::Stop and
+            periphery.storage.settings.blackbox.trigger_on_reflex;
+
+        last_reflex_level = level;
+
+        lock.enter();
+        ring.push(s);
+        if (reflex_stopped and ring.trigger(periphery.storage.settings.blackbox.post_trigger_samples)) {
+            reason = Reason::Reflex;
+        }
+        lock.exit();
+    }
+};
+
+}// namespace zms
@@ -1,9 +1,22 @@
 #pragma once
 
-#include <Arduino.h>
+#include <algorithm>
 #include <bytelang/bridge.hpp>
+#include <cstring>
 #include <kf/tools/time/Timer.hpp>
 
+#include "zms/hal/Hal.hpp"
+#include "zms/services/BehaviourExecutor.hpp"
+#include "zms/services/Blackbox.hpp"
+#include "zms/services/ManipulatorTrajectoryExecutor.hpp"
+#include "zms/services/MotionExecutor.hpp"
+#include "zms/services/ObstacleReflex.hpp"
+#include "zms/services/Odometry.hpp"
+#include "zms/services/PathFollower.hpp"
+#include "zms/services/PowerManager.hpp"
+#include "zms/tools/Benchmark.hpp"
+#include "zms/tools/Trace.hpp"
+
 namespace zms {
 
 /// @brief Протокол ByteLang Моста
@@ -19,7 +32,34 @@ struct ByteLangBridgeProtocol final {
     using Sender = bytelang::bridge::Sender<kf::u8>;
 
     /// @brief Специализация приёмника
-    using Receiver = bytelang::bridge::Receiver<kf::u8, 4>;
+    using Receiver = bytelang::bridge::Receiver<kf::u8, 29>;
+
+    /// @brief Обмен синхронизации часов (по схеме NTP)
+    struct TimeSync {
+        /// @brief Время хоста при отправке запроса (мкс, часы хоста)
+        kf::u64 host_send_us;
+
+        /// @brief Бортовое время приёма запроса (мкс)
+        kf::u64 robot_receive_us;
+    };
+
+    /// @brief Результат бортового замера
+    struct BenchmarkReport {
+        /// @brief Индекс замера в реестре
+        kf::u8 index;
+
+        /// @brief Всего замеров в реестре
+        kf::u8 count;
+
+        /// @brief Имя замера
+        const char *name;
+
+        /// @brief Итоговая партия
+        Benchmark::Result result;
+    };
+
+    /// @brief Минимальная длительность партии бортового замера (мкс): цикл занят не дольше ~2 партий
+    static constexpr kf::u32 benchmark_min_time_us = 20000;
 
 private:
     /// @brief Экземпляр отправителя для создания инструкций
@@ -28,9 +68,51 @@ private:
     /// @brief Экземпляр приёмника для обработки приходящих инструкций
     Receiver receiver;
 
+    /// @brief Порт моста (входящие байты - активность хоста для управления питанием)
+    hal::Stream &port;
+
     // / @brief Таймер периода отправки значений энкодеров
     // kf::tools::Timer encoders_diffs_timer{static_cast<kf::Hertz>(5)};
 
+    /// @brief Исполнитель траекторий манипулятора
+    ManipulatorTrajectoryExecutor &manipulator_executor;
+
+    /// @brief Таймер периода отправки прогресса манипулятора во время движения
+    kf::tools::Timer manipulator_progress_timer{static_cast<kf::Hertz>(10)};
+
+    /// @brief Бортовая одометрия
+    Odometry &odometry;
+
+    /// @brief Исполнитель примитивов движения
+    MotionExecutor &motion_executor;
+
+    /// @brief Следование по пути
+    PathFollower &path_follower;
+
+    /// @brief Таймер периода отправки прогресса следования по пути
+    kf::tools::Timer path_progress_timer{static_cast<kf::Hertz>(10)};
+
+    /// @brief Рефлекс уклонения от препятствий
+    ObstacleReflex &obstacle_reflex;
+
+    /// @brief Бортовой самописец
+    Blackbox &blackbox;
+
+    /// @brief Исполнитель поведений
+    BehaviourExecutor &behaviour_executor;
+
+    /// @brief Управление питанием
+    PowerManager &power_manager;
+
+    /// @brief Режим питания до начала трассы (восстанавливается при выгрузке)
+    PowerSettings::Mode trace_power_mode{PowerSettings::Mode::Performance};
+
+    /// @brief Следующий бортовой замер
+    kf::u8 benchmark_next{0};
+
+    /// @brief Конец диапазона бортовых замеров (не включая)
+    kf::u8 benchmark_end{0};
+
 public:
     // Инструкции отправки
 
@@ -40,41 +122,169 @@ public:
     /// @brief 0x01 (...) -> send_log() -> u8[u8]
     bytelang::bridge::Instruction<Sender::Code, const kf::slice<const char> &> send_log;
 
-    /// @brief 0x02 send_dist_sensors() -> { left: u16, right: u16 }
+    /// @brief 0x02 send_dist_sensors() -> { left: u16, right: u16, timestamp_us: u64 }
     bytelang::bridge::Instruction<Sender::Code> send_distances;
 
-    /// @brief 0x03 send_encoder_diff() -> { left: i8, right: i8 }
+    /// @brief 0x03 send_encoder_diff() -> { left: i8, right: i8, timestamp_us: u64 }
     bytelang::bridge::Instruction<Sender::Code> send_encoders_diffs;
 
+    /// @brief 0x04 send_manipulator_progress() -> { arm: u8, claw: u8, queued: u8, completed: u8, timestamp_us: u64 }
+    bytelang::bridge::Instruction<Sender::Code, const ManipulatorTrajectoryExecutor::Progress &> send_manipulator_progress;
+
+    /// @brief 0x05 send_pose() -> { x: f32, y: f32, heading: f32, timestamp_us: u64 }
+    bytelang::bridge::Instruction<Sender::Code, const Odometry::Stamped &> send_pose;
+
+    /// @brief 0x06 send_motion_event() -> { id: u8, kind: u8, queued: u8, timestamp_us: u64 }
+    bytelang::bridge::Instruction<Sender::Code, const MotionExecutor::Event &> send_motion_event;
+
+    /// @brief 0x07 send_path_progress() -> { passed: u16, remaining: u8, cross_track_error: i16, state: u8, timestamp_us: u64 }
+    bytelang::bridge::Instruction<Sender::Code, const PathFollower::Progress &> send_path_progress;
+
+    /// @brief 0x08 send_reflex_event() -> { level: u8, left: u16, right: u16, timestamp_us: u64 }
+    bytelang::bridge::Instruction<Sender::Code, const ObstacleReflex::Event &> send_reflex_event;
+
+    /// @brief 0x09 send_blackbox_header() -> { sample_size: u8, count: u16, trigger_index: u16, reason: u8, frequency: u16, timestamp_us: u64 }
+    bytelang::bridge::Instruction<Sender::Code, const Blackbox::Header &> send_blackbox_header;
+
+    /// @brief 0x0A send_blackbox_chunk() -> { offset: u16, samples: [u8]Sample }
+    bytelang::bridge::Instruction<Sender::Code, const Blackbox::Chunk &> send_blackbox_chunk;
+
+    /// @brief 0x0B send_time_sync() -> { host_send_us: u64, robot_receive_us: u64, robot_send_us: u64 }
+    bytelang::bridge::Instruction<Sender::Code, const TimeSync &> send_time_sync;
+
+    /// @brief 0x0C send_benchmark_result() -> { index: u8, count: u8, name: u8[u8], iterations: u32, cycles: u64, frequency_mhz: u16 }
+    bytelang::bridge::Instruction<Sender::Code, const BenchmarkReport &> send_benchmark_result;
+
+    /// @brief 0x0D send_identity() -> { id: u64 }
+    bytelang::bridge::Instruction<Sender::Code> send_identity;
+
+    /// @brief 0x0E send_boot_timeline() -> { failed: u16, stages: [u8]{ ok: u8, start_us: u32, duration_us: u32 } }
+    bytelang::bridge::Instruction<Sender::Code> send_boot_timeline;
+
+    /// @brief 0x0F send_behaviour_status() -> { state: u8, fault: u8, pc: u16, executed: u32, report: i32, timestamp_us: u64 }
+    bytelang::bridge::Instruction<Sender::Code, const BehaviourExecutor::Status &> send_behaviour_status;
+
+    /// @brief 0x10 send_power_stats() -> { mode: u8, level: u8, frequency_mhz: u16, loop_mean_us: u32, loop_max_us: u32, wake_mean_us: u32, wake_max_us: u32, sleeps: u32, sleep_permille: u16, timestamp_us: u64 }
+    bytelang::bridge::Instruction<Sender::Code, const PowerManager::Stats &> send_power_stats;
+
+    /// @brief 0x11 send_trace_header() -> { count: u16, lost: u32, frequency_mhz: u16, references: [u8]{ cycles: u32, micros: u64 }, tasks: [u8][u8]u8 }
+    bytelang::bridge::Instruction<Sender::Code, const Trace::Header &> send_trace_header;
+
+    /// @brief 0x12 send_trace_chunk() -> { offset: u16, events: [u8]{ cycles: u32, point: u8, arg: u8, flags: u8, task: u8 } }
+    bytelang::bridge::Instruction<Sender::Code, const Trace::Chunk &> send_trace_chunk;
+
     /// @brief Публичный конструктор для сервиса
-    explicit ByteLangBridgeProtocol() :
-        ByteLangBridgeProtocol{Serial} {}
+    explicit ByteLangBridgeProtocol(
+        ManipulatorTrajectoryExecutor &manipulator_executor,
+        Odometry &odometry,
+        MotionExecutor &motion_executor,
+        PathFollower &path_follower,
+        ObstacleReflex &obstacle_reflex,
+        Blackbox &blackbox,
+        BehaviourExecutor &behaviour_executor,
+        PowerManager &power_manager
+    ) :
+        ByteLangBridgeProtocol{hal::serial(), manipulator_executor, odometry, motion_executor, path_follower, obstacle_reflex, blackbox, behaviour_executor, power_manager} {}
 
     /// @brief Прокрутка событий (Обработка входящих инструкций)
     void poll() {
+        if (port.available() > 0) { power_manager.notifyActivity(); }
+
         receiver.poll();
 
+        const bool report_progress =
+            manipulator_executor.hasCompletions() or
+            (manipulator_executor.busy() and manipulator_progress_timer.ready());
+
+        if (report_progress) {
+            (void) send_manipulator_progress(manipulator_executor.takeProgress());
+        }
+
+        MotionExecutor::Event motion_event{};
+        while (motion_executor.popEvent(motion_event)) {
+            if (motion_event.kind == MotionExecutor::EventKind::Timeout) {
+                blackbox.trigger(Blackbox::Reason::Fault);
+            }
+
+            (void) send_motion_event(motion_event);
+        }
+
+        const bool report_path =
+            path_follower.stateChanged() or
+            (path_follower.busy() and path_progress_timer.ready());
+
+        if (report_path) {
+            (void) send_path_progress(path_follower.takeProgress());
+        }
+
+        if (behaviour_executor.stateChanged()) {
+            (void) send_behaviour_status(behaviour_executor.takeStatus());
+        }
+
+        ObstacleReflex::Event reflex_event{};
+        while (obstacle_reflex.popEvent(reflex_event)) {
+            (void) send_reflex_event(reflex_event);
+        }
+
+        // Выгрузка самописца - по фрагменту за цикл, чтобы не занимать порт надолго
+        Blackbox::Chunk chunk{};
+        if (blackbox.nextChunk(chunk)) {
+            (void) send_blackbox_chunk(chunk);
+        }
+
+        // Выгрузка трассы - так же по фрагменту за цикл
+        Trace::Chunk trace_chunk{};
+        if (Trace::nextChunk(trace_chunk)) {
+            (void) send_trace_chunk(trace_chunk);
+        }
+
+        // Бортовые замеры - по одному за цикл
+        if (benchmark_next < benchmark_end) {
+            const auto index = benchmark_next;
+            benchmark_next += 1;
+
+            const auto &c = Benchmark::at(index);
+            (void) send_benchmark_result({index, Benchmark::count(), c.name, Benchmark::run(c, benchmark_min_time_us)});
+        }
+
         // if (encoders_diffs_timer.ready()) {
         //     send_encoders_diffs();
         // }
     }
 
-private:
-    /// @brief Приватный конструктор
-    /// @param arduino_stream
-    explicit ByteLangBridgeProtocol(Stream &arduino_stream) :
+    /// @brief Конструктор поверх произвольного потока (замеры без порта)
+    explicit ByteLangBridgeProtocol(
+        hal::Stream &arduino_stream,
+        ManipulatorTrajectoryExecutor &manipulator_executor,
+        Odometry &odometry,
+        MotionExecutor &motion_executor,
+        PathFollower &path_follower,
+        ObstacleReflex &obstacle_reflex,
+        Blackbox &blackbox,
+        BehaviourExecutor &behaviour_executor,
+        PowerManager &power_manager
+    ) :
         sender{bytelang::core::OutputStream{arduino_stream}},
         receiver{
             .in = bytelang::core::InputStream{arduino_stream},
             .instructions = getInstructions(),
         },
+        port{arduino_stream},
+        manipulator_executor{manipulator_executor},
+        odometry{odometry},
+        motion_executor{motion_executor},
+        path_follower{path_follower},
+        obstacle_reflex{obstacle_reflex},
+        blackbox{blackbox},
+        behaviour_executor{behaviour_executor},
+        power_manager{power_manager},
 
         //
 
         send_millis{
             sender.createInstruction(
                 [](bytelang::core::OutputStream &stream) -> BridgeResult {
-                    if (not stream.write(kf::u32(millis()))) {
+                    if (not stream.write(hal::nowMillis())) {
                         return {Error::InstructionArgumentWriteFail};
                     }
 
@@ -110,6 +320,8 @@ private:
                     const auto right = kf::u16(periphery.right_distance_sensor.read());
                     if (not stream.write(right)) { return {Error::InstructionArgumentWriteFail}; }
 
+                    if (not writeTimestamp(stream)) { return {Error::InstructionArgumentWriteFail}; }
+
                     return {};
                 })},
 
@@ -120,18 +332,18 @@ private:
                 [](bytelang::core::OutputStream &stream) -> BridgeResult {
                     auto &periphery = Periphery::instance();
 
-                    const auto max_delta = 100;
+                    const Encoder::Ticks max_delta = 100;
 
                     static auto last_left{periphery.left_encoder.getPositionTicks()};
                     static auto last_right{periphery.right_encoder.getPositionTicks()};
 
                     auto delta_left = periphery.left_encoder.getPositionTicks() - last_left;
                     last_left = periphery.left_encoder.getPositionTicks();
-                    delta_left = constrain(delta_left, -max_delta, max_delta);
+                    delta_left = std::clamp(delta_left, -max_delta, max_delta);
 
                     auto delta_right = periphery.right_encoder.getPositionTicks() - last_right;
                     last_right = periphery.right_encoder.getPositionTicks();
-                    delta_right = constrain(delta_right, -max_delta, max_delta);
+                    delta_right = std::clamp(delta_right, -max_delta, max_delta);
 
                     if (not stream.write(static_cast<kf::i8>(delta_left))) {
                         return {Error::InstructionArgumentWriteFail};
@@ -141,15 +353,331 @@ private:
                         return {Error::InstructionArgumentWriteFail};
                     }
 
+                    if (not writeTimestamp(stream)) { return {Error::InstructionArgumentWriteFail}; }
+
+                    return {};
+                })},
+
+        //
+
+        send_manipulator_progress{
+            sender.createInstruction<const ManipulatorTrajectoryExecutor::Progress &>(
+                [](bytelang::core::OutputStream &stream, const ManipulatorTrajectoryExecutor::Progress &progress) -> BridgeResult {
+                    if (not stream.write(progress.arm)) { return {Error::InstructionArgumentWriteFail}; }
+                    if (not stream.write(progress.claw)) { return {Error::InstructionArgumentWriteFail}; }
+                    if (not stream.write(progress.queued)) { return {Error::InstructionArgumentWriteFail}; }
+                    if (not stream.write(progress.completed)) { return {Error::InstructionArgumentWriteFail}; }
+                    if (not writeTimestamp(stream)) { return {Error::InstructionArgumentWriteFail}; }
+
+                    return {};
+                })},
+
+        //
+
+        send_pose{
+            sender.createInstruction<const Odometry::Stamped &>(
+                [](bytelang::core::OutputStream &stream, const Odometry::Stamped &stamped) -> BridgeResult {
+                    if (not stream.write(stamped.pose.x)) { return {Error::InstructionArgumentWriteFail}; }
+                    if (not stream.write(stamped.pose.y)) { return {Error::InstructionArgumentWriteFail}; }
+                    if (not stream.write(stamped.pose.heading)) { return {Error::InstructionArgumentWriteFail}; }
+                    if (not stream.write(stamped.timestamp_us)) { return {Error::InstructionArgumentWriteFail}; }
+
+                    return {};
+                })},
+
+        //
+
+        send_motion_event{
+            sender.createInstruction<const MotionExecutor::Event &>(
+                [](bytelang::core::OutputStream &stream, const MotionExecutor::Event &event) -> BridgeResult {
+                    if (not stream.write(event.id)) { return {Error::InstructionArgumentWriteFail}; }
+                    if (not stream.write(static_cast<kf::u8>(event.kind))) { return {Error::InstructionArgumentWriteFail}; }
+                    if (not stream.write(event.queued)) { return {Error::InstructionArgumentWriteFail}; }
+                    if (not stream.write(event.timestamp_us)) { return {Error::InstructionArgumentWriteFail}; }
+
+                    return {};
+                })},
+
+        //
+
+        send_path_progress{
+            sender.createInstruction<const PathFollower::Progress &>(
+                [](bytelang::core::OutputStream &stream, const PathFollower::Progress &progress) -> BridgeResult {
+                    if (not stream.write(progress.passed_segments)) { return {Error::InstructionArgumentWriteFail}; }
+                    if (not stream.write(progress.remaining_segments)) { return {Error::InstructionArgumentWriteFail}; }
+                    if (not stream.write(progress.cross_track_error_mm)) { return {Error::InstructionArgumentWriteFail}; }
+                    if (not stream.write(static_cast<kf::u8>(progress.state))) { return {Error::InstructionArgumentWriteFail}; }
+                    if (not writeTimestamp(stream)) { return {Error::InstructionArgumentWriteFail}; }
+
+                    return {};
+                })},
+
+        //
+
+        send_reflex_event{
+            sender.createInstruction<const ObstacleReflex::Event &>(
+                [](bytelang::core::OutputStream &stream, const ObstacleReflex::Event &event) -> BridgeResult {
+                    if (not stream.write(static_cast<kf::u8>(event.level))) { return {Error::InstructionArgumentWriteFail}; }
+                    if (not stream.write(event.left_mm)) { return {Error::InstructionArgumentWriteFail}; }
+                    if (not stream.write(event.right_mm)) { return {Error::InstructionArgumentWriteFail}; }
+                    if (not stream.write(event.timestamp_us)) { return {Error::InstructionArgumentWriteFail}; }
+
+                    return {};
+                })},
+
+        //
+
+        send_blackbox_header{
+            sender.createInstruction<const Blackbox::Header &>(
+                [](bytelang::core::OutputStream &stream, const Blackbox::Header &header) -> BridgeResult {
+                    if (not stream.write(header.sample_size)) { return {Error::InstructionArgumentWriteFail}; }
+                    if (not stream.write(header.count)) { return {Error::InstructionArgumentWriteFail}; }
+                    if (not stream.write(header.trigger_index)) { return {Error::InstructionArgumentWriteFail}; }
+                    if (not stream.write(static_cast<kf::u8>(header.reason))) { return {Error::InstructionArgumentWriteFail}; }
+                    if (not stream.write(header.sample_frequency_hz)) { return {Error::InstructionArgumentWriteFail}; }
+
+                    // Отсчёты хранят младшие 32 бита времени: полное время выгрузки позволяет их развернуть
+                    if (not writeTimestamp(stream)) { return {Error::InstructionArgumentWriteFail}; }
+
+                    return {};
+                })},
+
+        //
+
+        send_blackbox_chunk{
+            sender.createInstruction<const Blackbox::Chunk &>(
+                [](bytelang::core::OutputStream &stream, const Blackbox::Chunk &chunk) -> BridgeResult {
+                    if (not stream.write(chunk.offset)) { return {Error::InstructionArgumentWriteFail}; }
+                    if (not stream.write(chunk.count)) { return {Error::InstructionArgumentWriteFail}; }
+
+                    for (kf::u8 i = 0; i < chunk.count; i += 1) {
+                        if (not writeBlackboxSample(stream, chunk.samples[i])) {
+                            return {Error::InstructionArgumentWriteFail};
+                        }
+                    }
+
+                    return {};
+                })},
+
+        //
+
+        send_time_sync{
+            sender.createInstruction<const TimeSync &>(
+                [](bytelang::core::OutputStream &stream, const TimeSync &sync) -> BridgeResult {
+                    if (not stream.write(sync.host_send_us)) { return {Error::InstructionArgumentWriteFail}; }
+                    if (not stream.write(sync.robot_receive_us)) { return {Error::InstructionArgumentWriteFail}; }
+
+                    // Время отправки снимается последним, непосредственно перед записью
+                    if (not writeTimestamp(stream)) { return {Error::InstructionArgumentWriteFail}; }
+
+                    return {};
+                })},
+
+        //
+
+        send_benchmark_result{
+            sender.createInstruction<const BenchmarkReport &>(
+                [](bytelang::core::OutputStream &stream, const BenchmarkReport &report) -> BridgeResult {
+                    const auto name_length = static_cast<kf::u8>(std::strlen(report.name));
+
+                    if (not stream.write(report.index)) { return {Error::InstructionArgumentWriteFail}; }
+                    if (not stream.write(report.count)) { return {Error::InstructionArgumentWriteFail}; }
+                    if (not stream.write(name_length)) { return {Error::InstructionArgumentWriteFail}; }
+                    if (not stream.write(report.name, name_length)) { return {Error::InstructionArgumentWriteFail}; }
+                    if (not stream.write(report.result.iterations)) { return {Error::InstructionArgumentWriteFail}; }
+                    if (not stream.write(report.result.cycles)) { return {Error::InstructionArgumentWriteFail}; }
+                    if (not stream.write(static_cast<kf::u16>(report.result.frequency_mhz))) { return {Error::InstructionArgumentWriteFail}; }
+
+                    return {};
+                })},
+
+        //
+
+        send_identity{
+            sender.createInstruction(
+                [](bytelang::core::OutputStream &stream) -> BridgeResult {
+                    if (not stream.write(hal::chipId())) { return {Error::InstructionArgumentWriteFail}; }
+
+                    return {};
+                })},
+
+        //
+
+        send_boot_timeline{
+            sender.createInstruction(
+                [](bytelang::core::OutputStream &stream) -> BridgeResult {
+                    const auto &boot = Periphery::instance().boot;
+
+                    if (not stream.write(boot.failedMask())) { return {Error::InstructionArgumentWriteFail}; }
+                    if (not stream.write(BootTimeline::stage_count)) { return {Error::InstructionArgumentWriteFail}; }
+
+                    for (kf::u8 i = 0; i < BootTimeline::stage_count; i += 1) {
+                        const auto &record = boot.at(i);
+
+                        if (not stream.write(static_cast<kf::u8>(record.ok))) { return {Error::InstructionArgumentWriteFail}; }
+                        if (not stream.write(record.start_us)) { return {Error::InstructionArgumentWriteFail}; }
+                        if (not stream.write(record.duration_us)) { return {Error::InstructionArgumentWriteFail}; }
+                    }
+
+                    return {};
+                })},
+
+        //
+
+        send_behaviour_status{
+            sender.createInstruction<const BehaviourExecutor::Status &>(
+                [](bytelang::core::OutputStream &stream, const BehaviourExecutor::Status &status) -> BridgeResult {
+                    if (not stream.write(static_cast<kf::u8>(status.state))) { return {Error::InstructionArgumentWriteFail}; }
+                    if (not stream.write(static_cast<kf::u8>(status.fault))) { return {Error::InstructionArgumentWriteFail}; }
+                    if (not stream.write(status.pc)) { return {Error::InstructionArgumentWriteFail}; }
+                    if (not stream.write(status.executed)) { return {Error::InstructionArgumentWriteFail}; }
+                    if (not stream.write(status.report)) { return {Error::InstructionArgumentWriteFail}; }
+                    if (not writeTimestamp(stream)) { return {Error::InstructionArgumentWriteFail}; }
+                    return {};
+                })},
+
+        //
+
+        send_power_stats{
+            sender.createInstruction<const PowerManager::Stats &>(
+                [](bytelang::core::OutputStream &stream, const PowerManager::Stats &stats) -> BridgeResult {
+                    if (not stream.write(static_cast<kf::u8>(stats.mode))) { return {Error::InstructionArgumentWriteFail}; }
+                    if (not stream.write(static_cast<kf::u8>(stats.level))) { return {Error::InstructionArgumentWriteFail}; }
+                    if (not stream.write(stats.frequency_mhz)) { return {Error::InstructionArgumentWriteFail}; }
+                    if (not stream.write(stats.loop_mean_us)) { return {Error::InstructionArgumentWriteFail}; }
+                    if (not stream.write(stats.loop_max_us)) { return {Error::InstructionArgumentWriteFail}; }
+                    if (not stream.write(stats.wake_mean_us)) { return {Error::InstructionArgumentWriteFail}; }
+                    if (not stream.write(stats.wake_max_us)) { return {Error::InstructionArgumentWriteFail}; }
+                    if (not stream.write(stats.sleeps)) { return {Error::InstructionArgumentWriteFail}; }
+                    if (not stream.write(stats.sleep_permille)) { return {Error::InstructionArgumentWriteFail}; }
+                    if (not writeTimestamp(stream)) { return {Error::InstructionArgumentWriteFail}; }
+
+                    return {};
+                })},
+
+        //
+
+        send_trace_header{
+            sender.createInstruction<const Trace::Header &>(
+                [](bytelang::core::OutputStream &stream, const Trace::Header &header) -> BridgeResult {
+                    if (not stream.write(header.count)) { return {Error::InstructionArgumentWriteFail}; }
+                    if (not stream.write(header.lost)) { return {Error::InstructionArgumentWriteFail}; }
+                    if (not stream.write(header.frequency_mhz)) { return {Error::InstructionArgumentWriteFail}; }
+                    if (not stream.write(hal::core_count)) { return {Error::InstructionArgumentWriteFail}; }
+
+                    for (kf::u8 core = 0; core < hal::core_count; core += 1) {
+                        if (not stream.write(header.references[core].cycles)) { return {Error::InstructionArgumentWriteFail}; }
+                        if (not stream.write(header.references[core].micros)) { return {Error::InstructionArgumentWriteFail}; }
+                    }
+
+                    if (not stream.write(header.task_count)) { return {Error::InstructionArgumentWriteFail}; }
+
+                    for (kf::u8 i = 0; i < header.task_count; i += 1) {
+                        const auto *name = header.tasks[i].name;
+                        const auto length = static_cast<kf::u8>(std::strlen(name));
+
+                        if (not stream.write(length)) { return {Error::InstructionArgumentWriteFail}; }
+                        if (not stream.write(name, length)) { return {Error::InstructionArgumentWriteFail}; }
+                    }
+
+                    return {};
+                })},
+
+        //
+
+        send_trace_chunk{
+            sender.createInstruction<const Trace::Chunk &>(
+                [](bytelang::core::OutputStream &stream, const Trace::Chunk &chunk) -> BridgeResult {
+                    if (not stream.write(chunk.offset)) { return {Error::InstructionArgumentWriteFail}; }
+                    if (not stream.write(chunk.count)) { return {Error::InstructionArgumentWriteFail}; }
+
+                    for (kf::u8 i = 0; i < chunk.count; i += 1) {
+                        const auto &event = chunk.events[i];
+
+                        if (not stream.write(event.cycles)) { return {Error::InstructionArgumentWriteFail}; }
+                        if (not stream.write(static_cast<kf::u8>(event.point))) { return {Error::InstructionArgumentWriteFail}; }
+                        if (not stream.write(event.arg)) { return {Error::InstructionArgumentWriteFail}; }
+                        if (not stream.write(event.flags)) { return {Error::InstructionArgumentWriteFail}; }
+                        if (not stream.write(event.task)) { return {Error::InstructionArgumentWriteFail}; }
+                    }
+
                     return {};
                 })}
     //
     {}
 
+private:
+    /// @brief Перевести значение мотора из моста [-1000, 1000] в нормализованную команду (с округлением до ближайшего)
+    [[nodiscard]] static constexpr NormalizedCommand normalizedFromBridge(kf::i16 value) {
+        constexpr kf::i32 max_value = 1000;
+
+        return NormalizedCommand::fromRatio(std::clamp(kf::i32(value), -max_value, max_value), max_value);
+    }
+
+    /// @brief Записать текущее бортовое время (мкс)
+    [[nodiscard]] static bool writeTimestamp(bytelang::core::OutputStream &stream) {
+        return stream.write(hal::nowMicros());
+    }
+
+    /// @brief Записать отсчёт самописца (поля копируются: структура упакована)
+    [[nodiscard]] static bool writeBlackboxSample(bytelang::core::OutputStream &stream, const Blackbox::Sample &sample) {
+        return stream.write(kf::u32{sample.timestamp_us}) and
+               stream.write(Encoder::Ticks{sample.left_ticks}) and
+               stream.write(Encoder::Ticks{sample.right_ticks}) and
+               stream.write(kf::u16{sample.left_distance_mm}) and
+               stream.write(kf::u16{sample.right_distance_mm}) and
+               stream.write(Motor::SignedPwm{sample.left_pwm}) and
+               stream.write(Motor::SignedPwm{sample.right_pwm}) and
+               stream.write(kf::i16{sample.left_command}) and
+               stream.write(kf::i16{sample.right_command}) and
+               stream.write(kf::u8{sample.arm}) and
+               stream.write(kf::u8{sample.claw});
+    }
+
+    /// @brief Инструкция постановки примитива движения
+    Receiver::InstructionTable::value_type motionInstruction(MotionPrimitive::Kind kind) {
+        return [this, kind](bytelang::core::InputStream &stream) -> BridgeResult {
+            auto id = stream.readByte();
+            if (not id.hasValue()) { return Error::InstructionArgumentReadFail; }
+
+            auto amount = stream.read<kf::i16>();
+            if (not amount.hasValue()) { return Error::InstructionArgumentReadFail; }
+
+            auto max_speed = stream.read<kf::u16>();
+            if (not max_speed.hasValue()) { return Error::InstructionArgumentReadFail; }
+
+            auto acceleration = stream.read<kf::u16>();
+            if (not acceleration.hasValue()) { return Error::InstructionArgumentReadFail; }
+
+            auto mode = stream.readByte();
+            if (not mode.hasValue()) { return Error::InstructionArgumentReadFail; }
+
+            if (max_speed.value() == 0 or acceleration.value() == 0) {
+                kf_Logger_warn("zero speed or acceleration");
+                return {};
+            }
+
+            path_follower.cancel();
+            behaviour_executor.cancel();
+
+            motion_executor.push(
+                {
+                    .id = id.value(),
+                    .kind = kind,
+                    .amount = amount.value(),
+                    .max_speed = max_speed.value(),
+                    .acceleration = acceleration.value(),
+                },
+                (mode.value() == 0) ? MotionExecutor::Mode::Append : MotionExecutor::Mode::Replace);
+
+            return {};
+        };
+    }
+
     /// @brief Получить таблицу инструкций приёма
     /// @return Таблица инструкций на приём
     Receiver::InstructionTable getInstructions() {
-        return {
+        Receiver::InstructionTable instructions{
             // 0x00
             // get_millis()
             // Вызывает процедуру отправки бортового времени в миллисекундах
@@ -161,7 +689,8 @@ private:
             // set_manipulator(arm: u8, claw: u8)
             // Устанавливает манипулятор в положение
             // Значение 0xff выключает ось
-            [](bytelang::core::InputStream &stream) -> BridgeResult {
+            // Прерывает исполнение траектории
+            [this](bytelang::core::InputStream &stream) -> BridgeResult {
                 auto arm = stream.readByte();
                 if (not arm.hasValue()) { return Error::InstructionArgumentReadFail; }
 
@@ -172,6 +701,17 @@ private:
 
                 auto &manipulator = Periphery::instance().manipulator;
 
+                manipulator_executor.cancel();
+
+                // Выключенная ось остаётся в текущем положении профиля
+                if (disabled != arm.value() and disabled != claw.value()) {
+                    manipulator_executor.rehome(arm.value(), claw.value());
+                } else if (disabled != arm.value()) {
+                    manipulator_executor.rehomeArm(arm.value());
+                } else if (disabled != claw.value()) {
+                    manipulator_executor.rehomeClaw(claw.value());
+                }
+
                 if (disabled == arm.value()) {
                     manipulator.disableArm();
                 } else {
@@ -198,24 +738,370 @@ private:
             // set_motors(left: i16, right: i16)
             // Установить значения моторов.
             // left, right [-1000, 1000]
-            [](bytelang::core::InputStream &stream) -> BridgeResult {
-                const auto max_value = 1000.0f;
-
+            // Прерывает примитивы движения
+            [this](bytelang::core::InputStream &stream) -> BridgeResult {
                 auto left_op = stream.read<kf::i16>();
                 if (not left_op.hasValue()) { return Error::InstructionArgumentReadFail; }
 
                 auto right_op = stream.read<kf::i16>();
                 if (not right_op.hasValue()) { return Error::InstructionArgumentReadFail; }
 
-                auto &periphery = Periphery::instance();
-                periphery.left_motor.set(kf::f32(constrain(left_op.value(), -max_value, max_value)) / max_value);
-                periphery.right_motor.set(kf::f32(constrain(right_op.value(), -max_value, max_value)) / max_value);
+                motion_executor.cancel();
+                path_follower.cancel();
+                behaviour_executor.cancel();
+
+                obstacle_reflex.setNormalized(
+                    normalizedFromBridge(left_op.value()),
+                    normalizedFromBridge(right_op.value()));
+
+                return {};
+            },
+
+            // 0x04
+            // move_manipulator(arm: u8, claw: u8, max_velocity: u16, acceleration: u16)
+            // Добавить точку траектории манипулятора (град, град/с, град/с^2)
+            // Завершение каждой точки сообщается через send_manipulator_progress
+            [this](bytelang::core::InputStream &stream) -> BridgeResult {
+                auto arm = stream.readByte();
+                if (not arm.hasValue()) { return Error::InstructionArgumentReadFail; }
+
+                auto claw = stream.readByte();
+                if (not claw.hasValue()) { return Error::InstructionArgumentReadFail; }
+
+                auto max_velocity = stream.read<kf::u16>();
+                if (not max_velocity.hasValue()) { return Error::InstructionArgumentReadFail; }
+
+                auto acceleration = stream.read<kf::u16>();
+                if (not acceleration.hasValue()) { return Error::InstructionArgumentReadFail; }
+
+                if (max_velocity.value() == 0 or acceleration.value() == 0) {
+                    kf_Logger_warn("zero velocity or acceleration");
+                    return {};
+                }
+
+                const bool queued = manipulator_executor.push({
+                    .arm = arm.value(),
+                    .claw = claw.value(),
+                    .max_velocity = max_velocity.value(),
+                    .acceleration = acceleration.value(),
+                });
+
+                if (not queued) { kf_Logger_warn("manipulator queue full"); }
+
+                return {};
+            },
+
+            // 0x05
+            // stop_manipulator()
+            // Прервать движение манипулятора и очистить очередь точек
+            [this](bytelang::core::InputStream &) -> BridgeResult {
+                manipulator_executor.cancel();
+                return send_manipulator_progress(manipulator_executor.takeProgress());
+            },
+
+            // 0x06
+            // get_pose()
+            // Запросить позу бортовой одометрии
+            [this](bytelang::core::InputStream &) -> BridgeResult {
+                return send_pose(odometry.get());
+            },
+
+            // 0x07
+            // reset_pose()
+            // Сбросить позу в начало координат
+            [this](bytelang::core::InputStream &) -> BridgeResult {
+                odometry.reset();
+                return {};
+            },
+
+            // 0x08
+            // set_pose(x: f32, y: f32, heading: f32)
+            // Установить позу (мм, мм, рад)
+            [this](bytelang::core::InputStream &stream) -> BridgeResult {
+                auto x = stream.read<kf::f32>();
+                if (not x.hasValue()) { return Error::InstructionArgumentReadFail; }
+
+                auto y = stream.read<kf::f32>();
+                if (not y.hasValue()) { return Error::InstructionArgumentReadFail; }
+
+                auto heading = stream.read<kf::f32>();
+                if (not heading.hasValue()) { return Error::InstructionArgumentReadFail; }
+
+                odometry.setPose({x.value(), y.value(), heading.value()});
+                return {};
+            },
+
+            // 0x09
+            // drive(id: u8, distance: i16, max_speed: u16, acceleration: u16, mode: u8)
+            // Проехать расстояние (мм, мм/с, мм/с^2); mode: 0 - в очередь, 1 - заменить текущую
+            motionInstruction(MotionPrimitive::Kind::Drive),
+
+            // 0x0A
+            // turn(id: u8, angle: i16, max_speed: u16, acceleration: u16, mode: u8)
+            // Повернуть на месте (град, град/с, град/с^2), положительный угол - против часовой
+            motionInstruction(MotionPrimitive::Kind::Turn),
+
+            // 0x0B
+            // cancel_motion()
+            // Прервать примитивы движения и остановить моторы
+            [this](bytelang::core::InputStream &) -> BridgeResult {
+                motion_executor.cancel();
+                return {};
+            },
+
+            // 0x0C
+            // follow_path(mode: u8, points: [u8]{ x: i16, y: i16 })
+            // Загрузить точки пути (мм, в системе координат одометрии)
+            // mode: 0 - новый путь от текущей позы, 1 - дописать к текущему
+            [this](bytelang::core::InputStream &stream) -> BridgeResult {
+                auto mode = stream.readByte();
+                if (not mode.hasValue()) { return Error::InstructionArgumentReadFail; }
+
+                auto count = stream.readByte();
+                if (not count.hasValue()) { return Error::InstructionArgumentReadFail; }
+
+                if (mode.value() == 0 or not path_follower.busy()) {
+                    motion_executor.cancel();
+                    behaviour_executor.cancel();
+                    path_follower.begin();
+                }
+
+                kf::u8 dropped = 0;
+
+                // Все точки вычитываются из потока даже при переполнении, чтобы не потерять синхронизацию
+                for (kf::u8 i = 0; i < count.value(); i += 1) {
+                    auto x = stream.read<kf::i16>();
+                    if (not x.hasValue()) { return Error::InstructionArgumentReadFail; }
+
+                    auto y = stream.read<kf::i16>();
+                    if (not y.hasValue()) { return Error::InstructionArgumentReadFail; }
+
+                    if (not path_follower.append({kf::f32(x.value()), kf::f32(y.value())})) {
+                        dropped += 1;
+                    }
+                }
+
+                if (dropped > 0) { kf_Logger_warn("path full: %d points dropped", dropped); }
+
+                return {};
+            },
+
+            // 0x0D
+            // cancel_path()
+            // Прервать следование по пути и остановить моторы
+            [this](bytelang::core::InputStream &) -> BridgeResult {
+                path_follower.cancel();
+                return {};
+            },
+
+            // 0x0E
+            // dump_blackbox()
+            // Выгрузить самописец: заголовок, затем фрагменты в последующих циклах
+            // Если запись ещё идёт, она замораживается
+            [this](bytelang::core::InputStream &) -> BridgeResult {
+                return send_blackbox_header(blackbox.beginDump());
+            },
+
+            // 0x0F
+            // trigger_blackbox()
+            // Триггер самописца по команде
+            [this](bytelang::core::InputStream &) -> BridgeResult {
+                blackbox.trigger(Blackbox::Reason::Command);
+                return {};
+            },
+
+            // 0x10
+            // rearm_blackbox()
+            // Возобновить непрерывную запись самописца
+            [this](bytelang::core::InputStream &) -> BridgeResult {
+                blackbox.rearm();
+                return {};
+            },
+
+            // 0x11
+            // sync_time(host_send_us: u64)
+            // Обмен синхронизации часов: в ответ send_time_sync с бортовым временем приёма и отправки
+            [this](bytelang::core::InputStream &stream) -> BridgeResult {
+                // Время приёма снимается до чтения аргумента - как можно ближе к приходу инструкции
+                const auto robot_receive_us = hal::nowMicros();
+
+                auto host_send_us = stream.read<kf::u64>();
+                if (not host_send_us.hasValue()) { return Error::InstructionArgumentReadFail; }
+
+                return send_time_sync({host_send_us.value(), robot_receive_us});
+            },
+
+            // 0x12
+            // run_benchmarks(index: u8)
+            // Запустить бортовые замеры (сборка с ZMS_BENCHMARK): index - один замер, 0xFF - все
+            // Движение прерывается и моторы останавливаются; результаты - send_benchmark_result по одному за цикл
+            [this](bytelang::core::InputStream &stream) -> BridgeResult {
+                auto index = stream.readByte();
+                if (not index.hasValue()) { return Error::InstructionArgumentReadFail; }
+
+                const auto count = Benchmark::count();
+
+                if (count == 0) {
+                    kf_Logger_warn("no benchmarks in this build");
+                    return {};
+                }
+
+                motion_executor.cancel();
+                path_follower.cancel();
+                behaviour_executor.cancel();
+                obstacle_reflex.stop();
+
+                const auto all = 0xFF;
+
+                if (all == index.value()) {
+                    benchmark_next = 0;
+                    benchmark_end = count;
+                } else if (index.value() < count) {
+                    benchmark_next = index.value();
+                    benchmark_end = index.value() + 1;
+                } else {
+                    kf_Logger_warn("no benchmark #%d", index.value());
+                }
+
+                return {};
+            },
+
+            // 0x13
+            // get_identity()
+            // Запросить идентификатор платы (шлюз различает по нему роботов на разных портах)
+            [this](bytelang::core::InputStream &) -> BridgeResult {
+                return send_identity();
+            },
+
+            // 0x14
+            // get_boot_timeline()
+            // Запросить хронологию загрузки: длительность этапов и неудавшиеся (деградированный режим)
+            [this](bytelang::core::InputStream &) -> BridgeResult {
+                return send_boot_timeline();
+            },
+
+            // 0x15
+            // load_behaviour(mode: u8, code: [u8]u8)
+            // Загрузить байткод поведения (см. BehaviourVm); исполняемое поведение прерывается
+            // mode: 0 - новая программа, 1 - дописать (программы длиннее 255 байт - несколькими фрагментами)
+            [this](bytelang::core::InputStream &stream) -> BridgeResult {
+                auto mode = stream.readByte();
+                if (not mode.hasValue()) { return Error::InstructionArgumentReadFail; }
+
+                auto count = stream.readByte();
+                if (not count.hasValue()) { return Error::InstructionArgumentReadFail; }
+
+                kf::u8 code[255];
+
+                for (kf::u8 i = 0; i < count.value(); i += 1) {
+                    auto byte = stream.readByte();
+                    if (not byte.hasValue()) { return Error::InstructionArgumentReadFail; }
+
+                    code[i] = byte.value();
+                }
+
+                if (not behaviour_executor.load(mode.value() != 0, code, count.value())) {
+                    kf_Logger_warn("behaviour too large");
+                }
+
+                return {};
+            },
+
+            // 0x16
+            // run_behaviour()
+            // Проверить и запустить загруженное поведение; прерывает примитивы движения и путь
+            // Итог проверки и ход исполнения - send_behaviour_status
+            [this](bytelang::core::InputStream &) -> BridgeResult {
+                motion_executor.cancel();
+                path_follower.cancel();
+
+                const auto fault = behaviour_executor.run();
+                if (fault != BehaviourVm::Fault::None) { kf_Logger_warn("behaviour rejected: %d", static_cast<int>(fault)); }
+
+                return send_behaviour_status(behaviour_executor.takeStatus());
+            },
+
+            // 0x17
+            // stop_behaviour()
+            // Прервать поведение (моторы останавливаются, если поведение ими управляло)
+            [this](bytelang::core::InputStream &) -> BridgeResult {
+                behaviour_executor.cancel();
+                return {};
+            },
+
+            // 0x18
+            // get_behaviour_status()
+            // Запросить состояние поведения
+            [this](bytelang::core::InputStream &) -> BridgeResult {
+                return send_behaviour_status(behaviour_executor.takeStatus());
+            },
 
+            // 0x19
+            // get_power_stats()
+            // Запросить отчёт питания за окно с прошлого запроса: задержки цикла и пробуждения, доля сна
+            [this](bytelang::core::InputStream &) -> BridgeResult {
+                return send_power_stats(power_manager.takeStats());
+            },
+
+            // 0x1A
+            // set_power_mode(mode: u8)
+            // Режим питания (PowerSettings::Mode) до перезагрузки; сохранить - через хранилище
+            [this](bytelang::core::InputStream &stream) -> BridgeResult {
+                auto mode = stream.readByte();
+                if (not mode.hasValue()) { return Error::InstructionArgumentReadFail; }
+
+                if (mode.value() > static_cast<kf::u8>(PowerSettings::Mode::Saving)) {
+                    kf_Logger_warn("no power mode #%d", mode.value());
+                    return {};
+                }
+
+                Periphery::instance().storage.settings.power.mode = static_cast<PowerSettings::Mode>(mode.value());
+                return {};
+            },
+
+            // 0x1B
+            // start_trace()
+            // Начать запись трассы с пустого кольца (сборка с ZMS_TRACE)
+            // На время записи - режим питания Performance: метки в тактах требуют постоянной частоты
+            [this](bytelang::core::InputStream &) -> BridgeResult {
+                if (not Trace::compiled) {
+                    kf_Logger_warn("trace points not compiled (ZMS_TRACE)");
+                    return {};
+                }
+
+                auto &power = Periphery::instance().storage.settings.power;
+
+                if (not Trace::active()) { trace_power_mode = power.mode; }
+
+                power.mode = PowerSettings::Mode::Performance;
+                Trace::start();
                 return {};
             },
 
+            // 0x1C
+            // dump_trace()
+            // Заморозить и выгрузить трассу: заголовок, затем фрагменты в последующих циклах
+            // Восстанавливает режим питания, действовавший до start_trace
+            [this](bytelang::core::InputStream &) -> BridgeResult {
+                if (Trace::active()) { Periphery::instance().storage.settings.power.mode = trace_power_mode; }
+
+                return send_trace_header(Trace::beginDump());
+            },
+
             //
         };
+
+#if defined(ZMS_TRACE)
+        // Каждая инструкция - участок трассы с кодом в аргументе
+        for (std::size_t code = 0; code < instructions.size(); code += 1) {
+            instructions[code] = [code, handler = std::move(instructions[code])](bytelang::core::InputStream &stream) -> BridgeResult {
+                zms_trace_scope(TracePoint::BridgeInstruction, code);
+                return handler(stream);
+            };
+        }
+#endif
+
+        return instructions;
     }
 };
 
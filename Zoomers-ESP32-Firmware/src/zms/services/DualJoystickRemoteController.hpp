@@ -1,29 +1,33 @@
 #pragma once
 
-#include <functional>
 #include <kf/Logger.hpp>
 #include <kf/tools/time/TimeoutManager.hpp>
 
 
 namespace zms {
 
-/// @brief Работает с пакетами данных с пульта
-struct DualJoystickRemoteController {
+/// @brief Пакет данных управления пульта
+struct DualJoystickControlPacket {
+    /// @brief Левый стик, ось X
+    float left_x{0};
 
-    /// @brief Пакет данных управления
-    struct ControlPacket {
-        /// @brief Левый стик, ось X
-        float left_x{0};
+    /// @brief Левый стик, ось Y
+    float left_y{0};
 
-        /// @brief Левый стик, ось Y
-        float left_y{0};
+    /// @brief Правый стик, ось X
+    float right_x{0};
 
-        /// @brief Правый стик, ось X
-        float right_x{0};
+    /// @brief Правый стик, ось Y
+    float right_y{0};
+};
 
-        /// @brief Правый стик, ось Y
-        float right_y{0};
-    };
+/// @brief Работает с пакетами данных с пульта
+/// @tparam Handler Обработчик событий пульта: `void onControl(const ControlPacket &)`, `void onDisconnect()`.
+/// Связывается при сборке: вызовы встраиваются, без std::function
+template<typename Handler> struct DualJoystickRemoteController {
+
+    /// @brief Пакет данных управления
+    using ControlPacket = DualJoystickControlPacket;
 
 private:
     /// @brief Менеджер тайм-аута пакета
@@ -36,13 +40,11 @@ private:
     ControlPacket packet{};
 
 public:
-    /// @brief Обработчик входящего пакета
-    std::function<void(const ControlPacket &)> control_handler{nullptr};
-
-    std::function<void(void)> disconnect_handler{nullptr};
+    /// @brief Обработчик событий пульта
+    Handler handler;
 
-    explicit DualJoystickRemoteController(kf::Milliseconds packet_timeout) :
-        packet_timeout_manager{packet_timeout} {}
+    explicit DualJoystickRemoteController(kf::Milliseconds packet_timeout, Handler handler) :
+        packet_timeout_manager{packet_timeout}, handler{handler} {}
 
     /// @brief Прокрутка событий
     void poll() {
@@ -53,11 +55,11 @@ public:
                 disconnected = true;
                 resetControlPacket();
 
-                if (disconnect_handler) { disconnect_handler(); }
+                handler.onDisconnect();
             }
         } else {
             disconnected = false;
-            if (control_handler) { control_handler(packet); }
+            handler.onControl(packet);
         }
     }
 
@@ -0,0 +1,227 @@
+#pragma once
+
+#include <kf/Logger.hpp>
+#include <kf/aliases.hpp>
+
+#include "zms/Periphery.hpp"
+#include "zms/hal/Hal.hpp"
+#include "zms/tools/TrapezoidalProfile.hpp"
+
+
+namespace zms {
+
+/// @brief Неблокирующий исполнитель траекторий манипулятора.
+/// Интерполяция выполняется в периодическом таймере с периодом сервоприводов (50 Гц),
+/// поэтому каждое обновление скважности попадает в отдельный импульс
+struct ManipulatorTrajectoryExecutor final {
+
+    /// @brief Целевая точка траектории
+    struct Waypoint {
+        /// @brief Угол звена
+        kf::u8 arm;
+
+        /// @brief Угол захвата
+        kf::u8 claw;
+
+        /// @brief Максимальная скорость (град/с)
+        kf::u16 max_velocity;
+
+        /// @brief Ускорение (град/с^2)
+        kf::u16 acceleration;
+    };
+
+    /// @brief Снимок состояния для отчёта по мосту
+    struct Progress {
+        /// @brief Текущий угол звена
+        kf::u8 arm;
+
+        /// @brief Текущий угол захвата
+        kf::u8 claw;
+
+        /// @brief Точек в очереди (включая исполняемую)
+        kf::u8 queued;
+
+        /// @brief Количество завершённых точек с момента последнего отчёта
+        kf::u8 completed;
+    };
+
+    /// @brief Ёмкость очереди точек
+    static constexpr kf::u8 queue_capacity = 16;
+
+private:
+    /// @brief Очередь точек (кольцевой буфер)
+    Waypoint queue[queue_capacity]{};
+
+    /// @brief Индекс головы очереди
+    kf::u8 head{0};
+
+    /// @brief Количество точек в очереди
+    kf::u8 count{0};
+
+    /// @brief Завершено точек с последнего отчёта
+    kf::u8 completed{0};
+
+    /// @brief Исполняемая точка уже загружена в профили
+    bool active{false};
+
+    /// @brief Положение осей известно (первая точка задаёт его без интерполяции)
+    bool homed{false};
+
+    /// @brief Профиль оси звена
+    TrapezoidalProfile arm_profile{};
+
+    /// @brief Профиль оси захвата
+    TrapezoidalProfile claw_profile{};
+
+    /// @brief Периодический таймер интерполяции
+    hal::PeriodicTimer timer{};
+
+    /// @brief Период интерполяции в секундах
+    kf::f32 period_s{0.02f};
+
+    /// @brief Защита очереди от одновременного доступа из таймера и основного цикла
+    hal::CriticalSection lock{};
+
+public:
+    /// @brief Запустить таймер интерполяции с периодом ШИМ сервоприводов
+    [[nodiscard]] bool init() {
+        const auto &servo_pwm = Periphery::instance().storage.settings.manipulator.servo_pwm;
+        const auto period_us = 1000000u / servo_pwm.ledc_frequency_hz;
+        period_s = kf::f32(period_us) * 1e-6f;
+
+        const bool started = timer.start(
+            "manipulator",
+            [](void *instance) { static_cast<ManipulatorTrajectoryExecutor *>(instance)->tick(); },
+            this,
+            period_us);
+
+        if (not started) {
+            kf_Logger_error("timer start fail");
+            return false;
+        }
+
+        return true;
+    }
+
+    /// @brief Добавить точку в очередь
+    /// @returns false, если очередь переполнена
+    [[nodiscard]] bool push(const Waypoint &waypoint) {
+        bool ok = false;
+
+        lock.enter();
+        if (count < queue_capacity) {
+            queue[(head + count) % queue_capacity] = waypoint;
+            count += 1;
+            ok = true;
+        }
+        lock.exit();
+
+        return ok;
+    }
+
+    /// @brief Прервать движение и очистить очередь.
+    /// Оси остаются в текущем положении
+    void cancel() {
+        lock.enter();
+        count = 0;
+        active = false;
+        arm_profile.reset(arm_profile.position);
+        claw_profile.reset(claw_profile.position);
+        lock.exit();
+    }
+
+    /// @brief Положение осей задано извне (прямое управление): продолжать от него
+    void rehome(kf::Degrees arm, kf::Degrees claw) {
+        lock.enter();
+        arm_profile.reset(kf::f32(arm));
+        claw_profile.reset(kf::f32(claw));
+        homed = true;
+        lock.exit();
+    }
+
+    /// @brief Положение звена задано извне, захват выключен: профиль захвата не меняется.
+    /// Положение известно не по обеим осям - первая точка по-прежнему задаёт его без интерполяции
+    void rehomeArm(kf::Degrees arm) {
+        lock.enter();
+        arm_profile.reset(kf::f32(arm));
+        lock.exit();
+    }
+
+    /// @brief Положение захвата задано извне, звено выключено: профиль звена не меняется
+    void rehomeClaw(kf::Degrees claw) {
+        lock.enter();
+        claw_profile.reset(kf::f32(claw));
+        lock.exit();
+    }
+
+    /// @brief Исполнитель занят
+    [[nodiscard]] inline bool busy() const { return count > 0; }
+
+    /// @brief Забрать снимок прогресса (сбрасывает счётчик завершённых точек)
+    [[nodiscard]] Progress takeProgress() {
+        lock.enter();
+        const Progress progress{
+            .arm = static_cast<kf::u8>(arm_profile.position),
+            .claw = static_cast<kf::u8>(claw_profile.position),
+            .queued = count,
+            .completed = completed,
+        };
+        completed = 0;
+        lock.exit();
+
+        return progress;
+    }
+
+    /// @brief Появились завершённые точки, о которых ещё не сообщено
+    [[nodiscard]] inline bool hasCompletions() const { return completed > 0; }
+
+private:
+    /// @brief Шаг интерполяции (контекст задачи таймера)
+    void tick() {
+        lock.enter();
+
+        if (count == 0) {
+            lock.exit();
+            return;
+        }
+
+        if (not active) {
+            const auto &waypoint = queue[head];
+
+            if (not homed) {
+                arm_profile.reset(waypoint.arm);
+                claw_profile.reset(waypoint.claw);
+                homed = true;
+            }
+
+            const TrapezoidalProfile::Limits limits{
+                kf::f32(waypoint.max_velocity),
+                kf::f32(waypoint.acceleration),
+            };
+
+            arm_profile.target = waypoint.arm;
+            arm_profile.limits = limits;
+            claw_profile.target = waypoint.claw;
+            claw_profile.limits = limits;
+            active = true;
+        }
+
+        const auto arm = arm_profile.step(period_s);
+        const auto claw = claw_profile.step(period_s);
+
+        if (arm_profile.done() and claw_profile.done()) {
+            head = (head + 1) % queue_capacity;
+            count -= 1;
+            completed += 1;
+            active = false;
+        }
+
+        // Запись под lock: после cancel() прямая команда или выключение осей из основного цикла
+        // не могут быть перезаписаны углом прерванной траектории
+        Periphery::instance().manipulator.set(static_cast<kf::Degrees>(arm), static_cast<kf::Degrees>(claw));
+
+        lock.exit();
+    }
+};
+
+}// namespace zms
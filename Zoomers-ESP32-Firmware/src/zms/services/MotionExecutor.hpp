@@ -0,0 +1,251 @@
+#pragma once
+
+#include <kf/Logger.hpp>
+
+#include "zms/Periphery.hpp"
+#include "zms/hal/Hal.hpp"
+#include "zms/services/ObstacleReflex.hpp"
+#include "zms/tools/MotionPrimitive.hpp"
+
+
+namespace zms {
+
+/// @brief Исполнитель бортовых примитивов движения (проезд, поворот).
+/// Регулятор работает в периодическом таймере, команды ставятся в очередь,
+/// о начале и завершении каждой команды сообщается событием
+struct MotionExecutor final {
+
+    /// @brief Режим постановки команды
+    enum class Mode : kf::u8 {
+        /// @brief Добавить в конец очереди
+        Append = 0x00,
+
+        /// @brief Прервать текущую, очистить очередь и исполнить немедленно
+        Replace = 0x01,
+    };
+
+    /// @brief Вид события
+    enum class EventKind : kf::u8 {
+        /// @brief Команда начата
+        Started = 0x00,
+
+        /// @brief Команда завершена в допуске
+        Completed = 0x01,
+
+        /// @brief Команда не достигла цели за время доводки
+        Timeout = 0x02,
+
+        /// @brief Команда отменена
+        Cancelled = 0x03,
+
+        /// @brief Команда отклонена (очередь переполнена)
+        Rejected = 0x04,
+    };
+
+    /// @brief Событие исполнения
+    struct Event {
+        /// @brief Идентификатор команды
+        kf::u8 id;
+
+        /// @brief Вид события
+        EventKind kind;
+
+        /// @brief Команд в очереди (включая исполняемую)
+        kf::u8 queued;
+
+        /// @brief Бортовое время события (мкс), заполняется при постановке в очередь
+        kf::u64 timestamp_us;
+    };
+
+    /// @brief Ёмкость очереди команд
+    static constexpr kf::u8 queue_capacity = 8;
+
+    /// @brief Ёмкость очереди событий
+    static constexpr kf::u8 events_capacity = 16;
+
+private:
+    /// @brief Выход на моторы через рефлекс
+    ObstacleReflex &reflex;
+
+    /// @brief Очередь команд
+    MotionPrimitive::Command queue[queue_capacity]{};
+    kf::u8 queue_head{0};
+    kf::u8 queue_count{0};
+
+    /// @brief Очередь событий
+    Event events[events_capacity]{};
+    kf::u8 events_head{0};
+    kf::u8 events_count{0};
+
+    /// @brief Исполняемый примитив
+    MotionPrimitive primitive{};
+
+    /// @brief Исполняемая команда загружена в примитив
+    bool active{false};
+
+    /// @brief Последний шаг регулятора записал моторы
+    bool driving{false};
+
+    /// @brief Периодический таймер регулятора
+    hal::PeriodicTimer timer{};
+
+    /// @brief Шаг регулятора (с)
+    kf::f32 period_s{0.005f};
+
+    /// @brief Защита очередей
+    hal::CriticalSection lock{};
+
+public:
+    explicit MotionExecutor(ObstacleReflex &reflex) :
+        reflex{reflex} {}
+
+    /// @brief Запустить регулятор
+    [[nodiscard]] bool init() {
+        const auto &settings = Periphery::instance().storage.settings.motion;
+        const auto period_us = 1000000u / settings.update_frequency_hz;
+        period_s = kf::f32(period_us) * 1e-6f;
+
+        const bool started = timer.start(
+            "motion",
+            [](void *instance) { static_cast<MotionExecutor *>(instance)->tick(); },
+            this,
+            period_us);
+
+        if (not started) {
+            kf_Logger_error("timer start fail");
+            return false;
+        }
+
+        return true;
+    }
+
+    /// @brief Поставить команду
+    void push(const MotionPrimitive::Command &command, Mode mode) {
+        lock.enter();
+
+        if (mode == Mode::Replace) { cancelLocked(); }
+
+        if (queue_count < queue_capacity) {
+            queue[(queue_head + queue_count) % queue_capacity] = command;
+            queue_count += 1;
+        } else {
+            pushEventLocked({command.id, EventKind::Rejected, queue_count, 0});
+        }
+
+        lock.exit();
+    }
+
+    /// @brief Отменить исполнение и очистить очередь.
+    /// Моторы останавливаются только если исполнитель ими управлял; после отмены он их не трогает,
+    /// поэтому команда, ради которой отменяли, не перезаписывается остановкой
+    void cancel() {
+        lock.enter();
+
+        cancelLocked();
+
+        if (driving) {
+            driving = false;
+            stopMotors();
+        }
+
+        lock.exit();
+    }
+
+    /// @brief Исполнитель управляет моторами
+    [[nodiscard]] inline bool busy() const { return queue_count > 0; }
+
+    /// @brief Забрать событие
+    /// @returns false, если событий нет
+    [[nodiscard]] bool popEvent(Event &event) {
+        lock.enter();
+
+        const bool ok = events_count > 0;
+
+        if (ok) {
+            event = events[events_head];
+            events_head = (events_head + 1) % events_capacity;
+            events_count -= 1;
+        }
+
+        lock.exit();
+        return ok;
+    }
+
+private:
+    /// @brief Отмена под блокировкой
+    void cancelLocked() {
+        if (active) {
+            pushEventLocked({queue[queue_head].id, EventKind::Cancelled, 0, 0});
+        }
+
+        for (kf::u8 i = active ? 1 : 0; i < queue_count; i += 1) {
+            pushEventLocked({queue[(queue_head + i) % queue_capacity].id, EventKind::Cancelled, 0, 0});
+        }
+
+        queue_count = 0;
+        active = false;
+    }
+
+    /// @brief Добавить событие (самое старое вытесняется при переполнении)
+    void pushEventLocked(const Event &event) {
+        if (events_count == events_capacity) {
+            events_head = (events_head + 1) % events_capacity;
+            events_count -= 1;
+        }
+
+        auto &slot = events[(events_head + events_count) % events_capacity];
+        slot = event;
+        slot.timestamp_us = hal::nowMicros();
+        events_count += 1;
+    }
+
+    inline void stopMotors() { reflex.stop(); }
+
+    /// @brief Шаг регулятора (контекст задачи таймера)
+    void tick() {
+        auto &periphery = Periphery::instance();
+        const auto &settings = periphery.storage.settings;
+
+        const auto left_mm = periphery.left_encoder.getPositionFixed().toFloat();
+        const auto right_mm = periphery.right_encoder.getPositionFixed().toFloat();
+
+        lock.enter();
+
+        if (queue_count == 0) {
+            // Очередь опустела по завершении: останавливаем моторы один раз (отмена останавливает их сама)
+            if (driving) {
+                driving = false;
+                stopMotors();
+            }
+
+            lock.exit();
+            return;
+        }
+
+        if (not active) {
+            primitive.start(queue[queue_head], settings.odometry.track_width_mm, left_mm, right_mm);
+            pushEventLocked({queue[queue_head].id, EventKind::Started, queue_count, 0});
+            active = true;
+        }
+
+        const auto output = primitive.update(settings.motion, period_s, left_mm, right_mm);
+        const auto state = primitive.getState();
+
+        if (state != MotionPrimitive::State::Running) {
+            const auto kind = (state == MotionPrimitive::State::Completed) ? EventKind::Completed : EventKind::Timeout;
+
+            queue_count -= 1;
+            pushEventLocked({queue[queue_head].id, kind, queue_count, 0});
+            queue_head = (queue_head + 1) % queue_capacity;
+            active = false;
+        }
+
+        // Запись под lock: выход, рассчитанный до одновременной отмены, не перезапишет более новую команду
+        driving = true;
+        reflex.set(output.left, output.right);
+
+        lock.exit();
+    }
+};
+
+}// namespace zms
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <kf/Logger.hpp>
+
+#include "zms/Periphery.hpp"
+#include "zms/hal/Hal.hpp"
+#include "zms/tools/ForwardLimiter.hpp"
+
+
+namespace zms {
+
+/// @brief Рефлекс уклонения от препятствий.
+/// Единственная точка записи команд в моторы: все источники (пульт, мост, регуляторы) проходят через него.
+/// Датчики опрашиваются в таймере, и при каждом новом замере последняя команда пересчитывается,
+/// поэтому торможение не ждёт следующей команды от источника
+struct ObstacleReflex final {
+
+    /// @brief Событие вмешательства
+    struct Event {
+        /// @brief Новый уровень вмешательства
+        ForwardLimiter::Level level;
+
+        /// @brief Расстояние левого датчика (мм)
+        kf::u16 left_mm;
+
+        /// @brief Расстояние правого датчика (мм)
+        kf::u16 right_mm;
+
+        /// @brief Бортовое время события (мкс)
+        kf::u64 timestamp_us;
+    };
+
+    /// @brief Ёмкость очереди событий
+    static constexpr kf::u8 events_capacity = 8;
+
+private:
+    /// @brief Последняя запрошенная команда
+    ForwardLimiter::Command requested{0, 0};
+
+    /// @brief Допустимая скорость вперёд по последнему замеру
+    kf::f32 limit{1.0f};
+
+    /// @brief Последние расстояния (мм)
+    kf::u16 left_mm{0xFFFF}, right_mm{0xFFFF};
+
+    /// @brief Текущий уровень вмешательства
+    ForwardLimiter::Level level{ForwardLimiter::Level::Pass};
+
+    /// @brief Очередь событий
+    Event events[events_capacity]{};
+    kf::u8 events_head{0};
+    kf::u8 events_count{0};
+
+    /// @brief Таймер опроса датчиков
+    hal::PeriodicTimer timer{};
+
+    /// @brief Защита состояния
+    hal::CriticalSection lock{};
+
+public:
+    /// @brief Запустить опрос датчиков
+    [[nodiscard]] bool init() {
+        const auto &settings = Periphery::instance().storage.settings.obstacle_reflex;
+
+        const bool started = timer.start(
+            "reflex",
+            [](void *instance) { static_cast<ObstacleReflex *>(instance)->sample(); },
+            this,
+            1000000u / settings.sample_frequency_hz);
+
+        if (not started) {
+            kf_Logger_error("timer start fail");
+            return false;
+        }
+
+        return true;
+    }
+
+    /// @brief Установить команды моторов (нормализованные)
+    void set(kf::f32 left, kf::f32 right) {
+        lock.enter();
+        requested = {left, right};
+        write(limitLocked());
+        lock.exit();
+    }
+
+    /// @brief Установить команды моторов (фиксированная точка, путь моста)
+    void setNormalized(NormalizedCommand left, NormalizedCommand right) {
+        set(left.toFloat(), right.toFloat());
+    }
+
+    /// @brief Остановить моторы (всегда разрешено)
+    inline void stop() { set(0, 0); }
+
+    /// @brief Последняя запрошенная команда (до ограничения)
+    [[nodiscard]] inline ForwardLimiter::Command requestedCommand() const { return requested; }
+
+    /// @brief Текущий уровень вмешательства
+    [[nodiscard]] inline ForwardLimiter::Level currentLevel() const { return level; }
+
+    /// @brief Расстояние левого датчика по последнему замеру (мм)
+    [[nodiscard]] inline kf::u16 leftDistance() const { return left_mm; }
+
+    /// @brief Расстояние правого датчика по последнему замеру (мм)
+    [[nodiscard]] inline kf::u16 rightDistance() const { return right_mm; }
+
+    /// @brief Забрать событие
+    /// @returns false, если событий нет
+    [[nodiscard]] bool popEvent(Event &event) {
+        lock.enter();
+
+        const bool ok = events_count > 0;
+
+        if (ok) {
+            event = events[events_head];
+            events_head = (events_head + 1) % events_capacity;
+            events_count -= 1;
+        }
+
+        lock.exit();
+        return ok;
+    }
+
+private:
+    /// @brief Пересчитать ограничение для последней команды, фиксируя смену уровня
+    ForwardLimiter::Command limitLocked() {
+        if (not Periphery::instance().storage.settings.obstacle_reflex.enabled) { return requested; }
+
+        ForwardLimiter::Level new_level;
+        const auto command = ForwardLimiter::apply(requested, limit, new_level);
+
+        if (new_level != level) {
+            level = new_level;
+
+            if (events_count == events_capacity) {
+                events_head = (events_head + 1) % events_capacity;
+                events_count -= 1;
+            }
+
+            events[(events_head + events_count) % events_capacity] = {level, left_mm, right_mm, hal::nowMicros()};
+            events_count += 1;
+        }
+
+        return command;
+    }
+
+    /// @brief Записать команду в моторы. Вызывается под lock: иначе команда, рассчитанная раньше,
+    /// могла бы попасть в моторы позже более новой из другой задачи.
+    /// После инициализации драйверов запись - несколько обращений к регистрам, без блокирующих вызовов
+    static void write(const ForwardLimiter::Command &command) {
+        auto &periphery = Periphery::instance();
+        Motor::setPair(periphery.left_motor, command.left, periphery.right_motor, command.right);
+    }
+
+    /// @brief Замер датчиков (контекст задачи таймера)
+    void sample() {
+        auto &periphery = Periphery::instance();
+        const auto &settings = periphery.storage.settings.obstacle_reflex;
+
+        const auto left = static_cast<kf::u16>(Sharp::distanceFromSum(periphery.left_distance_sensor.readRaw(), 1));
+        const auto right = static_cast<kf::u16>(Sharp::distanceFromSum(periphery.right_distance_sensor.readRaw(), 1));
+
+        const auto nearest = (left < right) ? left : right;
+        const auto new_limit = ForwardLimiter::forwardLimit(settings, nearest);
+
+        lock.enter();
+        left_mm = left;
+        right_mm = right;
+
+        limit = new_limit;
+
+        const bool was_limited = level != ForwardLimiter::Level::Pass;
+        const auto command = limitLocked();
+        const bool is_limited = level != ForwardLimiter::Level::Pass;
+
+        // Перезапись нужна только если ограничение действует или только что снято
+        if (was_limited or is_limited) { write(command); }
+
+        lock.exit();
+    }
+};
+
+}// namespace zms
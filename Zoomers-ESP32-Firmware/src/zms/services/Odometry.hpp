@@ -0,0 +1,124 @@
+#pragma once
+
+#include <kf/Logger.hpp>
+
+#include "zms/Periphery.hpp"
+#include "zms/hal/Hal.hpp"
+#include "zms/tools/DifferentialOdometry.hpp"
+
+
+namespace zms {
+
+/// @brief Бортовая одометрия.
+/// Интегрирует положения энкодеров в периодическом таймере с частотой из настроек
+struct Odometry final {
+
+    /// @brief Поза с меткой времени
+    struct Stamped {
+        /// @brief Поза
+        DifferentialOdometry::Pose pose;
+
+        /// @brief Время последнего интегрирования (мкс с момента запуска)
+        kf::u64 timestamp_us;
+    };
+
+private:
+    /// @brief Интегратор
+    DifferentialOdometry odometry{};
+
+    /// @brief Время последнего интегрирования
+    kf::u64 timestamp_us{0};
+
+    /// @brief Применённая колея (настройка редактируется на лету)
+    kf::f32 track_width_mm{0};
+
+    /// @brief Положение левого энкодера на прошлом шаге
+    Encoder::Ticks last_left{0};
+
+    /// @brief Положение правого энкодера на прошлом шаге
+    Encoder::Ticks last_right{0};
+
+    /// @brief Периодический таймер интегрирования
+    hal::PeriodicTimer timer{};
+
+    /// @brief Защита позы от одновременного доступа
+    hal::CriticalSection lock{};
+
+public:
+    /// @brief Запустить интегрирование
+    [[nodiscard]] bool init() {
+        auto &periphery = Periphery::instance();
+        const auto &settings = periphery.storage.settings.odometry;
+
+        applyTrackWidth(settings);
+        last_left = periphery.left_encoder.getPositionTicks();
+        last_right = periphery.right_encoder.getPositionTicks();
+
+        const bool started = timer.start(
+            "odometry",
+            [](void *instance) { static_cast<Odometry *>(instance)->tick(); },
+            this,
+            1000000u / settings.update_frequency_hz);
+
+        if (not started) {
+            kf_Logger_error("timer start fail");
+            return false;
+        }
+
+        return true;
+    }
+
+    /// @brief Снимок позы
+    [[nodiscard]] Stamped get() {
+        lock.enter();
+        const Stamped stamped{odometry.pose, timestamp_us};
+        lock.exit();
+
+        return stamped;
+    }
+
+    /// @brief Установить позу
+    void setPose(const DifferentialOdometry::Pose &pose) {
+        lock.enter();
+        odometry.pose = pose;
+        odometry.pose.heading = DifferentialOdometry::normalizeAngle(pose.heading);
+        lock.exit();
+    }
+
+    /// @brief Сбросить позу в начало координат
+    inline void reset() { setPose({0, 0, 0}); }
+
+    /// @brief Текущая поза (для отображения, без синхронизации)
+    [[nodiscard]] inline const DifferentialOdometry::Pose &pose() const { return odometry.pose; }
+
+private:
+    /// @brief Шаг интегрирования (контекст задачи таймера)
+    void tick() {
+        auto &periphery = Periphery::instance();
+
+        const auto &settings = periphery.storage.settings.odometry;
+        if (settings.track_width_mm != track_width_mm and settings.isValid()) { applyTrackWidth(settings); }
+
+        const auto left = periphery.left_encoder.getPositionTicks();
+        const auto right = periphery.right_encoder.getPositionTicks();
+
+        const auto delta_left = periphery.left_encoder.toFixedMillimeters(left - last_left);
+        const auto delta_right = periphery.right_encoder.toFixedMillimeters(right - last_right);
+
+        last_left = left;
+        last_right = right;
+
+        lock.enter();
+        odometry.update(delta_left, delta_right);
+        timestamp_us = hal::nowMicros();
+        lock.exit();
+    }
+
+    /// @brief Применить колею из настроек
+    void applyTrackWidth(const DifferentialOdometry::Settings &settings) {
+        track_width_mm = settings.track_width_mm;
+        odometry.setTrackWidth(track_width_mm);
+    }
+};
+
+}// namespace zms
@@ -0,0 +1,200 @@
+#pragma once
+
+#include <algorithm>
+#include <kf/Logger.hpp>
+
+#include "zms/Periphery.hpp"
+#include "zms/hal/Hal.hpp"
+#include "zms/services/ObstacleReflex.hpp"
+#include "zms/services/Odometry.hpp"
+#include "zms/tools/PurePursuit.hpp"
+
+
+namespace zms {
+
+/// @brief Бортовое следование по пути из точек.
+/// Путь загружается пакетами по мосту и может дополняться во время движения;
+/// регулятор работает в периодическом таймере поверх бортовой одометрии
+struct PathFollower final {
+
+    /// @brief Состояние следования
+    enum class State : kf::u8 {
+        /// @brief Путь не задан
+        Idle = 0x00,
+
+        /// @brief Движение по пути
+        Following = 0x01,
+
+        /// @brief Конечная точка достигнута
+        Completed = 0x02,
+
+        /// @brief Прервано
+        Cancelled = 0x03,
+    };
+
+    /// @brief Снимок прогресса
+    struct Progress {
+        /// @brief Пройдено сегментов с начала пути
+        kf::u16 passed_segments;
+
+        /// @brief Осталось сегментов
+        kf::u8 remaining_segments;
+
+        /// @brief Поперечная ошибка (мм)
+        kf::i16 cross_track_error_mm;
+
+        /// @brief Состояние
+        State state;
+    };
+
+private:
+    /// @brief Бортовая одометрия
+    Odometry &odometry;
+
+    /// @brief Выход на моторы через рефлекс
+    ObstacleReflex &reflex;
+
+    /// @brief Регулятор
+    PurePursuit pursuit{};
+
+    /// @brief Текущее состояние
+    State state{State::Idle};
+
+    /// @brief Состояние изменилось и ещё не сообщено
+    bool state_changed{false};
+
+    /// @brief Последний шаг регулятора записал моторы
+    bool driving{false};
+
+    /// @brief Периодический таймер регулятора
+    hal::PeriodicTimer timer{};
+
+    /// @brief Защита пути
+    hal::CriticalSection lock{};
+
+public:
+    explicit PathFollower(Odometry &odometry, ObstacleReflex &reflex) :
+        odometry{odometry}, reflex{reflex} {}
+
+    /// @brief Запустить регулятор
+    [[nodiscard]] bool init() {
+        const auto &settings = Periphery::instance().storage.settings.motion;
+
+        const bool started = timer.start(
+            "path",
+            [](void *instance) { static_cast<PathFollower *>(instance)->tick(); },
+            this,
+            1000000u / settings.update_frequency_hz);
+
+        if (not started) {
+            kf_Logger_error("timer start fail");
+            return false;
+        }
+
+        return true;
+    }
+
+    /// @brief Начать новый путь из текущей позы
+    void begin() {
+        const auto stamped = odometry.get();
+
+        lock.enter();
+        pursuit.clear();
+        (void) pursuit.append({stamped.pose.x, stamped.pose.y});
+        setStateLocked(State::Following);
+        lock.exit();
+    }
+
+    /// @brief Дописать точку в конец пути (допустимо во время движения)
+    /// @returns false, если путь заполнен
+    [[nodiscard]] bool append(const PurePursuit::Point &point) {
+        lock.enter();
+        const bool ok = pursuit.append(point);
+        if (ok and state != State::Following) { setStateLocked(State::Following); }
+        lock.exit();
+
+        return ok;
+    }
+
+    /// @brief Прервать следование.
+    /// Моторы останавливаются только если регулятор ими управлял; после отмены он их не трогает,
+    /// поэтому команда, ради которой отменяли, не перезаписывается остановкой
+    void cancel() {
+        lock.enter();
+
+        const bool was_following = state == State::Following;
+        pursuit.clear();
+        if (was_following) { setStateLocked(State::Cancelled); }
+
+        if (driving) {
+            driving = false;
+            reflex.stop();
+        }
+
+        lock.exit();
+    }
+
+    /// @brief Следование активно
+    [[nodiscard]] inline bool busy() const { return state == State::Following; }
+
+    /// @brief Состояние изменилось с последнего снимка
+    [[nodiscard]] inline bool stateChanged() const { return state_changed; }
+
+    /// @brief Снимок прогресса (сбрасывает флаг изменения состояния)
+    [[nodiscard]] Progress takeProgress() {
+        lock.enter();
+        const Progress progress{
+            .passed_segments = pursuit.passedSegments(),
+            .remaining_segments = pursuit.remainingSegments(),
+            .cross_track_error_mm = static_cast<kf::i16>(std::clamp(pursuit.crossTrackError(), -32767.0f, 32767.0f)),
+            .state = state,
+        };
+        state_changed = false;
+        lock.exit();
+
+        return progress;
+    }
+
+private:
+    void setStateLocked(State new_state) {
+        state = new_state;
+        state_changed = true;
+    }
+
+    /// @brief Шаг регулятора (контекст задачи таймера)
+    void tick() {
+        auto &periphery = Periphery::instance();
+        const auto &settings = periphery.storage.settings;
+
+        const auto stamped = odometry.get();
+
+        lock.enter();
+
+        if (state != State::Following) {
+            // Путь пройден: останавливаем моторы один раз (отмена останавливает их сама)
+            if (driving) {
+                driving = false;
+                reflex.stop();
+            }
+
+            lock.exit();
+            return;
+        }
+
+        const auto output = pursuit.update(settings.path_follower, stamped.pose, settings.odometry.track_width_mm);
+
+        if (pursuit.finished()) {
+            setStateLocked(State::Completed);
+        } else {
+            // Запись под lock: выход, рассчитанный до одновременной отмены, не перезапишет более новую команду
+            driving = true;
+            reflex.set(
+                output.left * settings.motion.velocity_feedforward,
+                output.right * settings.motion.velocity_feedforward);
+        }
+
+        lock.exit();
+    }
+};
+
+}// namespace zms
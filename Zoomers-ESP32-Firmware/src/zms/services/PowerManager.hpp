@@ -0,0 +1,324 @@
+#pragma once
+
+#include <kf/Logger.hpp>
+
+#include "zms/Periphery.hpp"
+#include "zms/hal/Hal.hpp"
+#include "zms/services/BehaviourExecutor.hpp"
+#include "zms/services/ManipulatorTrajectoryExecutor.hpp"
+#include "zms/services/MotionExecutor.hpp"
+#include "zms/services/ObstacleReflex.hpp"
+#include "zms/services/PathFollower.hpp"
+#include "zms/tools/PowerPolicy.hpp"
+
+
+namespace zms {
+
+/// @brief Управление питанием: частота ЦП и сон основного цикла по активности.
+/// Пока контур управления занят или активность была недавно, удерживается наибольшая частота;
+/// в простое частота падает, цикл уступает время или (Saving) засыпает короткими отрезками.
+/// Активность: пакеты ESP-NOW и команды моста (notifyActivity), движение колёс, пробуждение не по таймеру.
+/// Вызывается в конце каждой итерации основного цикла (idle)
+struct PowerManager final {
+
+    /// @brief Настройки
+    using Settings = PowerSettings;
+
+    /// @brief Уровень
+    using Level = PowerPolicy::Level;
+
+    /// @brief Отчёт за окно (с прошлого takeStats)
+    struct Stats {
+        /// @brief Режим
+        Settings::Mode mode;
+
+        /// @brief Текущий уровень
+        Level level;
+
+        /// @brief Частота ЦП (МГц)
+        kf::u16 frequency_mhz;
+
+        /// @brief Работа одной итерации основного цикла: средняя и наибольшая (мкс)
+        kf::u32 loop_mean_us, loop_max_us;
+
+        /// @brief Выход из простоя до конца первой итерации на полной частоте: средняя и наибольшая (мкс)
+        kf::u32 wake_mean_us, wake_max_us;
+
+        /// @brief Входов в лёгкий сон
+        kf::u32 sleeps;
+
+        /// @brief Доля времени во сне (промилле)
+        kf::u16 sleep_permille;
+    };
+
+private:
+    /// @brief Рефлекс (запрошенная команда моторов)
+    ObstacleReflex &reflex;
+
+    /// @brief Примитивы движения
+    MotionExecutor &motion_executor;
+
+    /// @brief Следование по пути
+    PathFollower &path_follower;
+
+    /// @brief Поведения
+    BehaviourExecutor &behaviour_executor;
+
+    /// @brief Траектории манипулятора
+    ManipulatorTrajectoryExecutor &manipulator_executor;
+
+    /// @brief Политика
+    PowerPolicy policy{};
+
+    /// @brief Применённые настройки
+    Settings applied{};
+
+    /// @brief Частотой управляет ESP-IDF (DFS), иначе - вручную
+    bool automatic{false};
+
+    /// @brief Лёгкий сон выполняет планировщик ESP-IDF
+    bool automatic_sleep{false};
+
+    /// @brief Блокировка наибольшей частоты (DFS)
+    hal::PerformanceLock performance_lock{};
+
+    /// @brief Текущий уровень
+    Level level{Level::Active};
+
+    /// @brief Активность из другой задачи (приём ESP-NOW)
+    volatile bool notified{false};
+
+    /// @brief Положения энкодеров на прошлой итерации
+    Encoder::Ticks last_left{0}, last_right{0};
+
+    /// @brief Начало работы текущей итерации (мкс)
+    kf::u64 iteration_start_us{0};
+
+    /// @brief Выход из простоя, задержка которого ещё не учтена (мкс), 0 - нет
+    kf::u64 wake_us{0};
+
+    /// @brief Начало окна отчёта (мкс)
+    kf::u64 window_start_us{0};
+
+    /// @brief Время во сне за окно (мкс)
+    kf::u64 slept_us{0};
+
+    /// @brief Входов в сон за окно
+    kf::u32 sleeps{0};
+
+    LatencyStats loop_latency{}, wake_latency{};
+
+public:
+    explicit PowerManager(
+        ObstacleReflex &reflex,
+        MotionExecutor &motion_executor,
+        PathFollower &path_follower,
+        BehaviourExecutor &behaviour_executor,
+        ManipulatorTrajectoryExecutor &manipulator_executor
+    ) :
+        reflex{reflex},
+        motion_executor{motion_executor},
+        path_follower{path_follower},
+        behaviour_executor{behaviour_executor},
+        manipulator_executor{manipulator_executor} {}
+
+    /// @brief Применить настройки и начать отсчёт
+    [[nodiscard]] bool init() {
+        iteration_start_us = window_start_us = hal::nowMicros();
+        policy.activity(hal::nowMillis());
+
+        return apply(Periphery::instance().storage.settings.power);
+    }
+
+    /// @brief Отметить активность (из любой задачи, не из прерывания)
+    inline void notifyActivity() { notified = true; }
+
+    /// @brief Конец итерации основного цикла: учёт задержки, выбор уровня, простой или сон
+    void idle() {
+        const auto now_us = hal::nowMicros();
+        loop_latency.add(now_us - iteration_start_us);
+
+        if (wake_us != 0) {
+            wake_latency.add(now_us - wake_us);
+            wake_us = 0;
+        }
+
+        const auto &settings = Periphery::instance().storage.settings.power;
+        if (changed(settings)) { (void) apply(settings); }
+
+        const auto now_ms = static_cast<kf::u32>(now_us / 1000);
+        if (sensedActivity()) { policy.activity(now_ms); }
+
+        enter(policy.decide(settings, busy(), now_ms), now_us);
+
+        switch (level) {
+            case Level::Active: break;
+
+            case Level::Idle:
+                // Задача простоя ждёт прерывания (waiti): ядро не крутит цикл
+                hal::delayMillis(1);
+                break;
+
+            case Level::Sleep:
+                sleep(settings);
+                break;
+        }
+
+        iteration_start_us = hal::nowMicros();
+    }
+
+    /// @brief Отчёт за окно (начинает новое)
+    [[nodiscard]] Stats takeStats() {
+        const auto now_us = hal::nowMicros();
+        const auto window_us = now_us - window_start_us;
+
+        const Stats stats{
+            .mode = applied.mode,
+            .level = level,
+            .frequency_mhz = static_cast<kf::u16>(hal::cycleFrequencyMhz()),
+            .loop_mean_us = loop_latency.mean(),
+            .loop_max_us = loop_latency.max_us,
+            .wake_mean_us = wake_latency.mean(),
+            .wake_max_us = wake_latency.max_us,
+            .sleeps = sleeps,
+            .sleep_permille = static_cast<kf::u16>(window_us == 0 ? 0 : std::min<kf::u64>(1000, slept_us * 1000 / window_us)),
+        };
+
+        loop_latency.reset();
+        wake_latency.reset();
+        slept_us = 0;
+        sleeps = 0;
+        window_start_us = now_us;
+
+        return stats;
+    }
+
+private:
+    /// @brief Контур управления занят
+    [[nodiscard]] bool busy() const {
+        const auto command = reflex.requestedCommand();
+
+        return command.left != 0 or command.right != 0 or
+               motion_executor.busy() or path_follower.busy() or
+               behaviour_executor.busy() or manipulator_executor.busy();
+    }
+
+    /// @brief Активность с прошлой итерации
+    [[nodiscard]] bool sensedActivity() {
+        auto &periphery = Periphery::instance();
+
+        const auto left = periphery.left_encoder.getPositionTicks();
+        const auto right = periphery.right_encoder.getPositionTicks();
+        const bool moved = left != last_left or right != last_right;
+        last_left = left;
+        last_right = right;
+
+        const bool was_notified = notified;
+        notified = false;
+
+        return was_notified or moved;
+    }
+
+    /// @brief Перейти на уровень
+    void enter(Level next, kf::u64 now_us) {
+        if (next == level) { return; }
+
+        const bool was_active = level == Level::Active;
+        level = next;
+
+        if (level == Level::Active) {
+            // Задержка пробуждения: от конца простоя (или выхода из сна) до конца первой итерации на полной частоте
+            if (wake_us == 0) { wake_us = now_us; }
+            setPerformance(true);
+        } else if (was_active) {
+            setPerformance(false);
+        }
+    }
+
+    /// @brief Лёгкий сон одним отрезком
+    void sleep(const Settings &settings) {
+        if (automatic_sleep) {
+            // Сон выполняет планировщик в задаче простоя
+            hal::delayMillis(settings.sleep_slice_ms);
+            return;
+        }
+
+        const auto &pins = Periphery::instance().storage.settings;
+        const kf::u8 wake_pins[] = {pins.left_encoder.phase_a, pins.right_encoder.phase_a};
+
+        const auto before_us = hal::nowMicros();
+        const auto cause = hal::lightSleep(kf::u32(settings.sleep_slice_ms) * 1000u, wake_pins, sizeof(wake_pins));
+        const auto after_us = hal::nowMicros();
+
+        sleeps += 1;
+        slept_us += after_us - before_us;
+        policy.woke(static_cast<kf::u32>(after_us / 1000));
+
+        if (cause != hal::WakeCause::Timer) {
+            policy.activity(static_cast<kf::u32>(after_us / 1000));
+            enter(Level::Active, after_us);
+        }
+    }
+
+    /// @brief Наибольшая или наименьшая частота
+    void setPerformance(bool performance) {
+        if (automatic) {
+            if (performance) {
+                performance_lock.acquire();
+            } else {
+                performance_lock.release();
+            }
+
+            return;
+        }
+
+        (void) hal::cpuFrequencySet(performance ? applied.max_frequency_mhz : applied.min_frequency_mhz);
+    }
+
+    [[nodiscard]] bool changed(const Settings &settings) const {
+        return settings.mode != applied.mode or
+               settings.max_frequency_mhz != applied.max_frequency_mhz or
+               settings.min_frequency_mhz != applied.min_frequency_mhz;
+    }
+
+    /// @brief Применить режим и частоты (прочие настройки читаются на каждой итерации)
+    /// @returns false - частоту задать не удалось
+    bool apply(const Settings &settings) {
+        // Из простоя выходим на полной частоте прежних настроек, затем перенастраиваем
+        if (level != Level::Active) {
+            level = Level::Active;
+            setPerformance(true);
+        }
+
+        if (automatic) { performance_lock.release(); }
+
+        applied = settings;
+
+        // Автоматический сон требует tickless idle; без него - DFS и сон отрезками из цикла
+        const bool light_sleep = settings.mode == Settings::Mode::Saving;
+        const auto max_mhz = settings.max_frequency_mhz;
+        const auto min_mhz = settings.min_frequency_mhz;
+
+        automatic_sleep = false;
+        automatic = performance_lock.create("zms_power");
+
+        if (automatic) {
+            automatic_sleep = light_sleep and hal::powerConfigure(max_mhz, min_mhz, true);
+            automatic = automatic_sleep or hal::powerConfigure(max_mhz, min_mhz, false);
+        }
+
+        if (automatic) {
+            performance_lock.acquire();
+            return true;
+        }
+
+        if (not hal::cpuFrequencySet(settings.max_frequency_mhz)) {
+            kf_Logger_error("cpu frequency %d MHz fail", settings.max_frequency_mhz);
+            return false;
+        }
+
+        return true;
+    }
+};
+
+}// namespace zms
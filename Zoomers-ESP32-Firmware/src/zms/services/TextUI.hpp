@@ -1,25 +1,32 @@
 #pragma once
 
-#include <functional>
 #include <kf/Logger.hpp>
 #include <kf/UI.hpp>
+#include <type_traits>
 
 #include "zms/Periphery.hpp"
+#include "zms/services/Odometry.hpp"
 #include "zms/ui/pages/EncoderConversionSettingsPage.hpp"
 #include "zms/ui/pages/EncoderTunePage.hpp"
 #include "zms/ui/pages/MainPage.hpp"
 #include "zms/ui/pages/MotorPwmSettingsPage.hpp"
 #include "zms/ui/pages/MotorTunePage.hpp"
+#include "zms/ui/pages/OdometryPage.hpp"
 #include "zms/ui/pages/StoragePage.hpp"
 
 
 namespace zms {
 
+/// @brief Отправитель UI-заглушка: отправки нет (на хосте)
+struct TextUINullSender {};
+
 /// @brief ZMS Text UI
-struct TextUI final {
+/// @tparam Sender Отправитель кадра UI: `bool operator()(kf::slice<const kf::u8>)`.
+/// Связывается при сборке: вызов встраивается, без std::function
+template<typename Sender> struct TextUI final {
 
-    /// @brief Обработчик отправки UI
-    std::function<bool(kf::slice<const kf::u8>)> send_handler{nullptr};
+    /// @brief Отправитель кадра UI
+    Sender sender;
 
 private:
     /// @brief Страница управления хранилищем настроек
@@ -43,10 +50,15 @@ private:
 
     //
 
+    /// @brief Страница одометрии
+    OdometryPage odometry_page;
+
+    //
+
 public:
     /// @brief Публичный конструктор для сервиса
-    explicit TextUI() :
-        TextUI{Periphery::instance()} {}
+    explicit TextUI(Odometry &odometry, Sender sender = {}) :
+        TextUI{Periphery::instance(), odometry, sender} {}
 
     /// @brief Добавить событие в очередь
     /// @param event
@@ -65,23 +77,25 @@ public:
 
         const auto slice = page_manager.render();
 
-        if (nullptr == send_handler) {
+        if constexpr (std::is_same_v<Sender, TextUINullSender>) {
             kf_Logger_warn("sender is null");
             return;
-        }
+        } else {
+            const auto send_ok = sender(slice);
 
-        const auto send_ok = send_handler(slice);
+            if (not send_ok) {
+                kf_Logger_error("send failed");
+                return;
+            }
 
-        if (not send_ok) {
-            kf_Logger_error("send failed");
-            return;
+            kf_Logger_debug("%d bytes send", slice.size);
         }
-
-        kf_Logger_debug("%d bytes send", slice.size);
     }
 
 private:
-    explicit TextUI(Periphery &p) :
+    explicit TextUI(Periphery &p, Odometry &odometry, Sender sender) :
+
+        sender{sender},
 
         storage_page{p},
 
@@ -117,7 +131,9 @@ private:
 
         encoder_conversion_settings_page{
             p.storage.settings.encoder_conversion
-        } {
+        },
+
+        odometry_page{odometry} {
 
         kf::UI::instance().bind(MainPage::instance());
     }
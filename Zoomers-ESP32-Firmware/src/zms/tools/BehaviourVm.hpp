@@ -0,0 +1,602 @@
+#pragma once
+
+#include <cstring>
+#include <kf/aliases.hpp>
+#include <kf/tools/validation.hpp>
+
+
+namespace zms {
+
+/// @brief Настройки исполнителя поведений
+struct BehaviourSettings : kf::tools::Validable<BehaviourSettings> {
+    /// @brief Частота шага программы (Гц)
+    kf::u16 update_frequency_hz;
+
+    /// @brief Наибольшее число инструкций за шаг
+    kf::u16 instruction_budget;
+
+    void check(kf::tools::Validator &validator) const {
+        kf_Validator_check(validator, update_frequency_hz > 0);
+        kf_Validator_check(validator, update_frequency_hz <= 1000);
+        kf_Validator_check(validator, instruction_budget > 0);
+    }
+};
+
+/// @brief Виртуальная машина поведений: байткод, загружаемый с хоста.
+/// Восемь регистров i32, без памяти и стека; программа проверяется целиком перед запуском
+/// (коды, регистры, источники, цели переходов), поэтому при исполнении выход за границы невозможен.
+/// Машина не обращается к периферии: входы - снимок датчиков, выходы - команды, применяемые исполнителем
+struct BehaviourVm final {
+
+    /// @brief Коды инструкций (операнды: r - индекс регистра u8, imm - i16, addr - u16, LE)
+    enum class Opcode : kf::u8 {
+        /// @brief halt - завершить программу
+        Halt = 0x00,
+
+        /// @brief li r, imm - загрузить константу
+        LoadImmediate = 0x01,
+
+        /// @brief mov rd, rs
+        Move = 0x02,
+
+        /// @brief add rd, rs - rd += rs
+        Add = 0x03,
+
+        /// @brief sub rd, rs - rd -= rs
+        Subtract = 0x04,
+
+        /// @brief addi rd, imm - rd += imm
+        AddImmediate = 0x05,
+
+        /// @brief mul rd, rs - rd *= rs
+        Multiply = 0x06,
+
+        /// @brief shr rd, n - арифметический сдвиг вправо (n < 32)
+        ShiftRight = 0x07,
+
+        /// @brief jmp addr
+        Jump = 0x10,
+
+        /// @brief jlt ra, rb, addr - переход, если ra < rb
+        JumpLess = 0x11,
+
+        /// @brief jge ra, rb, addr - переход, если ra >= rb
+        JumpGreaterEqual = 0x12,
+
+        /// @brief jeq ra, rb, addr - переход, если ra == rb
+        JumpEqual = 0x13,
+
+        /// @brief jne ra, rb, addr - переход, если ra != rb
+        JumpNotEqual = 0x14,
+
+        /// @brief sense rd, source - прочитать датчик (Source)
+        Sense = 0x20,
+
+        /// @brief clock rd - время с запуска программы (мс)
+        Clock = 0x21,
+
+        /// @brief drive rl, rr - команды моторов [-1000, 1000]
+        Drive = 0x30,
+
+        /// @brief stop - остановить моторы
+        Stop = 0x31,
+
+        /// @brief arm r - угол звена (град)
+        Arm = 0x32,
+
+        /// @brief claw r - угол захвата (град)
+        Claw = 0x33,
+
+        /// @brief wait r - ждать r мс (завершает шаг)
+        Wait = 0x40,
+
+        /// @brief yield - завершить шаг
+        Yield = 0x41,
+
+        /// @brief report r - сообщить значение хосту
+        Report = 0x42,
+    };
+
+    /// @brief Источник sense
+    enum class Source : kf::u8 {
+        /// @brief Левый датчик расстояния (мм)
+        LeftDistance = 0x00,
+
+        /// @brief Правый датчик расстояния (мм)
+        RightDistance = 0x01,
+
+        /// @brief Путь левого колеса (мм)
+        LeftEncoder = 0x02,
+
+        /// @brief Путь правого колеса (мм)
+        RightEncoder = 0x03,
+
+        /// @brief Поза одометрии: X (мм)
+        PoseX = 0x04,
+
+        /// @brief Поза одометрии: Y (мм)
+        PoseY = 0x05,
+
+        /// @brief Поза одометрии: курс (град)
+        Heading = 0x06,
+    };
+
+    /// @brief Состояние машины
+    enum class State : kf::u8 {
+        /// @brief Программы нет
+        Empty = 0x00,
+
+        /// @brief Программа загружена, не запущена
+        Ready = 0x01,
+
+        /// @brief Исполняется
+        Running = 0x02,
+
+        /// @brief Завершилась (halt или конец кода)
+        Halted = 0x03,
+
+        /// @brief Отклонена проверкой или остановлена ошибкой
+        Faulted = 0x04,
+
+        /// @brief Прервана
+        Cancelled = 0x05,
+    };
+
+    /// @brief Ошибка программы
+    enum class Fault : kf::u8 {
+        None = 0x00,
+
+        /// @brief Пустая программа
+        Empty = 0x01,
+
+        /// @brief Программа больше ёмкости
+        Overflow = 0x02,
+
+        /// @brief Последняя инструкция обрезана
+        Truncated = 0x03,
+
+        /// @brief Неизвестный код инструкции
+        BadOpcode = 0x04,
+
+        /// @brief Индекс регистра вне диапазона
+        BadRegister = 0x05,
+
+        /// @brief Неизвестный источник или недопустимый операнд
+        BadOperand = 0x06,
+
+        /// @brief Переход не на начало инструкции
+        BadJump = 0x07,
+    };
+
+    /// @brief Ёмкость программы (байт)
+    static constexpr kf::u16 program_capacity = 512;
+
+    /// @brief Число регистров
+    static constexpr kf::u8 register_count = 8;
+
+    /// @brief Число источников sense
+    static constexpr kf::u8 source_count = static_cast<kf::u8>(Source::Heading) + 1;
+
+    /// @brief Снимок входов на шаг
+    struct Inputs {
+        /// @brief Значения по индексу Source
+        kf::i32 values[source_count];
+    };
+
+    /// @brief Команды, выданные за шаг (применяются после шага; действует последняя)
+    struct Outputs {
+        /// @brief Команды моторов выданы
+        bool drive;
+
+        /// @brief Команды моторов [-1000, 1000]
+        kf::i32 left, right;
+
+        /// @brief Угол звена выдан
+        bool arm;
+
+        /// @brief Угол звена (град)
+        kf::i32 arm_angle;
+
+        /// @brief Угол захвата выдан
+        bool claw;
+
+        /// @brief Угол захвата (град)
+        kf::i32 claw_angle;
+
+        /// @brief Значение для хоста выдано
+        bool report;
+
+        /// @brief Значение для хоста
+        kf::i32 report_value;
+    };
+
+private:
+    /// @brief Код программы
+    kf::u8 code[program_capacity]{};
+
+    /// @brief Длина программы
+    kf::u16 size{0};
+
+    /// @brief Регистры
+    kf::i32 registers[register_count]{};
+
+    /// @brief Счётчик инструкций
+    kf::u16 pc{0};
+
+    /// @brief Время запуска (мс)
+    kf::u32 start_ms{0};
+
+    /// @brief Время окончания ожидания (мс)
+    kf::u32 wake_ms{0};
+
+    /// @brief Исполнено инструкций с запуска
+    kf::u32 executed{0};
+
+    State state{State::Empty};
+
+    Fault fault{Fault::None};
+
+public:
+    /// @brief Стереть программу
+    void clear() {
+        size = 0;
+        state = State::Empty;
+        fault = Fault::None;
+    }
+
+    /// @brief Дописать байты кода (не во время исполнения)
+    /// @returns false - исполняется или программа переполнена (Fault::Overflow)
+    [[nodiscard]] bool append(const kf::u8 *bytes, kf::u16 count) {
+        if (state == State::Running) { return false; }
+
+        // После переполнения программа неполна: дописывать можно только после clear()
+        if (fault == Fault::Overflow) { return false; }
+
+        if (count > program_capacity - size) {
+            state = State::Faulted;
+            fault = Fault::Overflow;
+            return false;
+        }
+
+        std::memcpy(code + size, bytes, count);
+        size += count;
+        state = State::Ready;
+        fault = Fault::None;
+        return true;
+    }
+
+    /// @brief Проверить и запустить программу с начала
+    /// @returns Fault::None - запущена
+    Fault start(kf::u32 now_ms) {
+        if (state == State::Empty) { return fault = Fault::Empty; }
+        if (state == State::Running) { return Fault::None; }
+        if (fault == Fault::Overflow) { return fault; }
+
+        fault = verify(code, size);
+
+        if (fault != Fault::None) {
+            state = State::Faulted;
+            return fault;
+        }
+
+        std::memset(registers, 0, sizeof(registers));
+        pc = 0;
+        start_ms = now_ms;
+        wake_ms = now_ms;
+        executed = 0;
+        state = State::Running;
+        return Fault::None;
+    }
+
+    /// @brief Прервать исполнение
+    /// @returns Программа исполнялась
+    bool cancel() {
+        if (state != State::Running) { return false; }
+
+        state = State::Cancelled;
+        return true;
+    }
+
+    [[nodiscard]] inline State getState() const { return state; }
+
+    [[nodiscard]] inline Fault getFault() const { return fault; }
+
+    [[nodiscard]] inline kf::u16 getPc() const { return pc; }
+
+    [[nodiscard]] inline kf::u16 getSize() const { return size; }
+
+    [[nodiscard]] inline kf::u32 getExecuted() const { return executed; }
+
+    [[nodiscard]] inline kf::i32 getRegister(kf::u8 index) const { return registers[index]; }
+
+    /// @brief Длина инструкции в байтах (0 - неизвестный код)
+    [[nodiscard]] static constexpr kf::u8 length(kf::u8 opcode) {
+        switch (static_cast<Opcode>(opcode)) {
+            case Opcode::Halt:
+            case Opcode::Stop:
+            case Opcode::Yield:
+                return 1;
+
+            case Opcode::Clock:
+            case Opcode::Arm:
+            case Opcode::Claw:
+            case Opcode::Wait:
+            case Opcode::Report:
+                return 2;
+
+            case Opcode::Move:
+            case Opcode::Add:
+            case Opcode::Subtract:
+            case Opcode::Multiply:
+            case Opcode::ShiftRight:
+            case Opcode::Jump:
+            case Opcode::Sense:
+            case Opcode::Drive:
+                return 3;
+
+            case Opcode::LoadImmediate:
+            case Opcode::AddImmediate:
+                return 4;
+
+            case Opcode::JumpLess:
+            case Opcode::JumpGreaterEqual:
+            case Opcode::JumpEqual:
+            case Opcode::JumpNotEqual:
+                return 5;
+        }
+
+        return 0;
+    }
+
+    /// @brief Проверка программы: каждая инструкция целиком в коде, операнды в диапазоне,
+    /// переходы - на начало инструкции (или на конец кода: завершение)
+    [[nodiscard]] static Fault verify(const kf::u8 *code, kf::u16 size) {
+        if (size == 0) { return Fault::Empty; }
+        if (size > program_capacity) { return Fault::Overflow; }
+
+        // Начала инструкций
+        kf::u8 starts[program_capacity / 8]{};
+
+        for (kf::u16 at = 0; at < size;) {
+            const auto n = length(code[at]);
+            if (n == 0) { return Fault::BadOpcode; }
+            if (at + n > size) { return Fault::Truncated; }
+
+            starts[at / 8] |= static_cast<kf::u8>(1u << (at % 8));
+            at += n;
+        }
+
+        const auto isStart = [&](kf::u16 target) {
+            return target == size or (target < size and (starts[target / 8] & (1u << (target % 8))) != 0);
+        };
+
+        const auto isRegister = [](kf::u8 r) { return r < register_count; };
+
+        for (kf::u16 at = 0; at < size; at += length(code[at])) {
+            const auto *op = code + at;
+
+            switch (static_cast<Opcode>(op[0])) {
+                case Opcode::Halt:
+                case Opcode::Stop:
+                case Opcode::Yield:
+                    break;
+
+                case Opcode::Clock:
+                case Opcode::Arm:
+                case Opcode::Claw:
+                case Opcode::Wait:
+                case Opcode::Report:
+                case Opcode::LoadImmediate:
+                case Opcode::AddImmediate:
+                    if (not isRegister(op[1])) { return Fault::BadRegister; }
+                    break;
+
+                case Opcode::Move:
+                case Opcode::Add:
+                case Opcode::Subtract:
+                case Opcode::Multiply:
+                case Opcode::Drive:
+                    if (not isRegister(op[1]) or not isRegister(op[2])) { return Fault::BadRegister; }
+                    break;
+
+                case Opcode::ShiftRight:
+                    if (not isRegister(op[1])) { return Fault::BadRegister; }
+                    if (op[2] >= 32) { return Fault::BadOperand; }
+                    break;
+
+                case Opcode::Sense:
+                    if (not isRegister(op[1])) { return Fault::BadRegister; }
+                    if (op[2] >= source_count) { return Fault::BadOperand; }
+                    break;
+
+                case Opcode::Jump:
+                    if (not isStart(address(op + 1))) { return Fault::BadJump; }
+                    break;
+
+                case Opcode::JumpLess:
+                case Opcode::JumpGreaterEqual:
+                case Opcode::JumpEqual:
+                case Opcode::JumpNotEqual:
+                    if (not isRegister(op[1]) or not isRegister(op[2])) { return Fault::BadRegister; }
+                    if (not isStart(address(op + 3))) { return Fault::BadJump; }
+                    break;
+            }
+        }
+
+        return Fault::None;
+    }
+
+    /// @brief Шаг программы: до budget инструкций, до wait / yield или до завершения
+    /// @param now_ms Бортовое время (мс)
+    /// @returns Состояние после шага
+    State step(const Inputs &inputs, Outputs &outputs, kf::u32 now_ms, kf::u16 budget) {
+        if (state != State::Running) { return state; }
+
+        // Ожидание (разность со знаком: переполнение счётчика мс безвредно)
+        if (static_cast<kf::i32>(now_ms - wake_ms) < 0) { return state; }
+
+        // Счётчики - в локальных переменных: запись регистров (i32) не заставляет перечитывать их из памяти
+        auto at = pc;
+        kf::u16 n = 0;
+
+        const auto suspend = [&](State next) {
+            pc = at;
+            executed += n;
+            return state = next;
+        };
+
+        while (n < budget) {
+            if (at >= size) { return suspend(State::Halted); }
+
+            const auto *op = code + at;
+            n += 1;
+
+            switch (static_cast<Opcode>(op[0])) {
+                case Opcode::Halt:
+                    return suspend(State::Halted);
+
+                case Opcode::LoadImmediate:
+                    registers[op[1]] = immediate(op + 2);
+                    break;
+
+                case Opcode::Move:
+                    registers[op[1]] = registers[op[2]];
+                    break;
+
+                case Opcode::Add:
+                    registers[op[1]] = wrap(kf::u32(registers[op[1]]) + kf::u32(registers[op[2]]));
+                    break;
+
+                case Opcode::Subtract:
+                    registers[op[1]] = wrap(kf::u32(registers[op[1]]) - kf::u32(registers[op[2]]));
+                    break;
+
+                case Opcode::AddImmediate:
+                    registers[op[1]] = wrap(kf::u32(registers[op[1]]) + kf::u32(immediate(op + 2)));
+                    break;
+
+                case Opcode::Multiply:
+                    registers[op[1]] = wrap(kf::u32(registers[op[1]]) * kf::u32(registers[op[2]]));
+                    break;
+
+                case Opcode::ShiftRight:
+                    registers[op[1]] >>= op[2];
+                    break;
+
+                case Opcode::Jump:
+                    at = address(op + 1);
+                    continue;
+
+                case Opcode::JumpLess:
+                    if (registers[op[1]] < registers[op[2]]) {
+                        at = address(op + 3);
+                        continue;
+                    }
+                    break;
+
+                case Opcode::JumpGreaterEqual:
+                    if (registers[op[1]] >= registers[op[2]]) {
+                        at = address(op + 3);
+                        continue;
+                    }
+                    break;
+
+                case Opcode::JumpEqual:
+                    if (registers[op[1]] == registers[op[2]]) {
+                        at = address(op + 3);
+                        continue;
+                    }
+                    break;
+
+                case Opcode::JumpNotEqual:
+                    if (registers[op[1]] != registers[op[2]]) {
+                        at = address(op + 3);
+                        continue;
+                    }
+                    break;
+
+                case Opcode::Sense:
+                    registers[op[1]] = inputs.values[op[2]];
+                    break;
+
+                case Opcode::Clock:
+                    registers[op[1]] = static_cast<kf::i32>(now_ms - start_ms);
+                    break;
+
+                case Opcode::Drive:
+                    outputs.drive = true;
+                    outputs.left = registers[op[1]];
+                    outputs.right = registers[op[2]];
+                    break;
+
+                case Opcode::Stop:
+                    outputs.drive = true;
+                    outputs.left = 0;
+                    outputs.right = 0;
+                    break;
+
+                case Opcode::Arm:
+                    outputs.arm = true;
+                    outputs.arm_angle = registers[op[1]];
+                    break;
+
+                case Opcode::Claw:
+                    outputs.claw = true;
+                    outputs.claw_angle = registers[op[1]];
+                    break;
+
+                case Opcode::Wait:
+                    wake_ms = now_ms + static_cast<kf::u32>(registers[op[1]] > 0 ? registers[op[1]] : 0);
+                    at += 2;
+                    return suspend(State::Running);
+
+                case Opcode::Yield:
+                    at += 1;
+                    return suspend(State::Running);
+
+                case Opcode::Report:
+                    outputs.report = true;
+                    outputs.report_value = registers[op[1]];
+                    break;
+
+                default:
+                    // Недостижимо для проверенной программы
+                    fault = Fault::BadOpcode;
+                    return suspend(State::Faulted);
+            }
+
+            at += lengths.values[op[0]];
+        }
+
+        // Бюджет исчерпан: продолжение на следующем шаге
+        return suspend(State::Running);
+    }
+
+private:
+    /// @brief Таблица длин инструкций по коду (без ветвления в цикле исполнения)
+    struct LengthTable {
+        kf::u8 values[256];
+    };
+
+    static const LengthTable lengths;
+
+    [[nodiscard]] static inline kf::i32 immediate(const kf::u8 *bytes) {
+        return static_cast<kf::i16>(kf::u16(bytes[0]) | kf::u16(bytes[1]) << 8);
+    }
+
+    [[nodiscard]] static inline kf::u16 address(const kf::u8 *bytes) {
+        return static_cast<kf::u16>(kf::u16(bytes[0]) | kf::u16(bytes[1]) << 8);
+    }
+
+    [[nodiscard]] static inline kf::i32 wrap(kf::u32 value) {
+        return static_cast<kf::i32>(value);
+    }
+};
+
+inline constexpr BehaviourVm::LengthTable BehaviourVm::lengths = []() {
+    LengthTable table{};
+    for (int i = 0; i < 256; i += 1) { table.values[i] = length(static_cast<kf::u8>(i)); }
+    return table;
+}();
+
+}// namespace zms
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <kf/aliases.hpp>
+
+#include "zms/hal/Hal.hpp"
+
+namespace zms {
+
+/// @brief Микро-замеры в духе Google Benchmark.
+/// Замер - функция `void(Benchmark::State &)`, тело крутится в `for (auto _ : state)`:
+/// подготовка до цикла в замер не входит. Число итераций подбирается, пока партия не займёт
+/// минимальное время. Время считается счётчиком тактов HAL: на плате - такты ядра,
+/// на хосте - наносекунды. Реестр фиксированного размера, без кучи: тот же код идёт на плату
+struct Benchmark final {
+
+    /// @brief Состояние партии замера
+    struct State {
+
+        /// @brief Значение цикла: нетривиальный деструктор снимает предупреждение о неиспользуемом `_`
+        struct Value {
+            inline ~Value() {}
+        };
+
+        /// @brief Итератор партии: считает оставшиеся итерации и снимает время по краям цикла
+        struct Iterator {
+            State *state;
+            kf::u32 remaining;
+
+            [[nodiscard]] inline bool operator!=(const Iterator &) {
+                if (remaining != 0) { return true; }
+
+                state->stop();
+                return false;
+            }
+
+            inline void operator++() { remaining -= 1; }
+
+            [[nodiscard]] inline Value operator*() const { return {}; }
+        };
+
+        /// @brief Итераций в партии
+        kf::u32 iterations;
+
+        /// @brief Тактов за партию
+        kf::u32 cycles{0};
+
+    private:
+        /// @brief Счётчик тактов в начале цикла
+        kf::u32 start_cycles{0};
+
+    public:
+        explicit State(kf::u32 iterations) :
+            iterations{iterations} {}
+
+        [[nodiscard]] Iterator begin() {
+            start_cycles = hal::cycleCount();
+            return {this, iterations};
+        }
+
+        [[nodiscard]] Iterator end() { return {this, 0}; }
+
+    private:
+        // Разность беззнаковая: переполнение счётчика внутри партии не мешает
+        inline void stop() { cycles = hal::cycleCount() - start_cycles; }
+    };
+
+    /// @brief Функция замера
+    using Function = void (*)(State &);
+
+    /// @brief Зарегистрированный замер
+    struct Case {
+        const char *name;
+        Function function;
+    };
+
+    /// @brief Результат замера
+    struct Result {
+        /// @brief Итераций в итоговой партии
+        kf::u32 iterations;
+
+        /// @brief Тактов за итоговую партию
+        kf::u64 cycles;
+
+        /// @brief Частота счётчика тактов (МГц)
+        kf::u32 frequency_mhz;
+
+        [[nodiscard]] inline kf::f64 cyclesPerOp() const {
+            return (iterations == 0) ? 0.0 : kf::f64(cycles) / kf::f64(iterations);
+        }
+
+        [[nodiscard]] inline kf::f64 nanosecondsPerOp() const {
+            return (frequency_mhz == 0) ? 0.0 : cyclesPerOp() * 1000.0 / kf::f64(frequency_mhz);
+        }
+    };
+
+    /// @brief Ёмкость реестра
+    static constexpr kf::u8 capacity = 32;
+
+    /// @brief Верхний предел итераций в партии
+    static constexpr kf::u32 max_iterations = 1000000000u;
+
+    /// @brief Зарегистрировать замер (вызывается макросом zms_benchmark)
+    /// @returns false, если реестр заполнен
+    static bool add(const char *name, Function function) {
+        auto &r = registry();
+        if (r.count == capacity) { return false; }
+
+        r.cases[r.count] = {name, function};
+        r.count += 1;
+        return true;
+    }
+
+    /// @brief Количество зарегистрированных замеров
+    [[nodiscard]] static inline kf::u8 count() { return registry().count; }
+
+    /// @brief Замер по индексу
+    [[nodiscard]] static inline const Case &at(kf::u8 index) { return registry().cases[index]; }
+
+    /// @brief Выполнить замер: партии растут, пока не наберут минимальную длительность
+    /// @param c Замер
+    /// @param min_time_us Минимальная длительность итоговой партии (мкс)
+    [[nodiscard]] static Result run(const Case &c, kf::u32 min_time_us) {
+        const auto frequency_mhz = hal::cycleFrequencyMhz();
+        const auto min_cycles = kf::u64(min_time_us) * frequency_mhz;
+
+        kf::u32 iterations = 1;
+
+        while (true) {
+            State state{iterations};
+            c.function(state);
+
+            if (state.cycles >= min_cycles or iterations >= max_iterations) {
+                return {iterations, state.cycles, frequency_mhz};
+            }
+
+            // Прогноз по текущей партии с запасом 40%, но не быстрее x10 и не медленнее x2 за шаг
+            const auto cycles = (state.cycles == 0) ? kf::u64(1) : kf::u64(state.cycles);
+            auto next = kf::u64(iterations) * min_cycles * 14 / (cycles * 10);
+
+            if (next > kf::u64(iterations) * 10) { next = kf::u64(iterations) * 10; }
+            if (next < kf::u64(iterations) * 2) { next = kf::u64(iterations) * 2; }
+            if (next > max_iterations) { next = max_iterations; }
+
+            iterations = static_cast<kf::u32>(next);
+        }
+    }
+
+    /// @brief Не дать компилятору выбросить вычисление значения
+    template<typename T> static inline void doNotOptimize(const T &value) {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    /// @brief Не дать компилятору переупорядочить или выбросить записи в память
+    static inline void clobberMemory() {
+        asm volatile("" : : : "memory");
+    }
+
+private:
+    struct Registry {
+        Case cases[capacity]{};
+        kf::u8 count{0};
+    };
+
+    static Registry &registry() {
+        static Registry instance{};
+        return instance;
+    }
+};
+
+}// namespace zms
+
+/// @brief Зарегистрировать функцию замера под её именем (заголовок с замерами подключается в одну единицу трансляции)
+#define zms_benchmark(function) \
+    static const bool zms_benchmark_registered_##function = zms::Benchmark::add(#function, function)
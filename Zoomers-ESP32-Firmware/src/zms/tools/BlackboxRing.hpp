@@ -0,0 +1,136 @@
+#pragma once
+
+#include <kf/aliases.hpp>
+#include <kf/tools/validation.hpp>
+
+
+namespace zms {
+
+/// @brief Настройки бортового самописца
+struct BlackboxSettings : kf::tools::Validable<BlackboxSettings> {
+    /// @brief Частота записи (Гц)
+    kf::u16 sample_frequency_hz;
+
+    /// @brief Отсчётов после триггера
+    kf::u16 post_trigger_samples;
+
+    /// @brief Срабатывать на остановку рефлексом
+    bool trigger_on_reflex;
+
+    /// @brief Сохранять замороженный буфер в LittleFS
+    bool spill_to_flash;
+
+    void check(kf::tools::Validator &validator) const {
+        kf_Validator_check(validator, sample_frequency_hz > 0);
+        kf_Validator_check(validator, sample_frequency_hz <= 1000);
+    }
+};
+
+/// @brief Кольцевой буфер бортового самописца с триггером.
+/// Пока триггера нет, буфер непрерывно перезаписывается; после триггера пишется ещё post_samples
+/// отсчётов, и буфер замораживается - в нём остаётся окно до и после события
+template<typename S, kf::u16 N> struct BlackboxRing final {
+
+    /// @brief Ёмкость в отсчётах
+    static constexpr kf::u16 capacity = N;
+
+    /// @brief Состояние записи
+    enum class State : kf::u8 {
+        /// @brief Непрерывная запись
+        Recording = 0x00,
+
+        /// @brief Триггер сработал, пишется окно после события
+        Triggered = 0x01,
+
+        /// @brief Запись остановлена, буфер готов к выгрузке
+        Frozen = 0x02,
+    };
+
+private:
+    S samples[N]{};
+
+    /// @brief Индекс следующей записи
+    kf::u16 next{0};
+
+    /// @brief Записано отсчётов (не больше N)
+    kf::u16 count{0};
+
+    /// @brief Осталось записать после триггера
+    kf::u16 post_remaining{0};
+
+    /// @brief Сколько отсчётов записывается после триггера
+    kf::u16 post_samples_total{0};
+
+    State state{State::Recording};
+
+public:
+    /// @brief Записать отсчёт
+    void push(const S &sample) {
+        if (state == State::Frozen) { return; }
+
+        samples[next] = sample;
+        next = (next + 1) % N;
+        if (count < N) { count += 1; }
+
+        if (state == State::Triggered) {
+            post_remaining -= 1;
+
+            if (post_remaining == 0) {
+                state = State::Frozen;
+            }
+        }
+    }
+
+    /// @brief Сработал триггер
+    /// @param post_samples Сколько отсчётов записать после события
+    /// @returns false, если триггер уже сработал ранее
+    bool trigger(kf::u16 post_samples) {
+        if (state != State::Recording) { return false; }
+
+        if (post_samples >= N) { post_samples = N - 1; }
+
+        // Триггер - последний записанный отсчёт: после заморозки за ним будет ровно post_samples отсчётов
+        post_samples_total = post_samples;
+        post_remaining = post_samples;
+        state = (post_samples == 0) ? State::Frozen : State::Triggered;
+        return true;
+    }
+
+    /// @brief Заморозить буфер в любом состоянии.
+    /// Если окно после триггера ещё пишется, оно обрезается по уже записанным отсчётам;
+    /// без триггера событием считается последний записанный отсчёт
+    void freeze() {
+        if (state == State::Triggered) { post_samples_total -= post_remaining; }
+        if (state == State::Recording) { post_samples_total = 0; }
+
+        post_remaining = 0;
+        state = State::Frozen;
+    }
+
+    /// @brief Возобновить непрерывную запись
+    void rearm() {
+        next = 0;
+        count = 0;
+        post_remaining = 0;
+        post_samples_total = 0;
+        state = State::Recording;
+    }
+
+    [[nodiscard]] inline State getState() const { return state; }
+
+    /// @brief Количество отсчётов в буфере
+    [[nodiscard]] inline kf::u16 size() const { return count; }
+
+    /// @brief Индекс отсчёта триггера от самого старого (действителен после заморозки)
+    [[nodiscard]] inline kf::u16 triggerIndex() const {
+        return (count > post_samples_total) ? count - 1 - post_samples_total : 0;
+    }
+
+    /// @brief Отсчёт по порядку от самого старого
+    [[nodiscard]] inline const S &at(kf::u16 i) const {
+        const auto oldest = (count < N) ? 0 : next;
+        return samples[(oldest + i) % N];
+    }
+};
+
+}// namespace zms
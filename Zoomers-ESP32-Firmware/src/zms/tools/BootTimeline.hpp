@@ -0,0 +1,125 @@
+#pragma once
+
+#include <kf/aliases.hpp>
+
+#include "zms/hal/Hal.hpp"
+
+
+namespace zms {
+
+/// @brief Этапы загрузки (порядок - порядок отчёта)
+enum class BootStage : kf::u8 {
+    /// @brief Последовательный порт
+    Serial = 0x00,
+
+    /// @brief Загрузка и проверка настроек
+    Storage = 0x01,
+
+    /// @brief Запуск WiFi и ESP-NOW (фоновая задача, параллельно с периферией)
+    EspNow = 0x02,
+
+    /// @brief Манипулятор
+    Manipulator = 0x03,
+
+    /// @brief Драйверы моторов
+    Motors = 0x04,
+
+    /// @brief Датчики расстояния
+    DistanceSensors = 0x05,
+
+    /// @brief Энкодеры
+    Encoders = 0x06,
+
+    /// @brief Узел ESP-NOW (ожидание фоновой задачи и добавление пульта)
+    EspNowPeer = 0x07,
+
+    /// @brief Сервисы
+    Services = 0x08,
+};
+
+/// @brief Хронология загрузки: время начала и длительность каждого этапа (мкс от запуска) и его итог.
+/// Этап, не завершившийся успешно, переводит робота в деградированный режим (работает то, что поднялось)
+struct BootTimeline final {
+
+    /// @brief Количество этапов
+    static constexpr kf::u8 stage_count = static_cast<kf::u8>(BootStage::Services) + 1;
+
+    /// @brief Запись этапа
+    struct Record {
+        /// @brief Начало этапа (мкс от запуска)
+        kf::u32 start_us;
+
+        /// @brief Длительность этапа (мкс)
+        kf::u32 duration_us;
+
+        /// @brief Этап начат
+        bool started;
+
+        /// @brief Этап завершён успешно
+        bool ok;
+    };
+
+private:
+    Record records[stage_count]{};
+
+public:
+    /// @brief Отметить начало этапа
+    void begin(BootStage stage) {
+        auto &r = records[static_cast<kf::u8>(stage)];
+        r.start_us = static_cast<kf::u32>(hal::nowMicros());
+        r.duration_us = 0;
+        r.started = true;
+        r.ok = false;
+    }
+
+    /// @brief Отметить конец этапа (без журнала: этап может идти в фоновой задаче)
+    /// @returns ok
+    bool end(BootStage stage, bool ok) {
+        auto &r = records[static_cast<kf::u8>(stage)];
+        r.duration_us = static_cast<kf::u32>(hal::nowMicros()) - r.start_us;
+        r.ok = ok;
+        return ok;
+    }
+
+    /// @brief Запись этапа
+    [[nodiscard]] inline const Record &at(BootStage stage) const { return records[static_cast<kf::u8>(stage)]; }
+
+    /// @brief Запись этапа по индексу
+    [[nodiscard]] inline const Record &at(kf::u8 index) const { return records[index]; }
+
+    /// @brief Этап пройден успешно
+    [[nodiscard]] inline bool ok(BootStage stage) const { return at(stage).ok; }
+
+    /// @brief Маска неуспешных начатых этапов (бит - индекс этапа)
+    [[nodiscard]] kf::u16 failedMask() const {
+        kf::u16 mask = 0;
+
+        for (kf::u8 i = 0; i < stage_count; i += 1) {
+            if (records[i].started and not records[i].ok) {
+                mask |= static_cast<kf::u16>(1u << i);
+            }
+        }
+
+        return mask;
+    }
+
+    /// @brief Деградированный режим: хотя бы один этап не удался
+    [[nodiscard]] inline bool degraded() const { return failedMask() != 0; }
+
+    /// @brief Полное время загрузки: от начала первого до конца последнего начатого этапа (мкс)
+    [[nodiscard]] kf::u32 totalMicros() const {
+        kf::u32 first = 0xFFFFFFFFu;
+        kf::u32 last = 0;
+
+        for (const auto &r: records) {
+            if (not r.started) { continue; }
+
+            first = r.start_us < first ? r.start_us : first;
+            last = r.start_us + r.duration_us > last ? r.start_us + r.duration_us : last;
+        }
+
+        return last > first ? last - first : 0;
+    }
+};
+
+}// namespace zms
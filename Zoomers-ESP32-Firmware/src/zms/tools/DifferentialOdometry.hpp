@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cmath>
+#include <kf/aliases.hpp>
+#include <kf/tools/validation.hpp>
+
+#include "zms/tools/FixedPoint.hpp"
+
+
+namespace zms {
+
+/// @brief Одометрия дифференциального привода.
+/// Чистая математика: на вход приращения колёс, на выход поза.
+/// Не зависит от аппаратуры и проверяется на синтетических последовательностях отсчётов
+struct DifferentialOdometry final {
+
+    /// @brief Настройки одометрии
+    struct Settings : kf::tools::Validable<Settings> {
+        /// @brief Колея - расстояние между точками контакта колёс (мм)
+        kf::f32 track_width_mm;
+
+        /// @brief Частота интегрирования (Гц)
+        kf::u16 update_frequency_hz;
+
+        void check(kf::tools::Validator &validator) const {
+            kf_Validator_check(validator, track_width_mm > 0);
+            kf_Validator_check(validator, update_frequency_hz > 0);
+            kf_Validator_check(validator, update_frequency_hz <= 1000);
+        }
+    };
+
+    /// @brief Поза робота
+    struct Pose {
+        /// @brief Координата X (мм)
+        kf::f32 x;
+
+        /// @brief Координата Y (мм)
+        kf::f32 y;
+
+        /// @brief Курс (рад), нормализован в (-pi; pi]
+        kf::f32 heading;
+    };
+
+    /// @brief Текущая поза
+    Pose pose{0, 0, 0};
+
+private:
+    /// @brief Обратная величина колеи (деление заменено умножением)
+    kf::f32 inverse_track_width{0};
+
+public:
+    /// @brief Применить колею
+    void setTrackWidth(kf::f32 track_width_mm) {
+        inverse_track_width = 1.0f / track_width_mm;
+    }
+
+    /// @brief Интегрировать приращения колёс
+    /// @param left Приращение левого колеса
+    /// @param right Приращение правого колеса
+    void update(FixedMillimeters left, FixedMillimeters right) {
+        if (left.raw == 0 and right.raw == 0) { return; }
+
+        const auto dl = left.toFloat();
+        const auto dr = right.toFloat();
+
+        const auto distance = (dl + dr) * 0.5f;
+        const auto delta_heading = (dr - dl) * inverse_track_width;
+
+        // Интегрирование по средней точке дуги
+        const auto mid_heading = pose.heading + delta_heading * 0.5f;
+
+        pose.x += distance * std::cos(mid_heading);
+        pose.y += distance * std::sin(mid_heading);
+        pose.heading = normalizeAngle(pose.heading + delta_heading);
+    }
+
+    /// @brief Привести угол к (-pi; pi]
+    [[nodiscard]] static kf::f32 normalizeAngle(kf::f32 a) {
+        constexpr auto pi = static_cast<kf::f32>(M_PI);
+
+        while (a > pi) { a -= 2.0f * pi; }
+        while (a <= -pi) { a += 2.0f * pi; }
+        return a;
+    }
+};
+
+}// namespace zms
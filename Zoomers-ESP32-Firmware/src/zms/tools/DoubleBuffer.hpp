@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstring>
+#include <kf/aliases.hpp>
+
+
+namespace zms {
+
+/// @brief Двойной буфер секции настроек.
+/// Источник (обычно секция в хранилище) редактируется на месте (через UI или мост),
+/// драйвер же работает только с активной копией, которая подменяется целиком через swap()
+template<typename T> struct DoubleBuffer final {
+
+private:
+    /// @brief Редактируемый источник настроек
+    const T &source;
+
+    /// @brief Активная и предыдущая копии
+    T buffers[2]{};
+
+    /// @brief Индекс активной копии
+    kf::u8 active_index{0};
+
+public:
+    explicit DoubleBuffer(const T &source) :
+        source{source} {
+        std::memcpy(&buffers[0], &source, sizeof(T));
+        std::memcpy(&buffers[1], &source, sizeof(T));
+    }
+
+    /// @brief Активные (применённые) настройки
+    [[nodiscard]] inline const T &active() const { return buffers[active_index]; }
+
+    /// @brief Настройки, действовавшие до последней подмены
+    [[nodiscard]] inline const T &previous() const { return buffers[active_index ^ 1u]; }
+
+    /// @brief Редактируемый источник
+    [[nodiscard]] inline const T &pending() const { return source; }
+
+    /// @brief Источник изменился относительно активной копии
+    [[nodiscard]] inline bool changed() const {
+        return 0 != std::memcmp(&source, &active(), sizeof(T));
+    }
+
+    /// @brief Скопировать источник в неактивный буфер и сделать его активным
+    void swap() {
+        std::memcpy(&buffers[active_index ^ 1u], &source, sizeof(T));
+        active_index ^= 1u;
+    }
+};
+
+}// namespace zms
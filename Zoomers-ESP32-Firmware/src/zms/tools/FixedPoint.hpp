@@ -0,0 +1,93 @@
+#pragma once
+
+#include <kf/aliases.hpp>
+
+
+namespace zms {
+
+/// @brief Величина с фиксированной точкой.
+/// Тег различает единицы измерения, чтобы миллиметры нельзя было сложить с градусами
+template<typename Tag, kf::u8 F, typename Raw = kf::i32> struct Fixed final {
+
+    /// @brief Разрядность дробной части
+    static constexpr kf::u8 fraction_bits = F;
+
+    /// @brief Единица в сырых отсчётах
+    static constexpr Raw one = Raw(1) << F;
+
+    /// @brief Сырое значение
+    Raw raw;
+
+    [[nodiscard]] static constexpr Fixed fromRaw(Raw r) { return Fixed{r}; }
+
+    [[nodiscard]] static constexpr Fixed fromInt(kf::i32 v) { return Fixed{static_cast<Raw>(v * one)}; }
+
+    /// @brief numerator / denominator с округлением до ближайшего (denominator > 0)
+    [[nodiscard]] static constexpr Fixed fromRatio(kf::i32 numerator, kf::i32 denominator) {
+        const auto half = (numerator < 0) ? -denominator / 2 : denominator / 2;
+        return Fixed{static_cast<Raw>((kf::i64(numerator) * one + half) / denominator)};
+    }
+
+    /// @brief Из числа с плавающей точкой (только вне горячего пути: при загрузке настроек)
+    [[nodiscard]] static constexpr Fixed fromFloat(kf::f32 v) {
+        return Fixed{static_cast<Raw>(v * kf::f32(one) + (v < 0 ? -0.5f : 0.5f))};
+    }
+
+    /// @brief Целая часть (усечение к нулю)
+    [[nodiscard]] constexpr kf::i32 toInt() const { return raw / one; }
+
+    [[nodiscard]] constexpr kf::f32 toFloat() const { return kf::f32(raw) * (1.0f / kf::f32(one)); }
+
+    constexpr Fixed operator+(Fixed r) const { return Fixed{static_cast<Raw>(raw + r.raw)}; }
+
+    constexpr Fixed operator-(Fixed r) const { return Fixed{static_cast<Raw>(raw - r.raw)}; }
+
+    constexpr Fixed operator-() const { return Fixed{static_cast<Raw>(-raw)}; }
+
+    constexpr bool operator<(Fixed r) const { return raw < r.raw; }
+
+    constexpr bool operator>(Fixed r) const { return raw > r.raw; }
+
+    constexpr bool operator==(Fixed r) const { return raw == r.raw; }
+
+    constexpr bool operator!=(Fixed r) const { return raw != r.raw; }
+};
+
+/// @brief Миллиметры, шаг 1/256 мм, диапазон ±8 км
+using FixedMillimeters = Fixed<struct MillimetersTag, 8>;
+
+/// @brief Градусы, шаг 1/256°
+using FixedDegrees = Fixed<struct DegreesTag, 8>;
+
+/// @brief Нормализованная команда [-1; 1] в формате Q15
+using NormalizedCommand = Fixed<struct NormalizedTag, 15>;
+
+/// @brief Предрасчитанный масштабный коэффициент (Q24).
+/// Заменяет деление в горячем пути на умножение и сдвиг.
+/// 24 бита дробной части: обратная величина ~0.02 .. 1 держится с относительной точностью не хуже 1e-6
+/// (как у float), коэффициент до 127 помещается в i32
+struct ScaleFactor final {
+
+    /// @brief Разрядность дробной части
+    static constexpr kf::u8 fraction_bits = 24;
+
+    /// @brief Коэффициент в формате Q24
+    kf::i32 raw{0};
+
+    /// @brief Коэффициент numerator / denominator
+    [[nodiscard]] static constexpr ScaleFactor fromRatio(kf::i64 numerator, kf::i64 denominator) {
+        return ScaleFactor{static_cast<kf::i32>((numerator << fraction_bits) / denominator)};
+    }
+
+    /// @brief Коэффициент из числа с плавающей точкой (вне горячего пути)
+    [[nodiscard]] static constexpr ScaleFactor fromFloat(kf::f64 v) {
+        return ScaleFactor{static_cast<kf::i32>(v * kf::f64(1 << fraction_bits) + (v < 0 ? -0.5 : 0.5))};
+    }
+
+    /// @brief v * k, результат с дополнительными shift_left битами дробной части
+    template<kf::u8 shift_left = 0> [[nodiscard]] constexpr kf::i32 apply(kf::i32 v) const {
+        return static_cast<kf::i32>((kf::i64(v) * raw) >> (fraction_bits - shift_left));
+    }
+};
+
+}// namespace zms
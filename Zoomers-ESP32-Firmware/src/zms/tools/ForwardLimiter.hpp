@@ -0,0 +1,79 @@
+#pragma once
+
+#include <kf/aliases.hpp>
+#include <kf/tools/validation.hpp>
+
+
+namespace zms {
+
+/// @brief Ограничитель движения вперёд по расстоянию до препятствия.
+/// Разворот и движение назад не ограничиваются. Не зависит от аппаратуры
+struct ForwardLimiter final {
+
+    /// @brief Настройки ограничителя
+    struct Settings : kf::tools::Validable<Settings> {
+        /// @brief Рефлекс включён
+        bool enabled;
+
+        /// @brief Ближе этого расстояния движение вперёд запрещено (мм)
+        kf::u16 stop_distance_mm;
+
+        /// @brief Ближе этого расстояния скорость вперёд ограничивается линейно (мм)
+        kf::u16 slow_distance_mm;
+
+        /// @brief Частота опроса датчиков (Гц)
+        kf::u16 sample_frequency_hz;
+
+        void check(kf::tools::Validator &validator) const {
+            kf_Validator_check(validator, stop_distance_mm < slow_distance_mm);
+            kf_Validator_check(validator, sample_frequency_hz > 0);
+            kf_Validator_check(validator, sample_frequency_hz <= 1000);
+        }
+    };
+
+    /// @brief Уровень вмешательства
+    enum class Level : kf::u8 {
+        /// @brief Команда проходит без изменений
+        Pass = 0x00,
+
+        /// @brief Скорость вперёд ограничена
+        Clamp = 0x01,
+
+        /// @brief Движение вперёд запрещено
+        Stop = 0x02,
+    };
+
+    /// @brief Команды моторов
+    struct Command {
+        kf::f32 left;
+        kf::f32 right;
+    };
+
+    /// @brief Максимальная допустимая скорость вперёд для расстояния
+    [[nodiscard]] static kf::f32 forwardLimit(const Settings &settings, kf::u16 distance_mm) {
+        if (distance_mm <= settings.stop_distance_mm) { return 0.0f; }
+        if (distance_mm >= settings.slow_distance_mm) { return 1.0f; }
+
+        return kf::f32(distance_mm - settings.stop_distance_mm) /
+               kf::f32(settings.slow_distance_mm - settings.stop_distance_mm);
+    }
+
+    /// @brief Ограничить команду
+    /// @param command Исходная команда
+    /// @param limit Допустимая скорость вперёд [0; 1]
+    /// @param level Выход: уровень вмешательства
+    [[nodiscard]] static Command apply(const Command &command, kf::f32 limit, Level &level) {
+        const auto forward = (command.left + command.right) * 0.5f;
+        const auto turn = (command.right - command.left) * 0.5f;
+
+        if (forward <= limit) {
+            level = Level::Pass;
+            return command;
+        }
+
+        level = (limit <= 0.0f) ? Level::Stop : Level::Clamp;
+        return {limit - turn, limit + turn};
+    }
+};
+
+}// namespace zms
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <kf/aliases.hpp>
+
+#include "zms/hal/Hal.hpp"
+
+namespace zms {
+
+/// @brief Поток в памяти вместо Serial: входящие байты подкладываются заранее, исходящие
+/// только подсчитываются. Позволяет гонять инструкции моста без порта (замеры, проверки)
+/// @tparam N Ёмкость входящего буфера (байт)
+template<std::size_t N> struct MemoryStream final : hal::Stream {
+
+private:
+    /// @brief Входящие байты
+    kf::u8 input[N]{};
+
+    /// @brief Позиция чтения
+    std::size_t read_position{0};
+
+    /// @brief Конец подложенных данных
+    std::size_t input_size{0};
+
+    /// @brief Записано байт с последнего сброса
+    std::size_t written{0};
+
+public:
+    /// @brief Подложить входящие байты (непрочитанный остаток сохраняется)
+    /// @returns false, если не хватило места
+    [[nodiscard]] bool feed(const kf::u8 *data, std::size_t size) {
+        compact();
+
+        if (input_size + size > N) { return false; }
+
+        for (std::size_t i = 0; i < size; i += 1) { input[input_size + i] = data[i]; }
+        input_size += size;
+        return true;
+    }
+
+    /// @brief Сбросить входящие данные и счётчик записи
+    void clear() {
+        read_position = 0;
+        input_size = 0;
+        written = 0;
+    }
+
+    /// @brief Записано байт с последнего сброса
+    [[nodiscard]] inline std::size_t writtenBytes() const { return written; }
+
+    int available() override { return static_cast<int>(input_size - read_position); }
+
+    int read() override {
+        if (read_position == input_size) { return -1; }
+        return input[read_position++];
+    }
+
+    int peek() override {
+        if (read_position == input_size) { return -1; }
+        return input[read_position];
+    }
+
+    std::size_t write(kf::u8) override {
+        written += 1;
+        return 1;
+    }
+
+    std::size_t write(const kf::u8 *, std::size_t size) override {
+        written += size;
+        return size;
+    }
+
+    void flush() override {}
+
+private:
+    /// @brief Сдвинуть непрочитанный остаток в начало буфера
+    void compact() {
+        if (read_position == 0) { return; }
+
+        const auto rest = input_size - read_position;
+        for (std::size_t i = 0; i < rest; i += 1) { input[i] = input[read_position + i]; }
+
+        read_position = 0;
+        input_size = rest;
+    }
+};
+
+}// namespace zms
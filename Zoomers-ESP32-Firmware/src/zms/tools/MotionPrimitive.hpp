@@ -0,0 +1,184 @@
+#pragma once
+
+#include <cmath>
+#include <kf/aliases.hpp>
+#include <kf/tools/validation.hpp>
+
+#include "zms/tools/TrapezoidalProfile.hpp"
+
+
+namespace zms {
+
+/// @brief Примитив движения дифференциального привода: проезд на расстояние или поворот на месте.
+/// Трапецеидальный профиль задаёт опорное положение колёс, регулятор замыкается по энкодерам.
+/// Не зависит от аппаратуры: на вход пройденный путь колёс, на выход нормализованные команды моторов
+struct MotionPrimitive final {
+
+    /// @brief Настройки регулятора колёс
+    struct Settings : kf::tools::Validable<Settings> {
+        /// @brief Коэффициент по ошибке положения (1/мм)
+        kf::f32 position_gain;
+
+        /// @brief Прямая связь по скорости (1/(мм/с))
+        kf::f32 velocity_feedforward;
+
+        /// @brief Допуск завершения (мм)
+        kf::f32 tolerance_mm;
+
+        /// @brief Время на доводку после окончания профиля (мс)
+        kf::u16 settle_timeout_ms;
+
+        /// @brief Частота регулятора (Гц)
+        kf::u16 update_frequency_hz;
+
+        void check(kf::tools::Validator &validator) const {
+            kf_Validator_check(validator, position_gain >= 0);
+            kf_Validator_check(validator, velocity_feedforward >= 0);
+            kf_Validator_check(validator, tolerance_mm > 0);
+            kf_Validator_check(validator, update_frequency_hz > 0);
+            kf_Validator_check(validator, update_frequency_hz <= 1000);
+        }
+    };
+
+    /// @brief Вид движения
+    enum class Kind : kf::u8 {
+        /// @brief Прямолинейный проезд (мм)
+        Drive = 0x00,
+
+        /// @brief Поворот на месте (град, положительный - против часовой)
+        Turn = 0x01,
+    };
+
+    /// @brief Команда движения
+    struct Command {
+        /// @brief Идентификатор, назначенный хостом
+        kf::u8 id;
+
+        /// @brief Вид движения
+        Kind kind;
+
+        /// @brief Расстояние (мм) или угол (град)
+        kf::i16 amount;
+
+        /// @brief Максимальная скорость (мм/с или град/с)
+        kf::u16 max_speed;
+
+        /// @brief Ускорение (мм/с^2 или град/с^2)
+        kf::u16 acceleration;
+    };
+
+    /// @brief Команды моторов
+    struct Output {
+        kf::f32 left;
+        kf::f32 right;
+    };
+
+    /// @brief Итог исполнения
+    enum class State : kf::u8 {
+        /// @brief Исполняется
+        Running = 0x00,
+
+        /// @brief Цель достигнута в допуске
+        Completed = 0x01,
+
+        /// @brief Цель не достигнута за время доводки
+        Timeout = 0x02,
+    };
+
+private:
+    /// @brief Профиль пути по дуге колеса
+    TrapezoidalProfile profile{};
+
+    /// @brief Знак движения левого колеса
+    kf::f32 left_sign{1};
+
+    /// @brief Знак движения правого колеса
+    kf::f32 right_sign{1};
+
+    /// @brief Положение колёс в начале движения (мм)
+    kf::f32 left_origin{0}, right_origin{0};
+
+    /// @brief Время доводки (с)
+    kf::f32 settle_elapsed{0};
+
+    State state{State::Completed};
+
+public:
+    /// @brief Начать движение
+    /// @param command Команда
+    /// @param track_width_mm Колея
+    /// @param left_mm Текущий путь левого колеса
+    /// @param right_mm Текущий путь правого колеса
+    void start(const Command &command, kf::f32 track_width_mm, kf::f32 left_mm, kf::f32 right_mm) {
+        // Для поворота колёса идут по дуге радиусом в половину колеи
+        const auto scale = (command.kind == Kind::Turn)
+                               ? static_cast<kf::f32>(M_PI / 180.0) * track_width_mm * 0.5f
+                               : 1.0f;
+
+        left_sign = (command.kind == Kind::Turn) ? -1.0f : 1.0f;
+        right_sign = 1.0f;
+
+        left_origin = left_mm;
+        right_origin = right_mm;
+
+        profile.reset(0);
+        profile.target = kf::f32(command.amount) * scale;
+        profile.limits = {
+            kf::f32(command.max_speed) * scale,
+            kf::f32(command.acceleration) * scale,
+        };
+
+        settle_elapsed = 0;
+        state = State::Running;
+    }
+
+    /// @brief Шаг регулятора
+    /// @param settings Настройки регулятора
+    /// @param dt Шаг (с)
+    /// @param left_mm Текущий путь левого колеса
+    /// @param right_mm Текущий путь правого колеса
+    Output update(const Settings &settings, kf::f32 dt, kf::f32 left_mm, kf::f32 right_mm) {
+        if (state != State::Running) { return {0, 0}; }
+
+        const auto reference = profile.step(dt);
+        const auto velocity = profile.velocity;
+
+        const auto left_error = left_sign * reference - (left_mm - left_origin);
+        const auto right_error = right_sign * reference - (right_mm - right_origin);
+
+        if (profile.done()) {
+            const bool in_tolerance =
+                std::fabs(left_error) <= settings.tolerance_mm and
+                std::fabs(right_error) <= settings.tolerance_mm;
+
+            if (in_tolerance) {
+                state = State::Completed;
+                return {0, 0};
+            }
+
+            settle_elapsed += dt;
+
+            if (settle_elapsed * 1000.0f >= kf::f32(settings.settle_timeout_ms)) {
+                state = State::Timeout;
+                return {0, 0};
+            }
+        }
+
+        return {
+            clamp(left_sign * velocity * settings.velocity_feedforward + left_error * settings.position_gain),
+            clamp(right_sign * velocity * settings.velocity_feedforward + right_error * settings.position_gain),
+        };
+    }
+
+    /// @brief Состояние исполнения
+    [[nodiscard]] inline State getState() const { return state; }
+
+private:
+    [[nodiscard]] static inline kf::f32 clamp(kf::f32 v) {
+        if (v > 1.0f) { return 1.0f; }
+        if (v < -1.0f) { return -1.0f; }
+        return v;
+    }
+};
+
+}// namespace zms
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <kf/aliases.hpp>
+#include <kf/tools/validation.hpp>
+
+
+namespace zms {
+
+/// @brief Настройки управления питанием
+struct PowerSettings : kf::tools::Validable<PowerSettings> {
+
+    /// @brief Режим
+    enum class Mode : kf::u8 {
+        /// @brief Наибольшая частота всегда, цикл не уступает время
+        Performance = 0x00,
+
+        /// @brief В простое - наименьшая частота, цикл уступает время (ядро ждёт в задаче простоя)
+        Balanced = 0x01,
+
+        /// @brief Как Balanced, и в простое - лёгкий сон
+        Saving = 0x02,
+    };
+
+    /// @brief Режим
+    Mode mode;
+
+    /// @brief Частота ЦП в работе (МГц)
+    kf::u16 max_frequency_mhz;
+
+    /// @brief Частота ЦП в простое (МГц)
+    kf::u16 min_frequency_mhz;
+
+    /// @brief Простой после последней активности (мс)
+    kf::u16 idle_timeout_ms;
+
+    /// @brief Наибольшая длительность лёгкого сна (мс): ограничивает задержку пробуждения по ESP-NOW
+    kf::u16 sleep_slice_ms;
+
+    /// @brief Бодрствование между снами (мс): окно приёма ESP-NOW
+    kf::u16 listen_window_ms;
+
+    /// @brief Частота, на которой APB остаётся 80 МГц (ШИМ и UART не перенастраиваются)
+    [[nodiscard]] static constexpr bool isSupportedFrequency(kf::u16 mhz) {
+        return mhz == 80 or mhz == 160 or mhz == 240;
+    }
+
+    void check(kf::tools::Validator &validator) const {
+        kf_Validator_check(validator, mode <= Mode::Saving);
+        kf_Validator_check(validator, isSupportedFrequency(max_frequency_mhz));
+        kf_Validator_check(validator, isSupportedFrequency(min_frequency_mhz));
+        kf_Validator_check(validator, min_frequency_mhz <= max_frequency_mhz);
+        kf_Validator_check(validator, idle_timeout_ms > 0);
+        kf_Validator_check(validator, sleep_slice_ms > 0);
+        kf_Validator_check(validator, sleep_slice_ms <= 1000);
+        kf_Validator_check(validator, listen_window_ms > 0);
+    }
+};
+
+/// @brief Политика питания: уровень на следующую итерацию основного цикла по активности.
+/// Не обращается к периферии: решения применяет PowerManager
+struct PowerPolicy final {
+
+    /// @brief Уровень
+    enum class Level : kf::u8 {
+        /// @brief Контур управления активен: наибольшая частота
+        Active = 0x00,
+
+        /// @brief Простой: наименьшая частота, цикл уступает время
+        Idle = 0x01,
+
+        /// @brief Простой: лёгкий сон
+        Sleep = 0x02,
+    };
+
+private:
+    /// @brief Время последней активности (мс)
+    kf::u32 last_activity_ms{0};
+
+    /// @brief Время последнего пробуждения (мс)
+    kf::u32 last_wake_ms{0};
+
+public:
+    /// @brief Отметить активность (команда, пакет, движение колёс)
+    inline void activity(kf::u32 now_ms) { last_activity_ms = now_ms; }
+
+    /// @brief Отметить выход из сна: начинается окно приёма
+    inline void woke(kf::u32 now_ms) { last_wake_ms = now_ms; }
+
+    /// @brief Уровень на следующую итерацию
+    /// @param busy Контур управления занят (движение, траектория, поведение)
+    [[nodiscard]] Level decide(const PowerSettings &settings, bool busy, kf::u32 now_ms) {
+        if (busy or settings.mode == PowerSettings::Mode::Performance) {
+            last_activity_ms = now_ms;
+            return Level::Active;
+        }
+
+        // Беззнаковая разность корректна при переполнении счётчика мс
+        if (now_ms - last_activity_ms < settings.idle_timeout_ms) { return Level::Active; }
+
+        if (settings.mode == PowerSettings::Mode::Balanced) { return Level::Idle; }
+
+        if (now_ms - last_wake_ms < settings.listen_window_ms) { return Level::Idle; }
+
+        return Level::Sleep;
+    }
+};
+
+/// @brief Накопитель задержек за окно отчёта (мкс)
+struct LatencyStats final {
+    /// @brief Количество замеров
+    kf::u32 count{0};
+
+    /// @brief Сумма (мкс)
+    kf::u64 sum_us{0};
+
+    /// @brief Наибольшая (мкс)
+    kf::u32 max_us{0};
+
+    inline void add(kf::u64 us) {
+        const auto clamped = static_cast<kf::u32>(std::min<kf::u64>(us, UINT32_MAX));
+
+        count += 1;
+        sum_us += clamped;
+        max_us = std::max(max_us, clamped);
+    }
+
+    /// @brief Средняя (мкс), 0 - замеров не было
+    [[nodiscard]] inline kf::u32 mean() const { return count == 0 ? 0 : static_cast<kf::u32>(sum_us / count); }
+
+    inline void reset() { *this = {}; }
+};
+
+}// namespace zms
@@ -0,0 +1,232 @@
+#pragma once
+
+#include <cmath>
+#include <kf/aliases.hpp>
+#include <kf/tools/validation.hpp>
+
+#include "zms/tools/DifferentialOdometry.hpp"
+
+
+namespace zms {
+
+/// @brief Следование по ломаной методом Pure Pursuit.
+/// Путь хранится в кольцевом буфере: пройденные сегменты выталкиваются, новые точки дописываются в конец
+/// во время движения. Не зависит от аппаратуры: на вход поза, на выход скорости колёс
+struct PurePursuit final {
+
+    /// @brief Настройки следования
+    struct Settings : kf::tools::Validable<Settings> {
+        /// @brief Дистанция упреждения (мм)
+        kf::f32 lookahead_mm;
+
+        /// @brief Крейсерская скорость (мм/с)
+        kf::f32 cruise_speed_mm_s;
+
+        /// @brief Замедление перед конечной точкой (мм/с^2)
+        kf::f32 deceleration_mm_s2;
+
+        /// @brief Допуск достижения конечной точки (мм)
+        kf::f32 goal_tolerance_mm;
+
+        void check(kf::tools::Validator &validator) const {
+            kf_Validator_check(validator, lookahead_mm > 0);
+            kf_Validator_check(validator, cruise_speed_mm_s > 0);
+            kf_Validator_check(validator, deceleration_mm_s2 > 0);
+            kf_Validator_check(validator, goal_tolerance_mm > 0);
+        }
+    };
+
+    /// @brief Точка пути (мм)
+    struct Point {
+        kf::f32 x;
+        kf::f32 y;
+    };
+
+    /// @brief Скорости колёс (мм/с)
+    struct Output {
+        kf::f32 left;
+        kf::f32 right;
+    };
+
+    /// @brief Ёмкость пути в точках
+    static constexpr kf::u8 capacity = 64;
+
+private:
+    Point points[capacity]{};
+    kf::u8 head{0};
+    kf::u8 count{0};
+
+    /// @brief Поперечная ошибка на последнем шаге (мм, положительная - путь слева)
+    kf::f32 cross_track_error{0};
+
+    /// @brief Пройдено сегментов с начала пути
+    kf::u16 passed_segments{0};
+
+public:
+    /// @brief Очистить путь
+    void clear() {
+        head = 0;
+        count = 0;
+        passed_segments = 0;
+        cross_track_error = 0;
+    }
+
+    /// @brief Добавить точку в конец пути
+    /// @returns false, если путь заполнен
+    [[nodiscard]] bool append(const Point &point) {
+        if (count == capacity) { return false; }
+
+        points[(head + count) % capacity] = point;
+        count += 1;
+        return true;
+    }
+
+    /// @brief Свободное место в точках
+    [[nodiscard]] inline kf::u8 freeSpace() const { return capacity - count; }
+
+    /// @brief Осталось сегментов
+    [[nodiscard]] inline kf::u8 remainingSegments() const { return (count > 1) ? count - 1 : 0; }
+
+    /// @brief Пройдено сегментов
+    [[nodiscard]] inline kf::u16 passedSegments() const { return passed_segments; }
+
+    /// @brief Путь пройден (или пуст)
+    [[nodiscard]] inline bool finished() const { return count < 2; }
+
+    /// @brief Поперечная ошибка последнего шага
+    [[nodiscard]] inline kf::f32 crossTrackError() const { return cross_track_error; }
+
+    /// @brief Шаг следования
+    /// @param settings Настройки
+    /// @param pose Текущая поза
+    /// @param track_width_mm Колея
+    Output update(const Settings &settings, const DifferentialOdometry::Pose &pose, kf::f32 track_width_mm) {
+        if (finished()) { return {0, 0}; }
+
+        const Point p{pose.x, pose.y};
+
+        // Вытолкнуть пройденные сегменты
+        while (count >= 2 and projection(0, p) >= 1.0f) { pop(); }
+
+        const auto &goal = at(count - 1);
+        const auto goal_distance = distance(p, goal);
+
+        if (count == 2 and goal_distance <= settings.goal_tolerance_mm) {
+            pop();
+            return {0, 0};
+        }
+
+        cross_track_error = signedDistance(0, p);
+
+        // Для замкнутого пути конечная точка совпадает с начальной: тормозим по длине пути, а не по прямой
+        const auto remaining = remainingLength(p);
+        const auto target = lookahead(p, settings.lookahead_mm, remaining, goal);
+
+        // Цель в системе координат робота
+        const auto dx = target.x - p.x;
+        const auto dy = target.y - p.y;
+        const auto c = std::cos(pose.heading);
+        const auto s = std::sin(pose.heading);
+        const auto local_y = -s * dx + c * dy;
+        const auto d2 = dx * dx + dy * dy;
+
+        const auto curvature = (d2 > 0) ? 2.0f * local_y / d2 : 0.0f;
+
+        // Торможение к конечной точке: v = sqrt(2 a s)
+        auto speed = settings.cruise_speed_mm_s;
+        const auto braking_speed = std::sqrt(2.0f * settings.deceleration_mm_s2 * remaining);
+        if (braking_speed < speed) { speed = braking_speed; }
+
+        const auto half_track = track_width_mm * 0.5f;
+        return {
+            speed * (1.0f - curvature * half_track),
+            speed * (1.0f + curvature * half_track),
+        };
+    }
+
+private:
+    [[nodiscard]] inline const Point &at(kf::u8 i) const { return points[(head + i) % capacity]; }
+
+    void pop() {
+        head = (head + 1) % capacity;
+        count -= 1;
+        passed_segments += 1;
+    }
+
+    [[nodiscard]] static inline kf::f32 distance(const Point &a, const Point &b) {
+        return std::hypot(a.x - b.x, a.y - b.y);
+    }
+
+    /// @brief Параметр проекции точки на сегмент i (0 - начало, 1 - конец)
+    [[nodiscard]] kf::f32 projection(kf::u8 i, const Point &p) const {
+        const auto &a = at(i);
+        const auto &b = at(i + 1);
+
+        const auto ex = b.x - a.x;
+        const auto ey = b.y - a.y;
+        const auto length2 = ex * ex + ey * ey;
+
+        if (length2 == 0) { return 1.0f; }
+
+        return ((p.x - a.x) * ex + (p.y - a.y) * ey) / length2;
+    }
+
+    /// @brief Расстояние со знаком от точки до прямой сегмента i
+    [[nodiscard]] kf::f32 signedDistance(kf::u8 i, const Point &p) const {
+        const auto &a = at(i);
+        const auto &b = at(i + 1);
+
+        const auto length = distance(a, b);
+        if (length == 0) { return 0; }
+
+        return ((b.x - a.x) * (p.y - a.y) - (b.y - a.y) * (p.x - a.x)) / -length;
+    }
+
+    /// @brief Оставшаяся длина пути: до конца текущего сегмента и далее по всем следующим
+    [[nodiscard]] kf::f32 remainingLength(const Point &p) const {
+        auto length = distance(p, at(1));
+        for (kf::u8 i = 1; i + 1 < count; i += 1) { length += distance(at(i), at(i + 1)); }
+        return length;
+    }
+
+    /// @brief Найти точку упреждения: самое дальнее пересечение окружности радиуса L с путём
+    [[nodiscard]] Point lookahead(const Point &p, kf::f32 radius, kf::f32 remaining, const Point &goal) const {
+        if (remaining <= radius) { return goal; }
+
+        Point result = at(1);
+        bool found = false;
+
+        for (kf::u8 i = 0; i + 1 < count; i += 1) {
+            const auto &a = at(i);
+            const auto &b = at(i + 1);
+
+            const auto ex = b.x - a.x;
+            const auto ey = b.y - a.y;
+            const auto fx = a.x - p.x;
+            const auto fy = a.y - p.y;
+
+            const auto qa = ex * ex + ey * ey;
+            if (qa == 0) { continue; }
+
+            const auto qb = 2.0f * (fx * ex + fy * ey);
+            const auto qc = fx * fx + fy * fy - radius * radius;
+            const auto discriminant = qb * qb - 4.0f * qa * qc;
+
+            if (discriminant >= 0) {
+                const auto t = (-qb + std::sqrt(discriminant)) / (2.0f * qa);
+
+                if (t >= 0 and t <= 1) {
+                    result = {a.x + t * ex, a.y + t * ey};
+                    found = true;
+                }
+            }
+
+            // Дальше конца этого сегмента окружность не дотягивается
+            if (found and distance(p, b) > radius) { break; }
+        }
+
+        return result;
+    }
+};
+
+}// namespace zms
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+
+#include "zms/tools/Trace.hpp"
+
+
+namespace zms {
+
+/// @brief Статический список сервисов владельца (указатели на члены).
+/// Состав известен при сборке: опрос - развёрнутая свёртка прямых вызовов без таблицы и косвенных переходов
+template<auto... members> struct ServiceList final {
+
+    /// @brief Число сервисов в списке
+    static constexpr auto size = sizeof...(members);
+
+    /// @brief Опросить сервисы в порядке списка
+    template<typename Owner> static inline void poll(Owner &owner) {
+        pollEach(owner, std::make_index_sequence<size>{});
+    }
+
+private:
+    template<typename Owner, std::size_t... indices> static inline void pollEach(Owner &owner, std::index_sequence<indices...>) {
+        (pollOne<indices>(owner.*members), ...);
+    }
+
+    /// @brief Опрос сервиса - участок трассы с индексом в списке
+    template<std::size_t index, typename S> static inline void pollOne(S &service) {
+        zms_trace_scope(TracePoint::ServicePoll, index);
+        service.poll();
+    }
+};
+
+}// namespace zms
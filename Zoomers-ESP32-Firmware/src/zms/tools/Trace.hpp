@@ -0,0 +1,323 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <kf/aliases.hpp>
+
+#include "zms/hal/Hal.hpp"
+
+
+namespace zms {
+
+/// @brief Точка трассировки (имена событий на хосте - timeline.py, POINTS)
+enum class TracePoint : kf::u8 {
+    /// @brief Service::poll целиком
+    Services = 0x00,
+
+    /// @brief Опрос сервиса (аргумент - индекс в списке Service::poll)
+    ServicePoll = 0x01,
+
+    /// @brief Инструкция моста (аргумент - код)
+    BridgeInstruction = 0x02,
+
+    /// @brief Приём пакета ESP-NOW (аргумент - размер, не больше 255)
+    EspNowReceive = 0x03,
+
+    /// @brief Прерывание энкодера (аргумент - пин вторичной фазы)
+    EncoderInterrupt = 0x04,
+
+    /// @brief Запись ШИМ мотора (аргумент - пин A драйвера)
+    MotorWrite = 0x05,
+
+    /// @brief Запись импульса сервопривода (аргумент - канал LEDC или RMT)
+    ServoWrite = 0x06,
+};
+
+/// @brief Трасса по времени: события начала и конца участков с ядром и задачей в кольце ОЗУ.
+/// Запись из любой задачи и прерывания без блокировок: место занимается атомарным индексом,
+/// старые события перезаписываются. Метка - счётчик тактов своего ядра (счётчики ядер независимы):
+/// при заморозке снимаются показания (такты, мкс) каждого ядра, по ним хост переводит метки во время.
+/// Частота ЦП на время записи должна быть постоянной (мост включает режим питания Performance).
+/// Точки расставлены макросами zms_trace_scope, zms_trace_isr_scope; без ZMS_TRACE макросы пусты
+struct Trace final {
+
+    /// @brief Точки трассировки собраны в прошивку
+#if defined(ZMS_TRACE)
+    static constexpr bool compiled = true;
+#else
+    static constexpr bool compiled = false;
+#endif
+
+    /// @brief Ёмкость кольца в событиях (степень двойки)
+    static constexpr kf::u16 capacity = 1024;
+
+    static_assert((capacity & (capacity - 1)) == 0);
+
+    /// @brief Наибольшее число различаемых задач
+    static constexpr kf::u8 task_capacity = 8;
+
+    /// @brief Длина имени задачи с завершающим нулём (configMAX_TASK_NAME_LEN)
+    static constexpr kf::u8 task_name_size = 16;
+
+    /// @brief Задача события: прерывание
+    static constexpr kf::u8 task_isr = 0xFF;
+
+    /// @brief Задача события: реестр задач переполнен
+    static constexpr kf::u8 task_other = 0xFE;
+
+    /// @brief Событий в одном фрагменте выгрузки
+    static constexpr kf::u8 chunk_events = 16;
+
+    /// @brief Фаза события
+    enum class Phase : kf::u8 {
+        Begin = 0x00,
+        End = 0x01,
+    };
+
+    /// @brief Событие (8 байт)
+    struct Event {
+        /// @brief Счётчик тактов ядра
+        kf::u32 cycles;
+
+        /// @brief Точка
+        TracePoint point;
+
+        /// @brief Аргумент точки
+        kf::u8 arg;
+
+        /// @brief Бит 0 - фаза (Phase), остальные - ядро
+        kf::u8 flags;
+
+        /// @brief Индекс задачи в реестре, task_isr или task_other
+        kf::u8 task;
+    };
+
+    /// @brief Задача в реестре
+    struct TaskInfo {
+        /// @brief Идентификатор
+        hal::TaskId id;
+
+        /// @brief Имя (копия: задача могла завершиться к выгрузке)
+        char name[task_name_size];
+    };
+
+    /// @brief Заголовок выгрузки
+    struct Header {
+        /// @brief Событий в выгрузке
+        kf::u16 count;
+
+        /// @brief Событий перезаписано с начала записи
+        kf::u32 lost;
+
+        /// @brief Частота счётчика тактов (МГц)
+        kf::u16 frequency_mhz;
+
+        /// @brief Показания ядер при заморозке (hal::core_count)
+        const hal::CycleReference *references;
+
+        /// @brief Задач в реестре
+        kf::u8 task_count;
+
+        /// @brief Реестр задач
+        const TaskInfo *tasks;
+    };
+
+    /// @brief Фрагмент выгрузки
+    struct Chunk {
+        /// @brief Индекс первого события
+        kf::u16 offset;
+
+        /// @brief Событий во фрагменте
+        kf::u8 count;
+
+        /// @brief События
+        const Event *events;
+    };
+
+private:
+    static inline Event events[capacity]{};
+
+    /// @brief Индекс следующего события (не по модулю: разность с capacity - число потерянных)
+    static inline std::atomic<kf::u32> head{0};
+
+    static inline volatile bool recording{false};
+
+    static inline TaskInfo tasks[task_capacity]{};
+
+    /// @brief Задач в реестре (публикуется после заполнения записи)
+    static inline std::atomic<kf::u8> task_count{0};
+
+    /// @brief Регистрация задач с обоих ядер
+    static inline hal::CriticalSection task_lock{};
+
+    static inline hal::CycleReference references[hal::core_count]{};
+
+    /// @brief Выгрузка: индекс первого события, число событий, следующее к отправке
+    static inline kf::u32 dump_first{0};
+    static inline kf::u16 dump_count{0};
+    static inline kf::u16 dump_cursor{0};
+
+    /// @brief Временная копия фрагмента выгрузки
+    static inline Event chunk_buffer[chunk_events]{};
+
+public:
+    /// @brief Начать запись с пустого кольца
+    static void start() {
+        recording = false;
+
+        head.store(0, std::memory_order_relaxed);
+        task_count.store(0, std::memory_order_relaxed);
+        dump_count = dump_cursor = 0;
+
+        recording = true;
+    }
+
+    /// @brief Остановить запись (без выгрузки)
+    static inline void stop() { recording = false; }
+
+    /// @brief Идёт запись
+    [[nodiscard]] static inline bool active() { return recording; }
+
+    /// @brief Записать событие. Встраивается в точку (в том числе в обработчик прерывания):
+    /// проверка записи, атомарный индекс, счётчик тактов, номер ядра
+    static inline void zms_hal_isr record(TracePoint point, kf::u8 arg, Phase phase, kf::u8 task) {
+        if (not recording) { return; }
+
+        const auto index = head.fetch_add(1, std::memory_order_relaxed);
+
+        events[index & (capacity - 1)] = {
+            .cycles = hal::cycleCount(),
+            .point = point,
+            .arg = arg,
+            .flags = static_cast<kf::u8>(static_cast<kf::u8>(phase) | (hal::coreId() << 1)),
+            .task = task,
+        };
+    }
+
+    /// @brief Индекс текущей задачи (не из прерывания); новая задача регистрируется
+    [[nodiscard]] static kf::u8 currentTask() {
+        const auto id = hal::currentTask();
+        const auto count = task_count.load(std::memory_order_acquire);
+
+        for (kf::u8 i = 0; i < count; i += 1) {
+            if (tasks[i].id == id) { return i; }
+        }
+
+        return registerTask(id);
+    }
+
+    /// @brief Заморозить запись и начать выгрузку
+    [[nodiscard]] static Header beginDump() {
+        recording = false;
+
+        const auto total = head.load(std::memory_order_relaxed);
+        dump_count = static_cast<kf::u16>(std::min<kf::u32>(total, capacity));
+        dump_first = total - dump_count;
+        dump_cursor = 0;
+
+        for (kf::u8 core = 0; core < hal::core_count; core += 1) {
+            references[core] = hal::cycleReference(core);
+        }
+
+        return {
+            .count = dump_count,
+            .lost = dump_first,
+            .frequency_mhz = static_cast<kf::u16>(hal::cycleFrequencyMhz()),
+            .references = references,
+            .task_count = task_count.load(std::memory_order_acquire),
+            .tasks = tasks,
+        };
+    }
+
+    /// @brief Следующий фрагмент выгрузки
+    /// @returns false - выгрузка завершена или не начиналась
+    [[nodiscard]] static bool nextChunk(Chunk &chunk) {
+        if (dump_cursor >= dump_count) { return false; }
+
+        const auto n = static_cast<kf::u8>(std::min<kf::u16>(chunk_events, dump_count - dump_cursor));
+
+        for (kf::u8 i = 0; i < n; i += 1) {
+            chunk_buffer[i] = events[(dump_first + dump_cursor + i) & (capacity - 1)];
+        }
+
+        chunk = {dump_cursor, n, chunk_buffer};
+        dump_cursor += n;
+        return true;
+    }
+
+private:
+    static kf::u8 registerTask(hal::TaskId id) {
+        // Задачу регистрирует только она сама: повторной проверки под блокировкой не требуется
+        task_lock.enter();
+
+        const auto count = task_count.load(std::memory_order_relaxed);
+        kf::u8 index = task_other;
+
+        if (count < task_capacity) {
+            auto &task = tasks[count];
+            task.id = id;
+            std::strncpy(task.name, hal::currentTaskName(), task_name_size - 1);
+            task.name[task_name_size - 1] = '\0';
+
+            task_count.store(count + 1, std::memory_order_release);
+            index = count;
+        }
+
+        task_lock.exit();
+        return index;
+    }
+};
+
+/// @brief Участок трассы в задаче: начало в конструкторе, конец в деструкторе
+struct TraceScope final {
+
+private:
+    TracePoint point;
+    kf::u8 arg;
+    kf::u8 task;
+
+public:
+    inline TraceScope(TracePoint point, kf::u8 arg) :
+        point{point}, arg{arg}, task{Trace::active() ? Trace::currentTask() : kf::u8{0}} {
+        Trace::record(point, arg, Trace::Phase::Begin, task);
+    }
+
+    TraceScope(const TraceScope &) = delete;
+
+    inline ~TraceScope() { Trace::record(point, arg, Trace::Phase::End, task); }
+};
+
+/// @brief Участок трассы в обработчике прерывания (задача не определяется)
+struct TraceIsrScope final {
+
+private:
+    TracePoint point;
+    kf::u8 arg;
+
+public:
+    inline zms_hal_isr TraceIsrScope(TracePoint point, kf::u8 arg) :
+        point{point}, arg{arg} {
+        Trace::record(point, arg, Trace::Phase::Begin, Trace::task_isr);
+    }
+
+    TraceIsrScope(const TraceIsrScope &) = delete;
+
+    inline zms_hal_isr ~TraceIsrScope() { Trace::record(point, arg, Trace::Phase::End, Trace::task_isr); }
+};
+
+}// namespace zms
+
+#define zms_trace_concat_(a, b) a##b
+#define zms_trace_concat(a, b) zms_trace_concat_(a, b)
+
+#if defined(ZMS_TRACE)
+/// @brief Участок трассы до конца области видимости (задача)
+#define zms_trace_scope(point, arg) const ::zms::TraceScope zms_trace_concat(zms_trace_scope_, __LINE__){(point), static_cast<kf::u8>(arg)}
+
+/// @brief Участок трассы до конца области видимости (обработчик прерывания)
+#define zms_trace_isr_scope(point, arg) const ::zms::TraceIsrScope zms_trace_concat(zms_trace_scope_, __LINE__){(point), static_cast<kf::u8>(arg)}
+#else
+#define zms_trace_scope(point, arg) (void) 0
+#define zms_trace_isr_scope(point, arg) (void) 0
+#endif
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cmath>
+#include <kf/aliases.hpp>
+
+
+namespace zms {
+
+/// @brief Одномерный трапецеидальный профиль скорости.
+/// Не зависит от аппаратуры: шаг интегрирования задаётся извне
+struct TrapezoidalProfile final {
+
+    /// @brief Ограничения движения
+    struct Limits {
+        /// @brief Максимальная скорость (ед/с)
+        kf::f32 max_velocity;
+
+        /// @brief Максимальное ускорение (ед/с^2)
+        kf::f32 acceleration;
+    };
+
+    /// @brief Текущее положение
+    kf::f32 position{0};
+
+    /// @brief Текущая скорость (со знаком)
+    kf::f32 velocity{0};
+
+    /// @brief Целевое положение
+    kf::f32 target{0};
+
+    /// @brief Действующие ограничения
+    Limits limits{1, 1};
+
+    /// @brief Сбросить профиль в положение покоя
+    void reset(kf::f32 p) {
+        position = p;
+        target = p;
+        velocity = 0;
+    }
+
+    /// @brief Движение завершено
+    [[nodiscard]] inline bool done() const {
+        return position == target and velocity == 0;
+    }
+
+    /// @brief Сделать шаг интегрирования
+    /// @param dt Шаг в секундах
+    /// @returns Новое положение
+    kf::f32 step(kf::f32 dt) {
+        const auto remaining = target - position;
+
+        if (remaining == 0 and velocity == 0) { return position; }
+
+        const auto direction = (remaining > 0) ? 1.0f : -1.0f;
+        const auto accel_step = limits.acceleration * dt;
+
+        // Скорость вдоль направления на цель (отрицательна, если движемся от цели)
+        auto speed = velocity * direction;
+
+        const auto braking_distance = (speed > 0) ? (speed * speed) / (2.0f * limits.acceleration) : 0.0f;
+
+        if (std::fabs(remaining) <= braking_distance) {
+            speed -= accel_step;
+        } else {
+            speed += accel_step;
+            if (speed > limits.max_velocity) { speed = limits.max_velocity; }
+        }
+
+        const auto travel = speed * dt;
+
+        if (travel >= std::fabs(remaining) or (speed <= 0 and std::fabs(remaining) <= accel_step * dt)) {
+            reset(target);
+            return position;
+        }
+
+        velocity = speed * direction;
+        position += velocity * dt;
+        return position;
+    }
+};
+
+}// namespace zms
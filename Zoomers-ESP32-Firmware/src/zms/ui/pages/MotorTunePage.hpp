@@ -51,9 +51,9 @@ struct MotorTunePage final : kf::UI::Page {
     /// @brief Активная реализация драйвера
     kf::UI::ComboBox<Motor::DriverImpl, 2> driver_impl;
 
-    explicit MotorTunePage(
+    template<typename M> explicit MotorTunePage(
         const char *motor_name,
-        Motor &motor,
+        M &motor,
         Motor::PwmSettings &pwm_settings,
         Motor::DriverSettings &driver_settings
     ) :
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <kf/UI.hpp>
+
+#include "zms/services/Odometry.hpp"
+#include "zms/ui/pages/MainPage.hpp"
+
+
+namespace zms {
+
+/// @brief Страница бортовой одометрии
+struct OdometryPage final : kf::UI::Page {
+
+private:
+    using CoordinateDisplay = kf::UI::Labeled<kf::UI::Display<kf::f32>>;
+
+    /// @brief Координата X (мм)
+    CoordinateDisplay x_display;
+
+    /// @brief Координата Y (мм)
+    CoordinateDisplay y_display;
+
+    /// @brief Курс (рад)
+    CoordinateDisplay heading_display;
+
+    /// @brief Сбросить позу в начало координат
+    kf::UI::Button reset;
+
+public:
+    explicit OdometryPage(Odometry &odometry) :
+        Page{"Odometry"},
+        x_display{
+            *this,
+            "X",
+            CoordinateDisplay::Impl{*this, odometry.pose().x}
+        },
+        y_display{
+            *this,
+            "Y",
+            CoordinateDisplay::Impl{*this, odometry.pose().y}
+        },
+        heading_display{
+            *this,
+            "Head",
+            CoordinateDisplay::Impl{*this, odometry.pose().heading}
+        },
+        reset{*this, "Reset", [&odometry]() { odometry.reset(); }} {
+        link(MainPage::instance());
+    }
+};
+
+}// namespace zms
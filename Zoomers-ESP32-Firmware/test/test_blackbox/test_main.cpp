@@ -0,0 +1,235 @@
+#include <unity.h>
+
+#include "zms/Periphery.hpp"
+#include "zms/hal/Hal.hpp"
+#include "zms/services/Blackbox.hpp"
+#include "zms/tools/BlackboxRing.hpp"
+
+/// Кольцевой буфер самописца: перезапись по кругу, окно до и после триггера, заморозка;
+/// выгрузка самописца на фейковой плате
+
+using Ring = zms::BlackboxRing<kf::u16, 8>;
+
+static Ring ring{};
+
+/// @brief Записать отсчёты first, first + 1, ... (count штук)
+static void pushRange(kf::u16 first, kf::u16 count) {
+    for (kf::u16 i = 0; i < count; i += 1) {
+        ring.push(static_cast<kf::u16>(first + i));
+    }
+}
+
+/// @brief Содержимое буфера - подряд идущие отсчёты начиная с first
+static void assertSequence(kf::u16 first, kf::u16 count) {
+    TEST_ASSERT_EQUAL_UINT16(count, ring.size());
+
+    for (kf::u16 i = 0; i < count; i += 1) {
+        TEST_ASSERT_EQUAL_UINT16(first + i, ring.at(i));
+    }
+}
+
+void setUp() { ring = {}; }
+
+void tearDown() {}
+
+void test_empty_ring() {
+    TEST_ASSERT_TRUE(ring.getState() == Ring::State::Recording);
+    TEST_ASSERT_EQUAL_UINT16(0, ring.size());
+}
+
+void test_partial_fill_keeps_order() {
+    pushRange(100, 5);
+
+    assertSequence(100, 5);
+}
+
+void test_wrap_keeps_newest_samples() {
+    // Три полных круга и ещё 3 отсчёта: в буфере последние 8, от старого к новому
+    pushRange(0, 3 * Ring::capacity + 3);
+
+    assertSequence(3 * Ring::capacity + 3 - Ring::capacity, Ring::capacity);
+}
+
+void test_trigger_freezes_window_around_event() {
+    pushRange(0, 20);
+
+    // Событие - отсчёт 19; после него ещё 3
+    TEST_ASSERT_TRUE(ring.trigger(3));
+    TEST_ASSERT_TRUE(ring.getState() == Ring::State::Triggered);
+
+    pushRange(20, 2);
+    TEST_ASSERT_TRUE(ring.getState() == Ring::State::Triggered);
+
+    pushRange(22, 1);
+    TEST_ASSERT_TRUE(ring.getState() == Ring::State::Frozen);
+
+    assertSequence(15, Ring::capacity);
+    TEST_ASSERT_EQUAL_UINT16(19, ring.at(ring.triggerIndex()));
+    TEST_ASSERT_EQUAL_UINT16(Ring::capacity - 1 - 3, ring.triggerIndex());
+}
+
+void test_frozen_ring_ignores_pushes() {
+    pushRange(0, 10);
+    TEST_ASSERT_TRUE(ring.trigger(0));
+    TEST_ASSERT_TRUE(ring.getState() == Ring::State::Frozen);
+
+    pushRange(500, 20);
+
+    assertSequence(2, Ring::capacity);
+    TEST_ASSERT_EQUAL_UINT16(9, ring.at(ring.triggerIndex()));
+}
+
+void test_second_trigger_rejected() {
+    pushRange(0, 4);
+
+    TEST_ASSERT_TRUE(ring.trigger(2));
+    TEST_ASSERT_FALSE(ring.trigger(1));
+
+    // Второй триггер не сдвигает окно
+    pushRange(4, 2);
+    TEST_ASSERT_TRUE(ring.getState() == Ring::State::Frozen);
+    TEST_ASSERT_EQUAL_UINT16(3, ring.at(ring.triggerIndex()));
+
+    TEST_ASSERT_FALSE(ring.trigger(0));
+}
+
+void test_post_samples_clamped_to_capacity() {
+    pushRange(0, 4);
+
+    // Окно после события не вытесняет сам отсчёт триггера
+    TEST_ASSERT_TRUE(ring.trigger(1000));
+    pushRange(4, Ring::capacity - 1);
+
+    TEST_ASSERT_TRUE(ring.getState() == Ring::State::Frozen);
+    TEST_ASSERT_EQUAL_UINT16(0, ring.triggerIndex());
+    TEST_ASSERT_EQUAL_UINT16(3, ring.at(0));
+    assertSequence(3, Ring::capacity);
+}
+
+void test_trigger_before_buffer_full() {
+    pushRange(0, 2);
+
+    TEST_ASSERT_TRUE(ring.trigger(3));
+    pushRange(2, 3);
+
+    TEST_ASSERT_TRUE(ring.getState() == Ring::State::Frozen);
+    assertSequence(0, 5);
+    TEST_ASSERT_EQUAL_UINT16(1, ring.triggerIndex());
+}
+
+void test_rearm_restarts_recording() {
+    pushRange(0, 12);
+    TEST_ASSERT_TRUE(ring.trigger(0));
+
+    ring.rearm();
+
+    TEST_ASSERT_TRUE(ring.getState() == Ring::State::Recording);
+    TEST_ASSERT_EQUAL_UINT16(0, ring.size());
+
+    pushRange(40, 3);
+    assertSequence(40, 3);
+
+    TEST_ASSERT_TRUE(ring.trigger(1));
+    pushRange(43, 1);
+    TEST_ASSERT_TRUE(ring.getState() == Ring::State::Frozen);
+    TEST_ASSERT_EQUAL_UINT16(42, ring.at(ring.triggerIndex()));
+}
+
+void test_freeze_cuts_post_window() {
+    pushRange(0, 20);
+    TEST_ASSERT_TRUE(ring.trigger(5));
+    pushRange(20, 2);
+
+    // Из 5 отсчётов после события записаны 2: окно обрезается по ним
+    ring.freeze();
+
+    TEST_ASSERT_TRUE(ring.getState() == Ring::State::Frozen);
+    TEST_ASSERT_EQUAL_UINT16(19, ring.at(ring.triggerIndex()));
+    TEST_ASSERT_EQUAL_UINT16(Ring::capacity - 1 - 2, ring.triggerIndex());
+
+    pushRange(22, 10);
+    assertSequence(14, Ring::capacity);
+}
+
+void test_freeze_while_recording() {
+    pushRange(0, 5);
+
+    ring.freeze();
+
+    TEST_ASSERT_TRUE(ring.getState() == Ring::State::Frozen);
+    TEST_ASSERT_EQUAL_UINT16(4, ring.at(ring.triggerIndex()));
+    TEST_ASSERT_FALSE(ring.trigger(1));
+}
+
+void test_freeze_keeps_frozen_window() {
+    pushRange(0, 10);
+    TEST_ASSERT_TRUE(ring.trigger(2));
+    pushRange(10, 2);
+
+    ring.freeze();
+
+    TEST_ASSERT_EQUAL_UINT16(9, ring.at(ring.triggerIndex()));
+    assertSequence(4, Ring::capacity);
+}
+
+void test_dump_while_post_window_records() {
+    auto &periphery = zms::Periphery::instance();
+    TEST_ASSERT_TRUE(periphery.init());
+
+    const auto &settings = periphery.storage.settings.blackbox;
+    const auto period_us = 1000000u / settings.sample_frequency_hz;
+
+    zms::ObstacleReflex reflex{};
+    zms::Blackbox blackbox{reflex};
+    TEST_ASSERT_TRUE(blackbox.init());
+
+    // Буфер заполнен, триггер, часть окна после события, и сразу выгрузка
+    zms::hal::native::advance(zms::Blackbox::capacity * period_us);
+    blackbox.trigger(zms::Blackbox::Reason::Command);
+    zms::hal::native::advance(10 * period_us);
+
+    const auto header = blackbox.beginDump();
+
+    TEST_ASSERT_EQUAL_UINT16(zms::Blackbox::capacity, header.count);
+    TEST_ASSERT_EQUAL_UINT16(zms::Blackbox::capacity - 1 - 10, header.trigger_index);
+    TEST_ASSERT_TRUE(header.reason == zms::Blackbox::Reason::Command);
+
+    // Запись идёт, пока основной цикл выгружает фрагменты: буфер не меняется
+    kf::u16 dumped = 0;
+    kf::u32 last_timestamp = 0;
+    zms::Blackbox::Chunk chunk{};
+
+    while (blackbox.nextChunk(chunk)) {
+        TEST_ASSERT_EQUAL_UINT16(dumped, chunk.offset);
+
+        for (kf::u8 i = 0; i < chunk.count; i += 1) {
+            if (dumped + i > 0) { TEST_ASSERT_EQUAL_UINT32(period_us, chunk.samples[i].timestamp_us - last_timestamp); }
+            last_timestamp = chunk.samples[i].timestamp_us;
+        }
+
+        dumped += chunk.count;
+        zms::hal::native::advance(period_us);
+    }
+
+    TEST_ASSERT_EQUAL_UINT16(header.count, dumped);
+}
+
+int main(int, char **) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_empty_ring);
+    RUN_TEST(test_partial_fill_keeps_order);
+    RUN_TEST(test_wrap_keeps_newest_samples);
+    RUN_TEST(test_trigger_freezes_window_around_event);
+    RUN_TEST(test_frozen_ring_ignores_pushes);
+    RUN_TEST(test_second_trigger_rejected);
+    RUN_TEST(test_post_samples_clamped_to_capacity);
+    RUN_TEST(test_trigger_before_buffer_full);
+    RUN_TEST(test_rearm_restarts_recording);
+    RUN_TEST(test_freeze_cuts_post_window);
+    RUN_TEST(test_freeze_while_recording);
+    RUN_TEST(test_freeze_keeps_frozen_window);
+    RUN_TEST(test_dump_while_post_window_records);
+
+    return UNITY_END();
+}
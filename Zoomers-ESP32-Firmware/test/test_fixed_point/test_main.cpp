@@ -0,0 +1,210 @@
+#include <unity.h>
+
+#include <cmath>
+
+#include "zms/bench/Reference.hpp"
+#include "zms/drivers/Encoder.hpp"
+#include "zms/drivers/Motor.hpp"
+#include "zms/drivers/PwmPositionServo.hpp"
+#include "zms/drivers/Sharp.hpp"
+#include "zms/hal/Hal.hpp"
+#include "zms/tools/FixedPoint.hpp"
+
+/// Точность преобразований на фиксированной точке относительно прежних реализаций (zms/bench/Reference.hpp).
+/// Допуски - те же, что указаны в Reference.hpp
+
+using zms::FixedMillimeters;
+using zms::Motor;
+using zms::NormalizedCommand;
+namespace reference = zms::bench::reference;
+
+/// @brief Диапазоны ШИМ мотора: разрядность и мёртвая зона
+struct PwmRange {
+    kf::u8 resolution_bits;
+    Motor::SignedPwm dead_zone;
+
+    [[nodiscard]] Motor::SignedPwm maxPwm() const { return static_cast<Motor::SignedPwm>((1 << resolution_bits) - 1); }
+
+    [[nodiscard]] Motor::SignedPwm span() const { return static_cast<Motor::SignedPwm>(maxPwm() - dead_zone); }
+};
+
+static constexpr PwmRange pwm_ranges[] = {
+    {8, 0},
+    {8, 100},
+    {10, 0},
+    {10, 580},
+    {10, 1000},
+    {12, 1500},
+    {14, 8000},
+};
+
+/// @brief Значение моста так, как его переводит set_motors
+static Motor::SignedPwm bridgePwm(kf::i16 value, const PwmRange &range) {
+    return Motor::pwmFromNormalized(NormalizedCommand::fromRatio(value, 1000), range.dead_zone, range.span());
+}
+
+void setUp() { zms::hal::native::board() = {}; }
+
+void tearDown() {}
+
+void test_from_ratio_rounds_to_nearest() {
+    // 10/1000 = 327.68 -> 328, симметрично относительно нуля
+    TEST_ASSERT_EQUAL_INT32(328, NormalizedCommand::fromRatio(10, 1000).raw);
+    TEST_ASSERT_EQUAL_INT32(-328, NormalizedCommand::fromRatio(-10, 1000).raw);
+    TEST_ASSERT_EQUAL_INT32(NormalizedCommand::one, NormalizedCommand::fromRatio(1000, 1000).raw);
+    TEST_ASSERT_EQUAL_INT32(0, NormalizedCommand::fromRatio(0, 1000).raw);
+}
+
+void test_bridge_motor_within_one_pwm_step() {
+    for (const auto &range: pwm_ranges) {
+        for (kf::i32 v = -1000; v <= 1000; v += 1) {
+            const auto value = static_cast<kf::i16>(v);
+            const auto expected = reference::motorPwmFromNormalized(reference::normalizedFromBridge(value), range.dead_zone, range.maxPwm());
+            const auto actual = bridgePwm(value, range);
+
+            TEST_ASSERT_INT_WITHIN(1, expected, actual);
+            // Граница мёртвой зоны и знак совпадают точно
+            TEST_ASSERT_EQUAL((expected > 0) - (expected < 0), (actual > 0) - (actual < 0));
+        }
+    }
+}
+
+void test_bridge_motor_saturates() {
+    const PwmRange range{10, 580};
+
+    TEST_ASSERT_EQUAL_INT16(range.maxPwm(), bridgePwm(1000, range));
+    TEST_ASSERT_EQUAL_INT16(range.maxPwm(), bridgePwm(5000, range));
+    TEST_ASSERT_EQUAL_INT16(-range.maxPwm(), bridgePwm(-5000, range));
+}
+
+void test_float_motor_within_one_pwm_step() {
+    // Полоса шириной в 1 шаг Q15 ниже 0.01: граница мёртвой зоны не представима в Q15 точно
+    constexpr auto edge_band = 1.0f / kf::f32(NormalizedCommand::one);
+
+    for (const auto &range: pwm_ranges) {
+        for (kf::i32 i = -110000; i <= 110000; i += 7) {
+            const auto value = kf::f32(i) / 100000.0f;
+            const auto expected = reference::motorPwmFromNormalized(value, range.dead_zone, range.maxPwm());
+            const auto actual = Motor::pwmFromFloat(value, range.dead_zone, range.span());
+
+            const auto magnitude = std::fabs(value);
+            if (magnitude < 0.01f and magnitude >= 0.01f - edge_band) { continue; }
+
+            TEST_ASSERT_INT_WITHIN(1, expected, actual);
+            TEST_ASSERT_EQUAL((expected > 0) - (expected < 0), (actual > 0) - (actual < 0));
+        }
+    }
+}
+
+void test_float_motor_nan_stops() {
+    TEST_ASSERT_EQUAL_INT16(0, Motor::pwmFromFloat(NAN, 580, 443));
+    TEST_ASSERT_EQUAL_INT16(0, reference::motorPwmFromNormalized(NAN, 580, 1023));
+}
+
+/// @brief Энкодер с заданным коэффициентом на фейковой плате
+struct EncoderFixture {
+    zms::Encoder::PinsSettings pins{.phase_a = 4, .phase_b = 5, .edge = zms::Encoder::PinsSettings::Edge::Rising};
+    zms::Encoder::ConversionSettings conversion{};
+    zms::Encoder encoder{pins, conversion};
+
+    explicit EncoderFixture(kf::f32 ticks_in_one_mm) {
+        conversion.ticks_in_one_mm = ticks_in_one_mm;
+        encoder.init();
+    }
+};
+
+static constexpr kf::f32 ticks_in_one_mm_values[] = {5000.0f / 2100.0f, 0.5f, 1.0f, 3.7f, 10.0f, 40.0f};
+
+void test_encoder_millimeters_within_tolerance() {
+    for (const auto k: ticks_in_one_mm_values) {
+        const EncoderFixture fixture{k};
+
+        for (zms::Encoder::Ticks ticks = -2000000; ticks <= 2000000; ticks += 1013) {
+            const auto expected = fixture.conversion.toMillimeters(ticks);
+            const auto actual = kf::f64(fixture.encoder.toFixedMillimeters(ticks).raw) / kf::f64(FixedMillimeters::one);
+
+            // Округление коэффициента Q24 (не больше 2^-25 мм на отсчёт), шаг FixedMillimeters и шаг float эталона
+            const auto magnitude = std::fabs(expected);
+            const auto tolerance =
+                std::fabs(kf::f64(ticks)) * std::ldexp(1.0, -25) +
+                1.0 / FixedMillimeters::one +
+                (std::nextafter(magnitude, INFINITY) - magnitude);
+            TEST_ASSERT_FLOAT_WITHIN(tolerance, expected, actual);
+        }
+    }
+}
+
+void test_encoder_ticks_within_one() {
+    for (const auto k: ticks_in_one_mm_values) {
+        const EncoderFixture fixture{k};
+
+        // До ±60 м: миллиметры FixedMillimeters представимы во float эталона точно
+        for (kf::i32 raw = -60000 * FixedMillimeters::one; raw <= 60000 * FixedMillimeters::one; raw += 4099) {
+            const auto mm = FixedMillimeters::fromRaw(raw);
+            const auto expected = fixture.conversion.toTicks(kf::Millimeters(mm.toFloat()));
+
+            TEST_ASSERT_INT_WITHIN(1, expected, fixture.encoder.toTicks(mm));
+        }
+    }
+}
+
+void test_encoder_ticks_truncate_toward_zero() {
+    const EncoderFixture fixture{1.0f};
+
+    TEST_ASSERT_EQUAL_INT32(2, fixture.encoder.toTicks(FixedMillimeters::fromRaw(2 * FixedMillimeters::one + 128)));
+    TEST_ASSERT_EQUAL_INT32(-2, fixture.encoder.toTicks(FixedMillimeters::fromRaw(-2 * FixedMillimeters::one - 128)));
+}
+
+void test_sharp_distance_is_reference_integer_part() {
+    for (kf::u32 sum = 1; sum <= 4 * 4095; sum += 1) {
+        const auto expected = static_cast<kf::u32>(reference::sharpDistance(sum, 4));
+        TEST_ASSERT_EQUAL_UINT32(expected, zms::Sharp::distanceFromSum(sum, 4));
+    }
+}
+
+void test_servo_duty_matches_reference() {
+    struct Case {
+        kf::u32 frequency_hz;
+        kf::u8 resolution_bits;
+        kf::Microseconds pulse_min, pulse_max;
+    };
+
+    const Case cases[] = {
+        {50, 10, 500, 2400},
+        {50, 16, 500, 2400},
+        {50, 12, 544, 2400},
+        {100, 14, 1000, 2000},
+        {333, 12, 500, 2500},
+    };
+
+    for (const auto &c: cases) {
+        const zms::PwmPositionServo::PwmSettings pwm{.ledc_frequency_hz = c.frequency_hz, .ledc_resolution_bits = c.resolution_bits};
+        const zms::PwmPositionServo::PulseSettings pulse{.min_position = {c.pulse_min, 0}, .max_position = {c.pulse_max, 180}};
+        const zms::PwmPositionServo::DriverSettings driver{.signal_pin = 14, .ledc_channel = 7, .min_angle = 0, .max_angle = 180};
+
+        zms::PwmPositionServo servo{pwm, driver, pulse};
+        TEST_ASSERT_TRUE(servo.init());
+
+        for (kf::Degrees angle = 0; angle <= 180; angle += 1) {
+            servo.set(angle);
+            TEST_ASSERT_EQUAL_UINT32(reference::servoDuty(pwm, pulse, angle), zms::hal::native::board().ledc[7].duty);
+        }
+    }
+}
+
+int main(int, char **) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_from_ratio_rounds_to_nearest);
+    RUN_TEST(test_bridge_motor_within_one_pwm_step);
+    RUN_TEST(test_bridge_motor_saturates);
+    RUN_TEST(test_float_motor_within_one_pwm_step);
+    RUN_TEST(test_float_motor_nan_stops);
+    RUN_TEST(test_encoder_millimeters_within_tolerance);
+    RUN_TEST(test_encoder_ticks_within_one);
+    RUN_TEST(test_encoder_ticks_truncate_toward_zero);
+    RUN_TEST(test_sharp_distance_is_reference_integer_part);
+    RUN_TEST(test_servo_duty_matches_reference);
+
+    return UNITY_END();
+}
@@ -0,0 +1,191 @@
+#include <unity.h>
+
+#include <cmath>
+
+#include "zms/tools/DifferentialOdometry.hpp"
+#include "zms/tools/FixedPoint.hpp"
+
+/// Одометрия дифференциального привода на синтетических приращениях колёс
+
+using zms::DifferentialOdometry;
+using zms::FixedMillimeters;
+
+static constexpr kf::f32 pi = static_cast<kf::f32>(M_PI);
+
+/// @brief Колея по умолчанию (Periphery::defaultSettings)
+static constexpr kf::f32 track_width_mm = 130.0f;
+
+static DifferentialOdometry odometry{};
+
+/// @brief Проехать steps шагов с постоянными приращениями колёс.
+/// Как в сервисе Odometry, приращение - разность квантованных положений: ошибка квантования не накапливается
+static void drive(kf::f32 left_mm, kf::f32 right_mm, int steps) {
+    auto last_left = FixedMillimeters::fromRaw(0);
+    auto last_right = FixedMillimeters::fromRaw(0);
+
+    for (int i = 1; i <= steps; i += 1) {
+        const auto left = FixedMillimeters::fromFloat(left_mm * kf::f32(i));
+        const auto right = FixedMillimeters::fromFloat(right_mm * kf::f32(i));
+
+        odometry.update(left - last_left, right - last_right);
+
+        last_left = left;
+        last_right = right;
+    }
+}
+
+void setUp() {
+    odometry = {};
+    odometry.setTrackWidth(track_width_mm);
+}
+
+void tearDown() {}
+
+void test_no_motion_keeps_pose() {
+    odometry.pose = {10.0f, -20.0f, 0.5f};
+
+    odometry.update(FixedMillimeters::fromRaw(0), FixedMillimeters::fromRaw(0));
+
+    TEST_ASSERT_EQUAL_FLOAT(10.0f, odometry.pose.x);
+    TEST_ASSERT_EQUAL_FLOAT(-20.0f, odometry.pose.y);
+    TEST_ASSERT_EQUAL_FLOAT(0.5f, odometry.pose.heading);
+}
+
+void test_straight_run() {
+    // 1 м шагами по 2 мм (500 Гц на 1 м/с)
+    drive(2.0f, 2.0f, 500);
+
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, 1000.0f, odometry.pose.x);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, 0.0f, odometry.pose.y);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.0f, odometry.pose.heading);
+}
+
+void test_straight_run_along_heading() {
+    odometry.pose.heading = pi / 2;
+
+    drive(-1.0f, -1.0f, 300);
+
+    TEST_ASSERT_FLOAT_WITHIN(1e-2f, 0.0f, odometry.pose.x);
+    TEST_ASSERT_FLOAT_WITHIN(1e-2f, -300.0f, odometry.pose.y);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, pi / 2, odometry.pose.heading);
+}
+
+void test_quarter_arc_left() {
+    // Четверть окружности радиуса 500 мм по центру оси против часовой стрелки
+    constexpr kf::f32 radius = 500.0f;
+    constexpr int steps = 1000;
+    constexpr kf::f32 step_angle = (pi / 2) / steps;
+
+    drive((radius - track_width_mm / 2) * step_angle, (radius + track_width_mm / 2) * step_angle, steps);
+
+    // Допуск: квантование положений колёс до 1/256 мм и интегрирование по средней точке дуги
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, radius, odometry.pose.x);
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, radius, odometry.pose.y);
+    TEST_ASSERT_FLOAT_WITHIN(2e-3f, pi / 2, odometry.pose.heading);
+}
+
+void test_quarter_arc_right_mirrors_left() {
+    constexpr kf::f32 radius = 300.0f;
+    constexpr int steps = 600;
+    constexpr kf::f32 step_angle = (pi / 2) / steps;
+
+    const auto outer = (radius + track_width_mm / 2) * step_angle;
+    const auto inner = (radius - track_width_mm / 2) * step_angle;
+
+    drive(inner, outer, steps);
+    const auto left_turn = odometry.pose;
+
+    setUp();
+    drive(outer, inner, steps);
+    const auto right_turn = odometry.pose;
+
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, left_turn.x, right_turn.x);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, -left_turn.y, right_turn.y);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, -left_turn.heading, right_turn.heading);
+}
+
+void test_spin_in_place() {
+    // Полный оборот на месте: каждое колесо проходит pi * колея
+    constexpr int steps = 720;
+    const auto wheel_step = pi * track_width_mm / steps;
+
+    drive(-wheel_step, wheel_step, steps / 4);
+
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 0.0f, odometry.pose.x);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 0.0f, odometry.pose.y);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, pi / 2, odometry.pose.heading);
+
+    drive(-wheel_step, wheel_step, steps * 3 / 4);
+
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 0.0f, odometry.pose.x);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 0.0f, odometry.pose.y);
+    TEST_ASSERT_FLOAT_WITHIN(4e-3f, 0.0f, odometry.pose.heading);
+}
+
+void test_heading_wraps_past_pi() {
+    // Разворот на месте чуть дальше pi против часовой: курс переходит в (-pi; 0)
+    odometry.pose.heading = pi - 0.05f;
+
+    const auto wheel_step = 0.01f * track_width_mm / 2;
+    drive(-wheel_step, wheel_step, 10);
+
+    TEST_ASSERT_TRUE(odometry.pose.heading < 0.0f);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, -pi + 0.05f, odometry.pose.heading);
+}
+
+void test_heading_wraps_past_minus_pi() {
+    odometry.pose.heading = -pi + 0.05f;
+
+    const auto wheel_step = 0.01f * track_width_mm / 2;
+    drive(wheel_step, -wheel_step, 10);
+
+    TEST_ASSERT_TRUE(odometry.pose.heading > 0.0f);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, pi - 0.05f, odometry.pose.heading);
+}
+
+void test_heading_stays_normalized_over_many_turns() {
+    const auto wheel_step = 0.37f * track_width_mm / 2;
+
+    for (int i = 0; i < 200; i += 1) {
+        drive(-wheel_step, wheel_step, 1);
+
+        TEST_ASSERT_TRUE(odometry.pose.heading <= pi);
+        TEST_ASSERT_TRUE(odometry.pose.heading > -pi);
+    }
+}
+
+void test_normalize_angle() {
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.0f, DifferentialOdometry::normalizeAngle(0.0f));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, pi, DifferentialOdometry::normalizeAngle(pi));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, pi, DifferentialOdometry::normalizeAngle(-pi));
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, pi / 2, DifferentialOdometry::normalizeAngle(pi / 2 + 4 * pi));
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, -pi / 2, DifferentialOdometry::normalizeAngle(3 * pi / 2));
+}
+
+void test_track_width_scales_turn_rate() {
+    odometry.setTrackWidth(2 * track_width_mm);
+
+    const auto wheel_step = 0.01f * track_width_mm / 2;
+    drive(-wheel_step, wheel_step, 10);
+
+    // Вдвое шире колея - вдвое меньше угол при тех же приращениях
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, 0.05f, odometry.pose.heading);
+}
+
+int main(int, char **) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_no_motion_keeps_pose);
+    RUN_TEST(test_straight_run);
+    RUN_TEST(test_straight_run_along_heading);
+    RUN_TEST(test_quarter_arc_left);
+    RUN_TEST(test_quarter_arc_right_mirrors_left);
+    RUN_TEST(test_spin_in_place);
+    RUN_TEST(test_heading_wraps_past_pi);
+    RUN_TEST(test_heading_wraps_past_minus_pi);
+    RUN_TEST(test_heading_stays_normalized_over_many_turns);
+    RUN_TEST(test_normalize_angle);
+    RUN_TEST(test_track_width_scales_turn_rate);
+
+    return UNITY_END();
+}
@@ -0,0 +1,226 @@
+#include <unity.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include "sim/DriveModel.hpp"
+#include "zms/tools/PurePursuit.hpp"
+
+/// Pure Pursuit в замкнутом контуре с моделью шасси симулятора (sim/DriveModel.hpp)
+
+using zms::PurePursuit;
+
+static constexpr kf::f32 track_width_mm = 130.0f;
+
+/// @brief Период следования (сервис PathFollower - 100 Гц)
+static constexpr kf::f32 dt_s = 0.01f;
+
+/// @brief Настройки по умолчанию (Periphery::defaultSettings)
+static constexpr PurePursuit::Settings settings{
+    .lookahead_mm = 150.0f,
+    .cruise_speed_mm_s = 300.0f,
+    .deceleration_mm_s2 = 400.0f,
+    .goal_tolerance_mm = 10.0f,
+};
+
+/// @brief Итог прогона
+struct Run {
+    /// @brief Путь пройден
+    bool finished;
+
+    /// @brief Время прогона (с)
+    kf::f32 time_s;
+
+    /// @brief Наибольшая поперечная ошибка после схождения (мм)
+    kf::f32 max_cross_track_mm;
+
+    /// @brief Наибольшая скорость колеса на выходе (мм/с)
+    kf::f32 max_wheel_speed_mm_s;
+};
+
+static PurePursuit pursuit{};
+
+static zms::sim::DriveModel plant{};
+
+/// @brief Шасси: скорость без нагрузки 600 мм/с, разгон 50 мс
+static void resetPlant(kf::f32 x, kf::f32 y, kf::f32 heading, kf::f32 stiction_duty = 0.0f) {
+    const zms::sim::WheelModel::Parameters wheel{600.0f, 0.05f, stiction_duty};
+
+    plant = {track_width_mm, {wheel}, {wheel}};
+    plant.x = x;
+    plant.y = y;
+    plant.heading = heading;
+}
+
+/// @brief Следовать до конца пути или тайм-аута; скорости колёс переводятся в скважность по скорости без нагрузки
+/// @param settle_s Время схождения, после которого учитывается поперечная ошибка
+static Run follow(kf::f32 timeout_s, kf::f32 settle_s = 0.0f) {
+    Run run{false, 0, 0, 0};
+
+    const auto &wheel = plant.left.parameters;
+
+    for (kf::f32 t = 0; t < timeout_s; t += dt_s) {
+        const zms::DifferentialOdometry::Pose pose{
+            static_cast<kf::f32>(plant.x),
+            static_cast<kf::f32>(plant.y),
+            zms::DifferentialOdometry::normalizeAngle(static_cast<kf::f32>(plant.heading)),
+        };
+
+        const auto output = pursuit.update(settings, pose, track_width_mm);
+
+        if (pursuit.finished()) {
+            run.finished = true;
+            run.time_s = t;
+            return run;
+        }
+
+        if (t >= settle_s) { run.max_cross_track_mm = std::max(run.max_cross_track_mm, std::fabs(pursuit.crossTrackError())); }
+        run.max_wheel_speed_mm_s = std::max({run.max_wheel_speed_mm_s, std::fabs(output.left), std::fabs(output.right)});
+
+        // Прямая связь по скорости с учётом порога трогания (как velocity_feedforward + мёртвая зона ШИМ)
+        const auto duty = [&wheel](kf::f32 speed) {
+            if (speed == 0) { return 0.0f; }
+            const auto d = wheel.stiction_duty + (1.0f - wheel.stiction_duty) * std::fabs(speed) / wheel.no_load_speed_mm_s;
+            return std::copysign(std::min(d, 1.0f), speed);
+        };
+
+        plant.step(duty(output.left), duty(output.right), dt_s);
+    }
+
+    run.time_s = timeout_s;
+    return run;
+}
+
+static void appendAll(std::initializer_list<PurePursuit::Point> points) {
+    for (const auto &p: points) { TEST_ASSERT_TRUE(pursuit.append(p)); }
+}
+
+static kf::f32 distanceTo(kf::f32 x, kf::f32 y) {
+    return static_cast<kf::f32>(std::hypot(plant.x - x, plant.y - y));
+}
+
+void setUp() {
+    pursuit.clear();
+    resetPlant(0, 0, 0);
+}
+
+void tearDown() {}
+
+void test_empty_path_outputs_zero() {
+    const auto output = pursuit.update(settings, {0, 0, 0}, track_width_mm);
+
+    TEST_ASSERT_TRUE(pursuit.finished());
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, output.left);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, output.right);
+}
+
+void test_straight_line_reaches_goal() {
+    appendAll({{0, 0}, {1000, 0}});
+
+    const auto run = follow(10.0f);
+
+    TEST_ASSERT_TRUE(run.finished);
+    TEST_ASSERT_FLOAT_WITHIN(settings.goal_tolerance_mm, 0.0f, distanceTo(1000, 0));
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, 0.0f, run.max_cross_track_mm);
+    TEST_ASSERT_TRUE(run.max_wheel_speed_mm_s <= settings.cruise_speed_mm_s + 1e-3f);
+
+    // 1 м на 300 мм/с плюс торможение 400 мм/с^2
+    TEST_ASSERT_TRUE(run.time_s > 1000.0f / settings.cruise_speed_mm_s);
+    TEST_ASSERT_TRUE(run.time_s < 5.0f);
+}
+
+void test_converges_from_lateral_offset() {
+    appendAll({{0, 0}, {1500, 0}});
+    resetPlant(0, 100, 0);
+
+    // Через 2 с (около 600 мм) робот на линии
+    const auto run = follow(15.0f, 2.0f);
+
+    TEST_ASSERT_TRUE(run.finished);
+    TEST_ASSERT_FLOAT_WITHIN(5.0f, 0.0f, run.max_cross_track_mm);
+    TEST_ASSERT_FLOAT_WITHIN(settings.goal_tolerance_mm, 0.0f, distanceTo(1500, 0));
+}
+
+void test_converges_from_heading_error() {
+    appendAll({{0, 0}, {1500, 0}});
+    resetPlant(0, 0, 0.6f);
+
+    const auto run = follow(15.0f, 2.5f);
+
+    TEST_ASSERT_TRUE(run.finished);
+    TEST_ASSERT_FLOAT_WITHIN(5.0f, 0.0f, run.max_cross_track_mm);
+}
+
+void test_square_with_motor_stiction() {
+    // Квадрат 600 мм с возвратом в начало: конечная точка совпадает с начальной,
+    // торможение - по оставшейся длине пути, а не по прямой до цели
+    appendAll({{0, 0}, {600, 0}, {600, 600}, {0, 600}, {0, 0}});
+    resetPlant(0, 0, 0, 0.3f);
+
+    const auto run = follow(30.0f);
+
+    TEST_ASSERT_TRUE(run.finished);
+    TEST_ASSERT_EQUAL_UINT16(4, pursuit.passedSegments());
+    TEST_ASSERT_FLOAT_WITHIN(settings.goal_tolerance_mm, 0.0f, distanceTo(0, 0));
+
+    // Углы срезаются на величину порядка упреждения
+    TEST_ASSERT_TRUE(run.max_cross_track_mm < settings.lookahead_mm);
+
+    // Без срезания углов 2.4 м на крейсерской скорости - 8 с; остановка у начальной точки закончила бы прогон сразу
+    TEST_ASSERT_TRUE(run.time_s > 0.75f * 2400.0f / settings.cruise_speed_mm_s);
+}
+
+void test_points_appended_while_driving() {
+    appendAll({{0, 0}, {300, 0}});
+
+    // Путь дописывается, пока робот на первом сегменте
+    for (int i = 0; i < 30; i += 1) {
+        (void) follow(dt_s);
+    }
+
+    TEST_ASSERT_FALSE(pursuit.finished());
+    appendAll({{600, 0}, {600, 300}});
+    TEST_ASSERT_EQUAL_UINT8(PurePursuit::capacity - pursuit.remainingSegments() - 1, pursuit.freeSpace());
+
+    const auto run = follow(20.0f);
+
+    TEST_ASSERT_TRUE(run.finished);
+    TEST_ASSERT_FLOAT_WITHIN(settings.goal_tolerance_mm, 0.0f, distanceTo(600, 300));
+}
+
+void test_append_rejects_when_full() {
+    for (kf::u8 i = 0; i < PurePursuit::capacity; i += 1) {
+        TEST_ASSERT_TRUE(pursuit.append({kf::f32(i) * 10.0f, 0}));
+    }
+
+    TEST_ASSERT_EQUAL_UINT8(0, pursuit.freeSpace());
+    TEST_ASSERT_FALSE(pursuit.append({1000, 0}));
+}
+
+void test_cross_track_sign() {
+    appendAll({{0, 0}, {1000, 0}});
+
+    // Путь справа от робота (робот выше линии): ошибка отрицательная, поворот вправо
+    auto output = pursuit.update(settings, {100, 50, 0}, track_width_mm);
+    TEST_ASSERT_TRUE(pursuit.crossTrackError() < 0);
+    TEST_ASSERT_TRUE(output.left > output.right);
+
+    output = pursuit.update(settings, {100, -50, 0}, track_width_mm);
+    TEST_ASSERT_TRUE(pursuit.crossTrackError() > 0);
+    TEST_ASSERT_TRUE(output.right > output.left);
+}
+
+int main(int, char **) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_empty_path_outputs_zero);
+    RUN_TEST(test_straight_line_reaches_goal);
+    RUN_TEST(test_converges_from_lateral_offset);
+    RUN_TEST(test_converges_from_heading_error);
+    RUN_TEST(test_square_with_motor_stiction);
+    RUN_TEST(test_points_appended_while_driving);
+    RUN_TEST(test_append_rejects_when_full);
+    RUN_TEST(test_cross_track_sign);
+
+    return UNITY_END();
+}
@@ -0,0 +1,181 @@
+#include <unity.h>
+
+#include "zms/drivers/PwmPositionServo.hpp"
+#include "zms/drivers/RmtServoPair.hpp"
+#include "zms/drivers/ServoPulseCoefficients.hpp"
+#include "zms/hal/Hal.hpp"
+
+/// Перевод угла в импульс (ServoPulseCoefficients) и пара сервоприводов на RMT (фейковая плата)
+
+using zms::PwmPositionServo;
+using zms::RmtServoPair;
+using zms::ServoPulseCoefficients;
+
+/// @brief Эталон: прежний перевод через map() (PulseSettings::pulseWidthFromAngle)
+static kf::i32 referencePulse(kf::i32 p_min, kf::i32 a_min, kf::i32 p_max, kf::i32 a_max, kf::i32 angle) {
+    const PwmPositionServo::PulseSettings pulse{
+        .min_position = {static_cast<kf::Microseconds>(p_min), static_cast<kf::Degrees>(a_min)},
+        .max_position = {static_cast<kf::Microseconds>(p_max), static_cast<kf::Degrees>(a_max)},
+    };
+    return static_cast<kf::i32>(pulse.pulseWidthFromAngle(static_cast<kf::Degrees>(angle)));
+}
+
+static PwmPositionServo::PwmSettings pwm_settings{};
+static PwmPositionServo::PulseSettings pulse_settings{};
+static PwmPositionServo::DriverSettings arm_settings{};
+static PwmPositionServo::DriverSettings claw_settings{};
+static RmtServoPair::Settings rmt_settings{};
+
+void setUp() {
+    zms::hal::native::board() = {};
+
+    pwm_settings = {.ledc_frequency_hz = 50, .ledc_resolution_bits = 10};
+    pulse_settings = {.min_position = {500, 0}, .max_position = {2400, 180}};
+    arm_settings = {.signal_pin = 14, .ledc_channel = 14, .min_angle = 90, .max_angle = 180};
+    claw_settings = {.signal_pin = 15, .ledc_channel = 15, .min_angle = 0, .max_angle = 180};
+    rmt_settings = {.arm_channel = 0, .claw_channel = 1};
+}
+
+void tearDown() {}
+
+void test_pulse_matches_map_over_calibrations() {
+    struct Calibration {
+        kf::i32 p_min, a_min, p_max, a_max;
+    };
+
+    const Calibration calibrations[] = {
+        {500, 0, 2400, 180},
+        {544, 0, 2400, 180},
+        {1000, 0, 2000, 180},
+        {600, 10, 2300, 170},
+        {500, 0, 2500, 270},
+        {900, 45, 2100, 135},
+    };
+
+    for (const auto &c: calibrations) {
+        const auto coefficients = ServoPulseCoefficients::calculate(c.p_min, c.a_min, c.p_max, c.a_max, c.a_min, c.a_max);
+
+        for (kf::i32 angle = c.a_min; angle <= c.a_max; angle += 1) {
+            TEST_ASSERT_EQUAL_INT32(referencePulse(c.p_min, c.a_min, c.p_max, c.a_max, angle), coefficients.pulseWidth(angle));
+        }
+    }
+}
+
+void test_pulse_endpoints() {
+    const auto coefficients = ServoPulseCoefficients::calculate(500, 0, 2400, 180, 0, 180);
+
+    TEST_ASSERT_EQUAL_UINT16(500, coefficients.pulseWidth(0));
+    TEST_ASSERT_EQUAL_UINT16(1450, coefficients.pulseWidth(90));
+    TEST_ASSERT_EQUAL_UINT16(2400, coefficients.pulseWidth(180));
+}
+
+void test_pulse_clamped_to_axis_limits() {
+    // Ось звена: 90 .. 180 внутри калибровки 0 .. 180
+    const auto coefficients = ServoPulseCoefficients::calculate(500, 0, 2400, 180, 90, 180);
+
+    TEST_ASSERT_EQUAL_UINT16(coefficients.pulseWidth(90), coefficients.pulseWidth(0));
+    TEST_ASSERT_EQUAL_UINT16(coefficients.pulseWidth(90), coefficients.pulseWidth(-30));
+    TEST_ASSERT_EQUAL_UINT16(coefficients.pulseWidth(180), coefficients.pulseWidth(255));
+}
+
+void test_axis_limits_constrained_to_calibration() {
+    // Пределы оси шире калибровки: импульс не выходит за калибровочные точки
+    const auto coefficients = ServoPulseCoefficients::calculate(600, 10, 2300, 170, 0, 180);
+
+    TEST_ASSERT_EQUAL_INT32(10, coefficients.min_angle);
+    TEST_ASSERT_EQUAL_INT32(170, coefficients.max_angle);
+    TEST_ASSERT_EQUAL_UINT16(600, coefficients.pulseWidth(0));
+    TEST_ASSERT_EQUAL_UINT16(2300, coefficients.pulseWidth(180));
+}
+
+void test_degenerate_calibration_holds_origin() {
+    const auto coefficients = ServoPulseCoefficients::calculate(1500, 90, 1500, 90, 0, 180);
+
+    TEST_ASSERT_EQUAL_INT32(0, coefficients.slope_q16);
+    TEST_ASSERT_EQUAL_UINT16(1500, coefficients.pulseWidth(90));
+}
+
+void test_rmt_pair_writes_both_axes() {
+    RmtServoPair pair{rmt_settings, pwm_settings, pulse_settings, arm_settings, claw_settings};
+    TEST_ASSERT_TRUE(pair.init());
+
+    const auto &board = zms::hal::native::board();
+    TEST_ASSERT_EQUAL_UINT8(14, board.rmt[0].pin);
+    TEST_ASSERT_EQUAL_UINT8(15, board.rmt[1].pin);
+    TEST_ASSERT_FALSE(board.rmt[0].running);
+    TEST_ASSERT_FALSE(board.rmt[1].running);
+
+    pair.set(135, 45);
+
+    const auto arm_pulse = referencePulse(500, 0, 2400, 180, 135);
+    const auto claw_pulse = referencePulse(500, 0, 2400, 180, 45);
+
+    TEST_ASSERT_TRUE(board.rmt[0].running);
+    TEST_ASSERT_TRUE(board.rmt[1].running);
+    TEST_ASSERT_EQUAL_UINT16(arm_pulse, board.rmt[0].high_ticks);
+    TEST_ASSERT_EQUAL_UINT16(20000 - arm_pulse, board.rmt[0].low_ticks);
+    TEST_ASSERT_EQUAL_UINT16(claw_pulse, board.rmt[1].high_ticks);
+    TEST_ASSERT_EQUAL_UINT16(20000 - claw_pulse, board.rmt[1].low_ticks);
+}
+
+void test_rmt_pair_clamps_arm_axis() {
+    RmtServoPair pair{rmt_settings, pwm_settings, pulse_settings, arm_settings, claw_settings};
+    TEST_ASSERT_TRUE(pair.init());
+
+    pair.setArm(0);
+
+    TEST_ASSERT_EQUAL_UINT16(referencePulse(500, 0, 2400, 180, 90), zms::hal::native::board().rmt[0].high_ticks);
+}
+
+void test_rmt_pair_disable_single_axis() {
+    RmtServoPair pair{rmt_settings, pwm_settings, pulse_settings, arm_settings, claw_settings};
+    TEST_ASSERT_TRUE(pair.init());
+
+    pair.set(120, 60);
+    pair.disableClaw();
+
+    const auto &board = zms::hal::native::board();
+    TEST_ASSERT_TRUE(board.rmt[0].running);
+    TEST_ASSERT_FALSE(board.rmt[1].running);
+
+    // Запись в выключенную ось снова запускает канал
+    pair.setClaw(90);
+    TEST_ASSERT_TRUE(board.rmt[1].running);
+    TEST_ASSERT_EQUAL_UINT16(referencePulse(500, 0, 2400, 180, 90), board.rmt[1].high_ticks);
+}
+
+void test_rmt_pair_period_follows_frequency() {
+    pwm_settings.ledc_frequency_hz = 100;
+
+    RmtServoPair pair{rmt_settings, pwm_settings, pulse_settings, arm_settings, claw_settings};
+    TEST_ASSERT_TRUE(pair.init());
+
+    pair.setClaw(180);
+
+    const auto &channel = zms::hal::native::board().rmt[1];
+    TEST_ASSERT_EQUAL_UINT32(10000, channel.high_ticks + channel.low_ticks);
+}
+
+void test_rmt_pair_rejects_shared_channel() {
+    rmt_settings.claw_channel = rmt_settings.arm_channel;
+
+    RmtServoPair pair{rmt_settings, pwm_settings, pulse_settings, arm_settings, claw_settings};
+    TEST_ASSERT_FALSE(pair.init());
+}
+
+int main(int, char **) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_pulse_matches_map_over_calibrations);
+    RUN_TEST(test_pulse_endpoints);
+    RUN_TEST(test_pulse_clamped_to_axis_limits);
+    RUN_TEST(test_axis_limits_constrained_to_calibration);
+    RUN_TEST(test_degenerate_calibration_holds_origin);
+    RUN_TEST(test_rmt_pair_writes_both_axes);
+    RUN_TEST(test_rmt_pair_clamps_arm_axis);
+    RUN_TEST(test_rmt_pair_disable_single_axis);
+    RUN_TEST(test_rmt_pair_period_follows_frequency);
+    RUN_TEST(test_rmt_pair_rejects_shared_channel);
+
+    return UNITY_END();
+}